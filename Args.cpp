@@ -143,6 +143,13 @@ Args::collectCommandLineValues(const boost::program_options::variables_map& varM
         ok = false;
     }
 
+  if (varMap.count("tlbways"))
+    {
+      auto numStr = varMap["tlbways"].as<std::string>();
+      if (not parseCmdLineNumber("tlbways", numStr, this->tlbWays))
+        ok = false;
+    }
+
   if (varMap.count("nmivec"))
     {
       auto numStr = varMap["nmivec"].as<std::string>();
@@ -320,6 +327,17 @@ Args::collectCommandLineValues(const boost::program_options::variables_map& varM
 	}
     }
 
+  if (varMap.count("quantum"))
+    {
+      auto numStr = varMap["quantum"].as<std::string>();
+      ok = parseCmdLineNumber("quantum", numStr, this->quantum) and ok;
+      if (this->quantum and not this->deterministic.empty())
+        {
+          std::cerr << "Error: Options --quantum and --deterministic are mutually exclusive.\n";
+          ok = false;
+        }
+    }
+
   if (varMap.count("seed"))
     {
       auto numStr = varMap["seed"].as<std::string>();
@@ -437,6 +455,8 @@ Args::parseCmdLineArgs(std::span<char*> argv)
 	 "Memory size (must be a multiple of 4096).")
 	("tlbsize", po::value<std::string>(),
 	 "TLB size (must be a power of 2).")
+	("tlbways", po::value<std::string>(),
+	 "TLB associativity: entries per set (must be a power of 2, default 1).")
 	("nmivec", po::value<std::string>(),
 	 "PC value after a non-maskable interrupt.")
 	("nmevec", po::value<std::string>(),
@@ -504,10 +524,19 @@ Args::parseCmdLineArgs(std::span<char*> argv)
         ("loadfromtrace", po::bool_switch(&this->loadFromTrace),
          "If true, also restore data-lines/instr-lines/branch-trace from a snapshot "
          "directory. This needs to be used in conjunction with --loadfrom.")
+        ("snapincremental", po::bool_switch(&this->incrementalSnap),
+         "Save each snapshot after the first one of a run as incremental: it holds only "
+         "the memory pages written since the previous snapshot and names that snapshot "
+         "in its parent file. Loading such a snapshot restores memory from the whole chain.")
+        ("snaplazy", po::bool_switch(&this->lazySnapLoad),
+         "When loading a snapshot saved with the chunked compression type, restore each "
+         "memory page on its first access instead of restoring all memory up front.")
         ("snapcompressiontype", po::value(&this->compressionType),
-         "Compression type for snapshots. Supported types are: lz4, gzip [default].")
+         "Compression type for snapshots. Supported types are: lz4, gzip [default], "
+         "chunked (independently compressed chunks processed in parallel).")
         ("snapdecompressiontype", po::value(&this->decompressionType),
-         "Decompression type for snapshots. Supported types are: lz4, gzip [default].")
+         "Decompression type for snapshots. Supported types are: lz4, gzip [default], "
+         "chunked (independently compressed chunks processed in parallel).")
 	("stdout", po::value(&this->stdoutFile),
 	 "Redirect standard output of newlib/Linux target program to this.")
 	("stderr", po::value(&this->stderrFile),
@@ -596,6 +625,15 @@ Args::parseCmdLineArgs(std::span<char*> argv)
          "Used for deterministic multi-hart runs. Define a window range [x:y] for the amount of instructions "
          "a hart will execute before switching to the next hart. A range of 0:0 turns this off. The "
          "actual amount of instructions is determined by corresponding seed value.")
+        ("quantum", po::value<std::string>(),
+         "Used for deterministic multi-hart runs. Run each hart in its own thread for the "
+         "given number of instructions then synchronize all harts. Within a quantum, the "
+         "stores of a hart are visible to that hart only. At the synchronization point, "
+         "the stores of each hart are written to memory, then the atomic instructions and "
+         "store-to-load fences at which harts stopped are executed, then the ACLINT/IMSIC "
+         "writes of a hart targeting other harts are applied, in hart index order at each "
+         "step. Accesses to IO devices are not buffered and are only reproducible if no "
+         "two harts access them in the same quantum.")
         ("seed", po::value<std::string>(),
          "Corresponding seed for deterministic runs. If this is not specified, but 'deterministic' is, whisper will "
          "generate a seed value based on current time.")
@@ -125,6 +125,7 @@ namespace WdRiscv
     std::optional<uint64_t> maxRetInst;  // Retired instruction limit
     std::optional<uint64_t> memorySize;
     std::optional<uint64_t> tlbSize;
+    std::optional<uint64_t> tlbWays;
     std::optional<uint64_t> nmiVec;
     std::optional<uint64_t> nmeVec;
     std::optional<uint64_t> alarmInterval;
@@ -140,6 +141,7 @@ namespace WdRiscv
     std::optional<unsigned> seed;
 
     Uint64Vec deterministic;
+    std::optional<uint64_t> quantum;
     Uint64Vec snapshotPeriods;
     Uint64Vec steesr;
 
@@ -182,6 +184,8 @@ namespace WdRiscv
     bool logPerHart = false;    // Enable separate log files for each hart.
     bool loadFromTrace = false; // Enable loading trace information from snapshot.
     bool aperiodicSnp = false;  // Enable to do aperiodic snapshots.
+    bool incrementalSnap = false;  // Save incremental (dirty page) snapshots.
+    bool lazySnapLoad = false;     // Restore snapshot memory on first access.
     bool roi = false;           // Enable ROI tracing with NOP HINTs.
     bool hintOps = false;       // Enable HINT ops.
     bool logLabel = false;
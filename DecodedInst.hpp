@@ -147,6 +147,19 @@ namespace WdRiscv
       return mode;
     }
 
+    /// Type of the function executing a decoded instruction in a hart
+    /// (threaded dispatch). The first argument is the executing hart.
+    using ExecHandler = void (*)(void*, const DecodedInst*);
+
+    /// Return the execution handler resolved at decode time or nullptr
+    /// if none was resolved (see Hart::decode).
+    ExecHandler execHandler() const
+    { return handler_; }
+
+    /// Set the execution handler.
+    void setExecHandler(ExecHandler handler)
+    { handler_ = handler; }
+
     /// Return true if this object is valid.
     bool isValid() const
     { return valid_; }
@@ -549,6 +562,7 @@ namespace WdRiscv
       inst_ = inst;
       size_ = instructionSize(inst);
       entry_ = entry;
+      handler_ = nullptr;
       op0_ = op0; op1_ = op1; op2_ = op2; op3_ = op3;
       valid_ = entry != nullptr;
       masked_ = false;
@@ -623,7 +637,7 @@ namespace WdRiscv
     { inst_ = inst; size_ = instructionSize(inst); }
 
     void setEntry(const InstEntry* e)
-    { entry_ = e; if (not e) valid_ = false; }
+    { entry_ = e; handler_ = nullptr; if (not e) valid_ = false; }
 
     void setOp0(uint32_t op0)
     { op0_ = op0; }
@@ -644,6 +658,7 @@ namespace WdRiscv
     uint32_t inst_;
     uint32_t size_;
     const InstEntry* entry_;
+    ExecHandler handler_ = nullptr;  // Threaded-dispatch handler (see Hart::execute).
     uint32_t op0_;    // 1st operand (typically a register number)
     uint32_t op1_;    // 2nd operand (register number or immediate value)
     uint32_t op2_;    // 3rd operand (register number or immediate value)
@@ -114,6 +114,10 @@ Hart<URV>::Hart(unsigned hartIx, URV hartId, unsigned numHarts, Memory& memory,
     enableExtension(ext, true);
 
   decodeCache_.resize(decodeCacheSize_);
+  decodePageGen_.resize(decodeCacheSize_);
+
+  blockCache_.resize(4*1024);
+  blockCacheMask_ = blockCache_.size() - 1;
 
   interruptStat_.resize(size_t(InterruptCause::MAX_CAUSE) + 1);
   exceptionStat_.resize(size_t(ExceptionCause::MAX_CAUSE) + 1);
@@ -467,18 +471,11 @@ Hart<URV>::setupVirtMemCallbacks()
     return ok;
   });
 
-  // Keep the page-walk PTE cache coherent: any committed RAM write invalidates a
-  // cached copy of that location (so a write to a page-table entry is observed).
-  memory_.setWriteObserver(
-    [](void* ctx, uint64_t addr, unsigned size) {
-      static_cast<VirtMem*>(ctx)->invalidatePteCache(addr, size);
-    },
-    &virtMem_);
-
-  // Enable the PTE cache where it can stay coherent (single hart); see
-  // updatePteCacheActive. Both store-commit paths (Memory::write and Memory::poke)
-  // fire the invalidation observer, so MCM/perfApi no longer need to disable it.
-  updatePteCacheActive();
+  // Keep the page-walk PTE cache coherent: a cached PTE is valid while the write
+  // generation of its page is unchanged. Generations are shared by all harts and
+  // advanced by both store-commit paths (Memory::write and Memory::poke), so the
+  // cache stays on for multi-hart and MCM/perfApi runs.
+  virtMem_.setPageGenerations(memory_.pageGenerations(), memory_.pageShift());
 }
 
 
@@ -559,6 +556,8 @@ Hart<URV>::processExtensions(bool verbose)
   bool flag = value & (URV(1) << ('s' - 'a'));  // Supervisor-mode option.
   flag = flag and isa_.isEnabled(RvExtension::S);
   enableSupervisorMode(flag);
+  flushFetchTlb();  // Translation depends on S.
+  flushDataTlb();
 
   flag = value & (URV(1) << ('u' - 'a'));  // User-mode option.
   flag = flag and isa_.isEnabled(RvExtension::U);
@@ -843,6 +842,9 @@ Hart<URV>::updateMemoryProtection()
 {
   pmpMgr_.reset();
   virtMem_.flushPteCache();  // PMP regions changed -> cached PTE access results stale.
+  invalidateBlockCache();    // Blocks were built under the old PMP permissions.
+  flushFetchTlb();
+  flushDataTlb();
 
   const unsigned count = 64;
   unsigned impCount = 0;  // Count of implemented PMP registers
@@ -903,6 +905,9 @@ template <typename URV>
 void
 Hart<URV>::updateAddressTranslation()
 {
+  flushFetchTlb();
+  flushDataTlb();
+
   URV value = 0;
   if (peekCsr(CsrNumber::SATP, value))
     {
@@ -1149,6 +1154,8 @@ namespace WdRiscv
     csrVal = peekCsr(CsrNumber::MSTATUSH);
     mstatus_.value_.high_ = csrVal;
 
+    if (virtMem_.getSum() != mstatus_.bits_.SUM or virtMem_.execReadable() != mstatus_.bits_.MXR)
+      flushDataTlb();  // Load/store permissions changed.
     virtMem_.setExecReadable(mstatus_.bits_.MXR);
     virtMem_.setStage1ExecReadable(mstatus_.bits_.MXR);
     virtMem_.setSum(mstatus_.bits_.SUM);
@@ -1169,6 +1176,8 @@ namespace WdRiscv
     uint64_t csrVal = csRegs_.peekMstatus();
     mstatus_.value_ = csrVal;
 
+    if (virtMem_.getSum() != mstatus_.bits_.SUM or virtMem_.execReadable() != mstatus_.bits_.MXR)
+      flushDataTlb();  // Load/store permissions changed.
     virtMem_.setExecReadable(mstatus_.bits_.MXR);
     virtMem_.setStage1ExecReadable(mstatus_.bits_.MXR);
     virtMem_.setSum(mstatus_.bits_.SUM);
@@ -1210,6 +1219,9 @@ Hart<URV>::updateCachedVsstatus()
 {
   vsstatus_.value_ = peekCsr(CsrNumber::VSSTATUS);
 
+  if (virtMem_.vsSum() != vsstatus_.bits_.SUM or
+      virtMem_.stage1ExecReadable() != vsstatus_.bits_.MXR)
+    flushDataTlb();  // Load/store permissions changed.
   virtMem_.setStage1ExecReadable(vsstatus_.bits_.MXR);
   virtMem_.setVsSum(vsstatus_.bits_.SUM);
 
@@ -1561,6 +1573,99 @@ Hart<URV>::pokeMemory(uint64_t addr, uint64_t val, bool usePma, bool skipFetch,
 }
 
 
+template <typename URV>
+uint8_t*
+Hart<URV>::bulkHostAddress(uint64_t pa, uint64_t size, bool write, bool usePma)
+{
+  if (mcm_ and (dataCache_ or fetchCache_))
+    return nullptr;
+
+  uint64_t last = pa + size - 1;
+  if (size == 0 or last < pa or not pmaMgr_.isUniformRange(pa, last) or
+      memory_.hasIoInRange(pa, last) or hasDeviceInRange(pa, last))
+    return nullptr;
+
+  auto pma = pmaMgr_.getPma(pa);
+  if (pma.hasMemMappedReg())
+    return nullptr;
+
+  if (usePma)
+    {
+      if (write and not pma.isWrite())
+        return nullptr;
+      if (not write and not pma.isRead() and not pma.isExec())
+        return nullptr;
+    }
+
+  if (last >= memory_.size())
+    return nullptr;
+  return memory_.hostAddress(pa);
+}
+
+
+template <typename URV>
+uint64_t
+Hart<URV>::copyToGuest(uint64_t addr, std::span<const uint8_t> data, bool usePma)
+{
+  uint64_t pageSize = memory_.pageSize();
+  uint64_t done = 0;
+
+  while (done < data.size())
+    {
+      uint64_t pa = addr + done;
+      uint64_t size = std::min(data.size() - done, pageSize - (pa & (pageSize - 1)));
+
+      uint8_t* host = bulkHostAddress(pa, size, true, usePma);
+      if (not host)
+        {
+          // Irregular page: fall back to byte pokes.
+          for (uint64_t end = done + size; done < end; ++done)
+            if (not pokeMemory(addr + done, data[done], usePma))
+              return done;
+          continue;
+        }
+
+      std::unique_lock lock(memory_.amoMutex_);
+      memory_.invalidateAllHartsLr(pa, size);
+      invalidateDecodeCache(pa, size);
+      memcpy(host, &data[done], size);
+      memory_.notifyWrite(pa, size);
+      done += size;
+    }
+
+  return done;
+}
+
+
+template <typename URV>
+uint64_t
+Hart<URV>::copyFromGuest(uint64_t addr, std::span<uint8_t> data, bool usePma)
+{
+  uint64_t pageSize = memory_.pageSize();
+  uint64_t done = 0;
+
+  while (done < data.size())
+    {
+      uint64_t pa = addr + done;
+      uint64_t size = std::min(data.size() - done, pageSize - (pa & (pageSize - 1)));
+
+      const uint8_t* host = bulkHostAddress(pa, size, false, usePma);
+      if (not host)
+        {
+          for (uint64_t end = done + size; done < end; ++done)
+            if (not peekMemory(addr + done, data[done], usePma))
+              return done;
+          continue;
+        }
+
+      memcpy(&data[done], host, size);
+      done += size;
+    }
+
+  return done;
+}
+
+
 template <typename URV>
 void
 Hart<URV>::setPendingNmi(URV cause)
@@ -2319,6 +2424,33 @@ Hart<URV>::load(const DecodedInst* di, uint64_t virtAddr, uint64_t& data)
         return false;
     }
 
+  // Data micro-TLB hit: the page was checked and holds ordinary memory.
+  // Reproduce the side effects of determineLoadException/readForLoad.
+  uint64_t va = URV(ldStFaultAddr_);
+  bool useTlb = dataTlbUsable(di, va, ldStSize_);
+  if (useTlb)
+    if (const auto* entry = dataTlbLookup(va); entry and entry->read_ and
+        not (entry->special_ and isSpecialAddr(entry->ppa_ | (va & dataTlbPageMask_))) and
+        touchMainTlb(*entry))
+      {
+        uint64_t offset = va & dataTlbPageMask_;
+        uint64_t pa = entry->ppa_ | offset;
+        ldStFaultAddr_ = va;
+        misalignedLdSt_ = false;
+        setMemProtAccIsFetch(false);
+        ldStPma1_ = entry->pma_;
+        ldStPma2_ = Pma{};
+        ldStPhysAddr1_ = ldStPhysAddr2_ = pa;
+
+        using ULT = std::make_unsigned_t<LOAD_TYPE>;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        ULT uval = std::atomic_ref<ULT>(*reinterpret_cast<ULT*>(entry->host_ + offset)).load(std::memory_order_relaxed);
+        data = uval;
+        if (not std::is_same<ULT, LOAD_TYPE>::value)
+          data = int64_t(LOAD_TYPE(uval)); // Loading signed: Sign extend.
+        return true;
+      }
+
   uint64_t addr1 = virtAddr;
   uint64_t addr2 = addr1;
   uint64_t gaddr1 = virtAddr;
@@ -2333,6 +2465,9 @@ Hart<URV>::load(const DecodedInst* di, uint64_t virtAddr, uint64_t& data)
   ldStPhysAddr1_ = addr1;
   ldStPhysAddr2_ = addr2;
 
+  if (useTlb)
+    fillDataTlb(va, gaddr1, addr1, ldStPma1_, false /*write*/);
+
   return readForLoad<LOAD_TYPE>(di, virtAddr, addr1, addr2, data);
 #endif
 }
@@ -2439,6 +2574,16 @@ Hart<URV>::deviceWrite(uint64_t pa, STORE_TYPE storeVal)
 
   if (isImsicAddr(pa))
     {
+      if (deferCrossHart_ and not imsic_->coversAddress(pa))
+        {
+          // A write to the IMSIC of another hart is a message to that hart:
+          // deliver it at the next quantum barrier.
+          uint64_t val = storeVal;
+          crossHartEffects_.push_back([this, pa, val]() {
+            imsicWrite_(pa, sizeof(STORE_TYPE), val);
+          });
+          return;
+        }
       imsicWrite_(pa, sizeof(storeVal), storeVal);
       return;
     }
@@ -2684,9 +2829,9 @@ Hart<URV>::store(const DecodedInst* di, URV virtAddr, STORE_TYPE storeVal,
   return fastStore(di, virtAddr, storeVal);
 #else
 
-  // With a single hart there is no other accessor, so the amoMutex_ is pure overhead.
-  auto lock = (amoLock and numHarts_ > 1)? std::unique_lock(memory_.amoMutex_) :
-                         std::unique_lock<std::shared_mutex>();
+  // No lock: aligned stores are single host atomics and page-crossing
+  // ones lock their lines (see memWrite). Atomic instructions commit
+  // with a compare-exchange when harts run concurrently.
 
   // ld/st-address or instruction-address triggers have priority over
   // ld/st access or misaligned exceptions.
@@ -2701,6 +2846,34 @@ Hart<URV>::store(const DecodedInst* di, URV virtAddr, STORE_TYPE storeVal,
         return false;
     }
 
+  // Data micro-TLB hit: the page was checked and holds ordinary memory.
+  // Reproduce the side effects of determineStoreException/writeForStore.
+  uint64_t va = URV(ldStFaultAddr_);
+  bool useTlb = dataTlbUsable(di, va, ldStSize_);
+  if (useTlb)
+    if (const auto* entry = dataTlbLookup(va); entry and entry->write_ and
+        not (entry->special_ and isSpecialAddr(entry->ppa_ | (va & dataTlbPageMask_))) and
+        touchMainTlb(*entry))
+      {
+        uint64_t offset = va & dataTlbPageMask_;
+        uint64_t pa = entry->ppa_ | offset;
+        ldStFaultAddr_ = va;
+        misalignedLdSt_ = false;
+        setMemProtAccIsFetch(false);
+        ldStPma1_ = entry->pma_;
+        ldStPma2_ = Pma{};
+        ldStPhysAddr1_ = ldStPhysAddr2_ = pa;
+        ldStWrite_ = true;
+        ldStData_ = storeVal;
+
+        invalidateDecodeCache(pa, ldStSize_);
+        memory_.invalidateOtherHartLr(hartIx_, pa, ldStSize_);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        std::atomic_ref<STORE_TYPE>(*reinterpret_cast<STORE_TYPE*>(entry->host_ + offset)).store(storeVal, std::memory_order_relaxed);
+        memory_.notifyWrite(pa, ldStSize_);
+        return true;
+      }
+
   // Determine if a store exception is possible. Determine sore exception will do address
   // translation and change pa1/pa2 to physical addresses. Ga1/ga2 are the guest addresses
   // for 2-stage address translation.
@@ -2716,6 +2889,9 @@ Hart<URV>::store(const DecodedInst* di, URV virtAddr, STORE_TYPE storeVal,
       return false;
     }
 
+  if (useTlb)
+    fillDataTlb(va, ga1, pa1, ldStPma1_, true /*write*/);
+
   return writeForStore<STORE_TYPE>(virtAddr, pa1, pa2, storeVal);
 #endif
 }
@@ -2779,6 +2955,7 @@ Hart<URV>::writeForStore(uint64_t virtAddr, uint64_t pa1, uint64_t pa2, STORE_TY
   if (isDeviceAddr(pa1))
     {
       assert(pa1 == pa2);
+      auto ioLock = lockIoForWrite(pa1, pa2, sizeof(storeVal), true);
       deviceWrite(pa1, storeVal);
       return true;
     }
@@ -2858,6 +3035,30 @@ void
 Hart<URV>::processClintWrite(uint64_t addr, unsigned stSize, URV& storeVal)
 {
   // We assume that the CLINT device is little endian.
+
+  if (deferCrossHart_)
+    {
+      // A write to the msip/mtimecmp of another hart is applied by that hart at the
+      // next quantum barrier.
+      Hart<URV>* target = nullptr;
+      bool msip = addr >= aclintSwStart_ and addr < aclintSwEnd_;
+      if (msip)
+        target = indexToHart_((addr - aclintSwStart_) / 4);
+      else if (addr >= aclintMtimeCmpStart_ and addr < aclintMtimeCmpEnd_)
+        target = indexToHart_((addr - aclintMtimeCmpStart_) / 8);
+      if (target and target != this)
+        {
+          if (msip and stSize == 4 and (addr & 3) == 0)
+            storeVal = storeVal & 1;
+          URV val = storeVal;
+          crossHartEffects_.push_back([target, addr, stSize, val]() {
+            URV v = val;
+            target->processClintWrite(addr, stSize, v);
+          });
+          return;
+        }
+    }
+
   if (addr >= aclintSwStart_ and addr < aclintSwEnd_)
     {
       unsigned hartIx = (addr - aclintSwStart_) / 4;
@@ -3062,6 +3263,25 @@ Hart<URV>::fetchInstNoTrap(uint64_t& va, uint64_t& pa, [[maybe_unused]] uint64_t
 
 #else
 
+  // Fast path: fetch from a page recorded in the fetch micro-TLB. A
+  // fetch with side effects or one that may cross a page takes the
+  // regular path.
+  uint64_t offset = va & fetchTlbPageMask_;
+  bool sideEffects = (mcm_ and fetchCache_) or initStateFile_ or traceCacheOn_;
+  if (not sideEffects and (va & 1) == 0 and offset <= fetchTlbPageMask_ - 3 and fetchTlbUsable())
+    if (const auto* entry = fetchTlbLookup(va); entry and touchMainTlb(*entry))
+      {
+        pa = entry->ppa_ | offset;
+        pa2 = va;
+        gpa = entry->translated_ ? (entry->gpa_ | offset) : 0;
+        memcpy(&inst, entry->host_ + offset, sizeof(inst));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (isCompressedInst(inst))
+          inst = (inst << 16) >> 16;
+        else if (pa & 3)
+          gpa = pa2 = pa + 2;  // Same as misaligned path below.
+        return ExceptionCause::NONE;
+      }
+
   uint64_t steePhysAddr = 0;
   pa = pa2 = steePhysAddr = va;
   gpa = 0;
@@ -3071,6 +3291,7 @@ Hart<URV>::fetchInstNoTrap(uint64_t& va, uint64_t& pa, [[maybe_unused]] uint64_t
       auto cause = virtMem_.translateForFetch(va, privMode_, virtMode_, gpa, pa);
       if (cause != ExceptionCause::NONE)
 	return cause;
+      steePhysAddr = pa;
     }
 
   if (va & 1)
@@ -3100,6 +3321,9 @@ Hart<URV>::fetchInstNoTrap(uint64_t& va, uint64_t& pa, [[maybe_unused]] uint64_t
   if (not pmaMgr_.accessPma(pa).isExec())
     return ExceptionCause::INST_ACC_FAULT;
 
+  if (not sideEffects and fetchTlbUsable())
+    fillFetchTlb(va, pa, gpa);
+
   bool wordAligned = (pa & 3) == 0;
   bool umfc = mcm_ and fetchCache_;   // Use MCM fetch cache.
 
@@ -3226,6 +3450,336 @@ Hart<URV>::fetchInst(URV virtAddr, uint64_t& physAddr, uint32_t& inst)
 }
 
 
+template <typename URV>
+inline
+ExceptionCause
+Hart<URV>::translateInstAddr(uint64_t va, uint64_t& pa, uint64_t& gpa)
+{
+#if FAST_SLOPPY
+
+  gpa = pa = va;
+  return ExceptionCause::NONE;
+
+#else
+
+  bool usable = fetchTlbUsable();
+  if (usable and (va & 1) == 0)
+    if (const auto* entry = fetchTlbLookup(va); entry and touchMainTlb(*entry))
+      {
+        uint64_t offset = va & fetchTlbPageMask_;
+        pa = entry->ppa_ | offset;
+        gpa = entry->translated_ ? (entry->gpa_ | offset) : 0;
+        return ExceptionCause::NONE;
+      }
+
+  pa = va;
+  gpa = 0;
+  if (isRvs() and privMode_ != PrivilegeMode::Machine)
+    {
+      gpa = va;
+      auto cause = virtMem_.translateForFetch(va, privMode_, virtMode_, gpa, pa);
+      if (cause != ExceptionCause::NONE)
+	return cause;
+    }
+
+  if (va & 1)
+    return ExceptionCause::INST_ADDR_MISAL;
+
+  if (pmpEnabled_ and not pmpMgr_.accessPmp(privMode_, pa).isExec())
+    return ExceptionCause::INST_ACC_FAULT;
+
+  if (not pmaMgr_.accessPma(pa).isExec())
+    return ExceptionCause::INST_ACC_FAULT;
+
+  if (usable)
+    fillFetchTlb(va, pa, gpa);
+  return ExceptionCause::NONE;
+
+#endif
+}
+
+
+template <typename URV>
+ExceptionCause
+Hart<URV>::readTranslatedInst(uint64_t& va, uint64_t pa, uint64_t& gpa, uint32_t& inst)
+{
+  if ((pa & 3) == 0)
+    {
+      if (not memory_.readInst(pa, inst))
+        return ExceptionCause::INST_ACC_FAULT;
+      if (isCompressedInst(inst))
+        inst = (inst << 16) >> 16;
+      return ExceptionCause::NONE;
+    }
+
+  uint16_t half = 0;
+  if (not memory_.readInst(pa, half))
+    return ExceptionCause::INST_ACC_FAULT;
+  inst = half;
+  if (isCompressedInst(inst))
+    return ExceptionCause::NONE;
+
+  // Same page as lower half: no translation needed.
+  uint64_t pa2 = pa + 2;
+  if ((pmpEnabled_ and not pmpMgr_.accessPmp(privMode_, pa2).isExec()) or
+      not pmaMgr_.accessPma(pa2).isExec() or not memory_.readInst(pa2, half))
+    {
+      va += 2;  // To report faulting portion of fetch.
+      gpa = pa2;
+      return ExceptionCause::INST_ACC_FAULT;
+    }
+
+  inst = inst | (uint32_t(half) << 16);
+  return ExceptionCause::NONE;
+}
+
+
+template <typename URV>
+void
+Hart<URV>::fillFetchTlb(uint64_t va, uint64_t pa, uint64_t gpa)
+{
+  uint64_t vpn = va >> fetchTlbPageShift_;
+  uint64_t ppa = pa & ~fetchTlbPageMask_;
+  auto& entry = fetchTlb_[vpn & (fetchTlbSize_ - 1)];
+
+  // A hit stands for a hit in the TLB entries of the translation.
+  TlbEntry* te1 = nullptr;
+  TlbEntry* te2 = nullptr;
+  bool inTlb = findMainTlbEntries(va, gpa, privMode_, virtMode_, te1, te2);
+
+  if (entry.vpn_ == vpn and entry.priv_ == privMode_ and entry.virt_ == virtMode_)
+    {
+      if (inTlb and entry.ppa_ == ppa)
+        {
+          entry.tlb1_ = te1;
+          entry.tlb2_ = te2;
+        }
+      else
+        entry.vpn_ = ~uint64_t(0);
+      return;
+    }
+
+  if (not inTlb)
+    return;
+
+  // A hit skips the PMP/PMA checks: they must yield the same result
+  // everywhere in the page.
+  uint64_t last = ppa + fetchTlbPageMask_;
+  if (pmpEnabled_ and not pmpMgr_.isUniform(ppa, last))
+    return;
+  if (not pmaMgr_.isUniform(ppa, last))
+    return;
+
+  const uint8_t* host = memory_.hostAddress(ppa);
+  if (not host)
+    return;
+
+  entry.vpn_ = vpn;
+  entry.ppa_ = ppa;
+  entry.gpa_ = gpa & ~fetchTlbPageMask_;
+  entry.host_ = host;
+  entry.tlb1_ = te1;
+  entry.tlb2_ = te2;
+  entry.priv_ = privMode_;
+  entry.virt_ = virtMode_;
+  entry.translated_ = isRvs() and privMode_ != PrivilegeMode::Machine;
+}
+
+
+template <typename URV>
+bool
+Hart<URV>::findMainTlbEntries(uint64_t va, uint64_t gpa, PrivilegeMode pm, bool virt,
+                              TlbEntry*& te1, TlbEntry*& te2)
+{
+  te1 = te2 = nullptr;
+  if (not isRvs() or pm == PrivilegeMode::Machine)
+    return true;
+
+  using Mode = VirtMem::Mode;
+  auto& vm = virtMem_;
+  uint64_t vpn = va >> vm.pageBits_;
+
+  if (not virt)
+    {
+      if (vm.mode_ == Mode::Bare)
+        return true;
+      te1 = vm.tlb_.findEntry(vpn, vm.asid_, vm.wid_);
+      return te1 != nullptr;
+    }
+
+  if (vm.vsMode_ != Mode::Bare)
+    {
+      te1 = vm.vsTlb_.findEntry(vpn, vm.vsAsid_, vm.vmid_, vm.wid_);
+      if (not te1)
+        return false;
+    }
+  if (vm.stage2Mode_ != Mode::Bare)
+    {
+      te2 = vm.stage2Tlb_.findEntry(gpa >> vm.pageBits_, vm.vsAsid_, vm.vmid_, vm.wid_);
+      if (not te2)
+        return false;
+    }
+  return true;
+}
+
+
+template <typename URV>
+void
+Hart<URV>::fillDataTlb(uint64_t va, uint64_t gpa, uint64_t pa, const Pma& pma, bool write)
+{
+  auto [pm, virt] = effLdStMode();
+  uint64_t vpn = va >> dataTlbPageShift_;
+  uint64_t ppa = pa & ~dataTlbPageMask_;
+  auto& entry = dataTlb_[vpn & (dataTlbSize_ - 1)];
+
+  // A hit stands for a hit in the TLB entries of the translation.
+  TlbEntry* te1 = nullptr;
+  TlbEntry* te2 = nullptr;
+  bool inTlb = findMainTlbEntries(va, gpa, pm, virt, te1, te2);
+
+  if (entry.vpn_ == vpn and entry.ppa_ == ppa and entry.priv_ == pm and entry.virt_ == virt)
+    {
+      if (not inTlb)
+        {
+          entry.vpn_ = ~uint64_t(0);
+          return;
+        }
+      // Same page: record that the other kind of access passed the checks.
+      entry.tlb1_ = te1;
+      entry.tlb2_ = te2;
+      if (write)
+        entry.write_ = true;
+      else
+        entry.read_ = true;
+      return;
+    }
+
+  if (not inTlb)
+    return;
+
+  if (not pma.isIdempotent() or pma.isIo() or pma.hasMemMappedReg())
+    return;
+
+  // A hit skips the PMP/PMA/device checks: they must yield the same
+  // result everywhere in the page.
+  uint64_t last = ppa + dataTlbPageMask_;
+  if (pmpEnabled_ and not pmpMgr_.isUniform(ppa, last))
+    return;
+  if (not pmaMgr_.isUniform(ppa, last))
+    return;
+  if (last >= memory_.size() or hasDeviceInRange(ppa, last) or memory_.hasIoInRange(ppa, last))
+    return;
+
+  uint8_t* host = memory_.hostAddress(ppa);
+  if (not host)
+    return;
+
+  entry.vpn_ = vpn;
+  entry.ppa_ = ppa;
+  entry.gpa_ = gpa & ~dataTlbPageMask_;
+  entry.host_ = host;
+  entry.tlb1_ = te1;
+  entry.tlb2_ = te2;
+  entry.pma_ = pma;
+  entry.priv_ = pm;
+  entry.virt_ = virt;
+  entry.read_ = not write;
+  entry.write_ = write;
+  entry.special_ = ((conIoValid_ and (conIo_ & ~dataTlbPageMask_) == ppa) or
+                    (toHostValid_ and toHost_ + 4 >= ppa and toHost_ <= last));
+}
+
+
+template <typename URV>
+bool
+Hart<URV>::hasDeviceInRange(uint64_t addr0, uint64_t addr1) const
+{
+  if (hasAclint() and aclintBase_ <= addr1 and addr0 < aclintBase_ + aclintSize_)
+    return true;
+  if (imsic_ and ((imsicMbase_ <= addr1 and addr0 < imsicMend_) or
+                  (imsicSbase_ <= addr1 and addr0 < imsicSend_)))
+    return true;
+
+  if (pci_ and pci_->overlaps_range(addr0, addr1))
+    return true;
+  if (aplic_ and aplic_->overlapsRange(addr0, addr1))
+    return true;
+  return iommu_ and iommu_->overlapsRange(addr0, addr1);
+}
+
+
+template <typename URV>
+inline
+bool
+Hart<URV>::fetchDecodedInst(URV virtAddr, uint64_t& physAddr, DecodedInst*& di)
+{
+  bool lookup = decodeCacheUsesGen();
+
+  uint64_t gen = 0;
+  uint64_t gpa = 0;
+  if (lookup)
+    {
+      auto cause = translateInstAddr(virtAddr, physAddr, gpa);
+      if (cause != ExceptionCause::NONE)
+        {
+          if (not breakpOrEnterDebugTripped())
+            initiateException(cause, virtAddr, virtAddr, gpa);
+          return false;
+        }
+
+      // Hit if the page holding the instruction was not written since the
+      // entry was decoded. Page-crossing instructions are never valid by
+      // generation. The upper half of a misaligned 32-bit instruction is in
+      // the same page but may be in a different PMP/PMA region.
+      uint32_t ix = (physAddr >> 1) & decodeCacheMask_;
+      di = &decodeCache_[ix];
+      gen = memory_.pageGeneration(physAddr);
+      if (di->isValid() and di->physAddress() == physAddr and decodePageGen_[ix] == gen)
+        {
+          if (di->instSize() == 2 or (physAddr & 3) == 0)
+            return true;
+          uint64_t pa2 = physAddr + 2;
+          if ((not pmpEnabled_ or pmpMgr_.accessPmp(privMode_, pa2).isExec()) and
+              pmaMgr_.accessPma(pa2).isExec())
+            return true;
+        }
+    }
+
+  // Miss: fetch the instruction word and decode unless it matches the
+  // entry. An already translated address is not translated again: the
+  // TLB must see one access per fetch.
+  uint32_t inst = 0;
+  uint64_t boundary = std::min(memory_.pageSize(), uint64_t(4096));
+  if (lookup and ((physAddr + 2) & (boundary - 1)) != 0)
+    {
+      uint64_t va = virtAddr;
+      auto cause = readTranslatedInst(va, physAddr, gpa, inst);
+      if (cause != ExceptionCause::NONE)
+        {
+          if (not breakpOrEnterDebugTripped())
+            initiateException(cause, virtAddr, va, gpa);
+          return false;
+        }
+    }
+  else if (not fetchInst(virtAddr, physAddr, inst))
+    return false;
+
+  uint32_t ix = (physAddr >> 1) & decodeCacheMask_;
+  di = &decodeCache_[ix];
+  if (not di->isValid() or di->physAddress() != physAddr or di->inst() != inst)
+    decode(virtAddr, physAddr, inst, *di);
+
+  // Record the generation read before the fetch. An entry that cannot be
+  // validated by generation gets a stale one and is re-checked against
+  // the instruction word on every use.
+  bool crosser = di->instSize() == 4 and ((physAddr + 2) & (boundary - 1)) == 0;
+  if (not lookup or crosser)
+    gen = memory_.pageGeneration(physAddr) - 1;
+  decodePageGen_[ix] = gen;
+  return true;
+}
+
+
 template <typename URV>
 bool
 Hart<URV>::fetchInstPostTrigger(URV virtAddr, uint64_t& physAddr,
@@ -4738,6 +5292,8 @@ Hart<URV>::postCsrUpdate(CsrNumber csr, URV val, URV lastVal)
   else if (csr == CN::MENVCFG or csr == CN::SENVCFG or csr == CN::HENVCFG or
            csr == CN::MENVCFGH or csr == CN::HENVCFGH)
     {
+      flushFetchTlb();
+      flushDataTlb();
       updateTranslationPbmt();
       updateTranslationAdu();
       updateTranslationPmm();
@@ -4758,6 +5314,9 @@ Hart<URV>::postCsrUpdate(CsrNumber csr, URV val, URV lastVal)
       pmpMgr_.setMmLockdown(msf.bits_.MML);
       pmpMgr_.setMmWhitelist(msf.bits_.MMWP);
       pmpMgr_.setRuleLockBypass(msf.bits_.RLB);
+      flushFetchTlb();  // PMP permissions depend on MML/MMWP.
+      flushDataTlb();
+      invalidateBlockCache();
     }
 
   if (csr == CN::STIMECMP)
@@ -5940,7 +6499,8 @@ private:
 template <typename URV>
 inline
 bool
-Hart<URV>::fetchInstWithTrigger(URV addr, uint64_t& physAddr, uint32_t& inst, FILE* file)
+Hart<URV>::fetchInstWithTrigger(URV addr, uint64_t& physAddr, uint32_t& inst,
+                                DecodedInst*& di, FILE* file)
 {
   // Process pre-execute address trigger.
   bool hasTrig = hasActiveInstTrigger();
@@ -5959,7 +6519,9 @@ Hart<URV>::fetchInstWithTrigger(URV addr, uint64_t& physAddr, uint32_t& inst, FI
   setMemProtAccIsFetch(true);
 
   // Fetch instruction.
-  bool fetch = fetchInst(addr, physAddr, inst);
+  bool fetch = fetchDecodedInst(addr, physAddr, di);
+  if (fetch)
+    inst = di->inst();
   if (not fetch or
       (injectException_ != ExceptionCause::NONE and not injectExceptionIsLd_))
     {
@@ -5998,29 +6560,93 @@ Hart<URV>::fetchInstWithTrigger(URV addr, uint64_t& physAddr, uint32_t& inst, FI
 }
 
 
+//NOLINTNEXTLINE(bugprone-reserved-identifier, cppcoreguidelines-avoid-non-const-global-variables)
+extern void (*__tracerExtension)(void*);
+
+
+template <typename URV>
+unsigned
+Hart<URV>::activeInstrumentation(FILE* traceFile) const
+{
+  unsigned mask = 0;
+  if (sdtrigOn_)                       mask |= IfTrigger;
+  if (enableGdb_)                      mask |= IfGdb;
+  if (preInst_)                        mask |= IfPreInst;
+  if (bbFile_)                         mask |= IfBasicBlock;
+  if (instrLineTrace_)                 mask |= IfLineTrace;
+  if (initStateFile_)                  mask |= IfInitState;
+  if (hasRoiTraceEnabled())            mask |= IfRoi;
+  if (instFreq_ or enableCounters_)    mask |= IfStats;
+  if (branchBuffer_.max_size() and not branchTraceFile_.empty())
+    mask |= IfBranchTrace;
+  if (traceFile or __tracerExtension)  mask |= IfTraceFile;
+  return mask;
+}
+
+
 template <typename URV>
 bool
 Hart<URV>::untilAddress(uint64_t address, FILE* traceFile)
 {
   traceFileActive_ = (traceFile != nullptr);  // gates the per-instruction trace reset
 
+  // Pick the loop specialized for the active instrumentation. Pick again
+  // if a feature is toggled while running.
+  while (true)
+    {
+      instrumChanged_ = false;
+      bool reselect = false, ok = true;
+
+      unsigned active = activeInstrumentation(traceFile);
+      if (active == 0)
+        ok = untilAddressLoop<0>(address, traceFile, reselect);
+      else if (active == IfTrigger)
+        ok = untilAddressLoop<IfTrigger>(address, traceFile, reselect);
+      else
+        ok = untilAddressLoop<IfAll>(address, traceFile, reselect);
+
+      if (not reselect)
+        return ok;
+    }
+}
+
+
+template <typename URV>
+template <unsigned FEATURES>
+bool
+Hart<URV>::untilAddressLoop(uint64_t address, FILE* traceFile, bool& reselect)
+{
+  constexpr bool trigOn   = FEATURES & IfTrigger;
+  constexpr bool gdbOn    = FEATURES & IfGdb;
+  constexpr bool preOn    = FEATURES & IfPreInst;
+  constexpr bool bbOn     = FEATURES & IfBasicBlock;
+  constexpr bool lineOn   = FEATURES & IfLineTrace;
+  constexpr bool initOn   = FEATURES & IfInitState;
+  constexpr bool roiOn    = FEATURES & IfRoi;
+  constexpr bool statsOn  = FEATURES & IfStats;
+  constexpr bool branchOn = FEATURES & IfBranchTrace;
+  constexpr bool logOn    = FEATURES & IfTraceFile;
+
+  // Inactive features must not be passed in. A full-featured loop is fine for anything.
+  assert((activeInstrumentation(traceFile) & ~FEATURES) == 0);
+
   std::string instStr;
   instStr.reserve(128);
 
   const uint64_t instLim = instCountLim_;
   const uint64_t retInstLim = retCountLim_;
 
-  bool statsEnabled = instFreq_ or enableCounters_;
-  bool roiActive = hasRoiTraceEnabled();
-  bool traceBranchOn = branchBuffer_.max_size() and not branchTraceFile_.empty();
+  bool statsEnabled = statsOn and (instFreq_ or enableCounters_);
+  bool roiActive = roiOn and hasRoiTraceEnabled();
+  bool traceBranchOn = branchOn and branchBuffer_.max_size() and not branchTraceFile_.empty();
 
   // Check for gdb break every 1000000 instructions.
   unsigned gdbCount = 0, gdbLimit = 1000000;
 
-  if (enableGdb_)
+  if (gdbOn and enableGdb_)
     handleExceptionForGdb(*this, gdbInputFd_);
 
-  uint64_t& effectiveInstCounter = hasRoiTraceEnabled()? traceCount_ : execCount_;
+  uint64_t& effectiveInstCounter = roiActive? traceCount_ : execCount_;
 
   while (pc_ != address and effectiveInstCounter < instLim and
            retireCount_ < retInstLim)
@@ -6028,10 +6654,17 @@ Hart<URV>::untilAddress(uint64_t address, FILE* traceFile)
       if (userStop)
         break;
 
+      if constexpr (FEATURES != IfAll)
+        if (instrumChanged_)
+          {
+            reselect = true;
+            return true;
+          }
+
       resetExecInfo(); clearTraceData();
 
       bool traceWasOn = traceOn_;
-      if (enableGdb_ and ++gdbCount >= gdbLimit)
+      if (gdbOn and enableGdb_ and ++gdbCount >= gdbLimit)
         {
           gdbCount = 0;
           if (hasPendingInput(gdbInputFd_))
@@ -6041,7 +6674,7 @@ Hart<URV>::untilAddress(uint64_t address, FILE* traceFile)
             }
         }
 
-      if (preInst_)
+      if (preOn and preInst_)
         {
           bool halt = false, reset = false;
           while (true)
@@ -6062,7 +6695,7 @@ Hart<URV>::untilAddress(uint64_t address, FILE* traceFile)
           // We want amo instructions to print in the same order as executed.
 	  // This avoid interleaving of amo execution and tracing.
 	  static std::mutex execMutex;
-	  auto lock = (ownTrace_ or !traceFile)? std::unique_lock<std::mutex>() : std::unique_lock<std::mutex>(execMutex);
+	  auto lock = (not logOn or ownTrace_ or !traceFile)? std::unique_lock<std::mutex>() : std::unique_lock<std::mutex>(execMutex);
 
 	    tickTime();
 
@@ -6073,7 +6706,7 @@ Hart<URV>::untilAddress(uint64_t address, FILE* traceFile)
 	  if (mcycleEnabled())
 	    ++cycleCount_;
 
-          if (hasActiveTrigger() and icountTriggerFired() and breakpOrEnterDebugTripped())
+          if (trigOn and hasActiveTrigger() and icountTriggerFired() and breakpOrEnterDebugTripped())
             {
               icountTrig_ = true;
               if (takeTriggerAction(traceFile, currPc_, 0, execCount_, nullptr /*di*/))
@@ -6088,7 +6721,7 @@ Hart<URV>::untilAddress(uint64_t address, FILE* traceFile)
 
           if (processExternalInterrupt(traceFile, instStr))
             {
-              if (sdtrigOn_)
+              if (trigOn and sdtrigOn_)
                 {
                   if (hasActiveTrigger())
                     evaluateIcountTrigger();
@@ -6098,9 +6731,10 @@ Hart<URV>::untilAddress(uint64_t address, FILE* traceFile)
             }
 
 	  uint64_t physPc = 0;
-          if (not fetchInstWithTrigger(pc_, physPc, inst, traceFile))
+	  DecodedInst* di = nullptr;
+          if (not fetchInstWithTrigger(pc_, physPc, inst, di, traceFile))
             {
-              if (sdtrigOn_)
+              if (trigOn and sdtrigOn_)
                 {
                   if (hasActiveTrigger())
                     evaluateIcountTrigger();
@@ -6108,19 +6742,13 @@ Hart<URV>::untilAddress(uint64_t address, FILE* traceFile)
                 }
               continue;  // Next instruction in trap handler.
             }
-
-	  // Decode unless match in decode cache.
-	  uint32_t ix = (physPc >> 1) & decodeCacheMask_;
-	  DecodedInst* di = &decodeCache_[ix];
-	  if (not di->isValid() or di->physAddress() != physPc or di->inst() != inst)
-	    decode(pc_, physPc, inst, *di);
           di->resetAddr(pc_);
 
           // Increment pc and execute instruction
 	  pc_ += di->instSize();
 	  execute(di);
 
-          if (hasActiveTrigger())
+          if (trigOn and hasActiveTrigger())
             evaluateIcountTrigger();
 
 	  bool doStats = statsEnabled and (not roiActive or traceOn_);
@@ -6129,12 +6757,13 @@ Hart<URV>::untilAddress(uint64_t address, FILE* traceFile)
 	    {
               if (doStats)
                 accumulateInstructionStats(*di);
-	      printDecodedInstTrace(*di, execCount_, instStr, traceFile);
+              if constexpr (logOn)
+                printDecodedInstTrace(*di, execCount_, instStr, traceFile);
               evaluateDebugStep();
 	      continue;
 	    }
 
-	  if (initStateFile_)
+	  if (initOn and initStateFile_)
 	    {
 	      for (const auto& walk : virtMem_.getFetchWalks())
 		for (auto addr : walk.pteAddrs())
@@ -6161,13 +6790,13 @@ Hart<URV>::untilAddress(uint64_t address, FILE* traceFile)
           // Unlike minstret, this is not inhibited.
           ++retireCount_;
 
-	  if (bbFile_)
+	  if (bbOn and bbFile_)
 	    {
 	      countBasicBlocks(bbPrevIsBranch_, physPc);
 	      bbPrevIsBranch_ = di->isBranch();
 	    }
 
-	  if (instrLineTrace_)
+	  if (lineOn and instrLineTrace_)
 	    memory_.traceInstructionLine(currPc_, physPc);
 
 	  if (doStats)
@@ -6176,12 +6805,13 @@ Hart<URV>::untilAddress(uint64_t address, FILE* traceFile)
 	  if (traceOn_) // and lastPriv_ == PrivilegeMode::User)
 	    {
 	      traceCount_++;
-	      printDecodedInstTrace(*di, execCount_, instStr, traceFile);
+              if constexpr (logOn)
+                printDecodedInstTrace(*di, execCount_, instStr, traceFile);
               if (not traceWasOn)
                 throw CoreException(CoreException::RoiEntry, "Taking snapshot on ROI entry.");
 	    }
 
-          if (sdtrigOn_)
+          if (trigOn and sdtrigOn_)
             evaluateDebugStep();
 
           prevPerfControl_ = perfControl_;
@@ -6283,6 +6913,69 @@ Hart<URV>::runSteps(uint64_t steps, bool& stop, FILE* traceFile)
 }
 
 
+template <typename URV>
+bool
+Hart<URV>::atSyncInst()
+{
+  uint32_t inst = 0;
+  if (not readInst(pc_, inst) or (inst & 3) != 3)
+    return false;  // Fetch fails or compressed instruction.
+
+  unsigned opcode = inst & 0x7f, funct3 = (inst >> 12) & 7, fm = inst >> 28;
+  if (opcode == 0x2f)
+    return true;  // AMO, LR, SC, Zalasr load/store.
+
+  // Fence with W in predecessor set and R in successor set. Fence.tso
+  // does not order stores with later loads.
+  return opcode == 0xf and funct3 == 0 and fm != 8 and ((inst >> 24) & 1) and ((inst >> 21) & 1);
+}
+
+
+template <typename URV>
+bool
+Hart<URV>::runStepsToSync(uint64_t steps, bool& stop, bool& sync, FILE* traceFile)
+{
+  // Setup signal handlers. Restore on destruction.
+  SignalHandlers handlers;
+
+  const uint64_t instLim = instCountLim_;
+  const uint64_t retInstLim = retCountLim_;
+  URV stopAddr = stopAddrValid_? stopAddr_ : ~URV(0); // ~URV(0): No-stop PC.
+  stop = sync = false;
+
+  for (uint64_t i = 0; i < steps; i++)
+    {
+      if (execCount_ >= instLim or retireCount_ >= retInstLim)
+        {
+          stop = true;
+          std::cerr << "Info: Stopped -- Reached instruction limit\n";
+          return not failOnInstLimit_;
+        }
+      if (pc_ == stopAddr)
+        {
+          stop = true;
+          std::cerr << "Info: Stopped -- Reached end address\n";
+          return true;
+        }
+
+      if (atSyncInst())
+        {
+          sync = true;
+          return true;
+        }
+
+      singleStep(traceFile);
+
+      if (hasTargetProgramFinished())
+        {
+          stop = true;
+          return stepResult_;
+        }
+    }
+  return true;
+}
+
+
 template <typename URV>
 bool
 Hart<URV>::simpleRun()
@@ -6300,7 +6993,7 @@ Hart<URV>::simpleRun()
         {
           bool hasLim = (instCountLim_ < ~uint64_t(0)) or bbFile_ or instrLineTrace_;
           hasLim = hasLim or isRvs() or isRvu() or isRvv() or hasAclint() or imsic_ or aplic_;
-          hasLim = hasLim or traceCacheOn_;
+          hasLim = hasLim or traceCacheOn_ or memory_.hasExternalCallbacks();
           hasLim = hasLim or canReceiveInterrupts() or hintOps_;
 
           if (hasLim)
@@ -6443,14 +7136,10 @@ Hart<URV>::simpleRunWithLimit()
         continue;  // Next instruction in trap handler.
 
       // Fetch/decode unless match in decode cache.
-      uint32_t inst = 0;
       uint64_t physPc = 0;
-      if (not fetchInst(pc_, physPc, inst))
+      DecodedInst* di = nullptr;
+      if (not fetchDecodedInst(pc_, physPc, di))
         continue;
-      uint32_t ix = (physPc >> 1) & decodeCacheMask_;
-      DecodedInst* di = &decodeCache_[ix];
-      if (not di->isValid() or di->physAddress() != physPc or di->inst() != inst)
-	decode(pc_, physPc, inst, *di);
       di->resetAddr(pc_);
 
       pc_ += di->instSize();
@@ -6487,33 +7176,123 @@ Hart<URV>::simpleRunWithLimit()
 }
 
 
+template <typename URV>
+bool
+Hart<URV>::buildDecodedBlock(DecodedBlock& block, uint64_t pa)
+{
+  block.insts_.clear();
+  block.pc_ = pc_;
+  block.pa_ = pa;
+  block.gen_ = blockCacheGen_;
+  block.priv_ = privMode_;
+  block.virt_ = virtMode_;
+
+  // Read the page generation before the instructions: a write racing
+  // with the build leaves the block stale rather than wrongly valid.
+  block.pageGen_ = memory_.pageGeneration(pa);
+
+  bool useGen = decodeCacheUsesGen();
+  uint64_t va = pc_;
+  uint64_t pageEnd = memory_.getPageStartAddr(va) + memory_.pageSize();
+
+  while (block.insts_.size() < maxBlockInsts_ and va < pageEnd)
+    {
+      // A fetch fault ends the block: the fault is taken when (and if)
+      // execution reaches the faulting instruction.
+      uint64_t fva = va, ipa = 0, pa2 = 0, gpa = 0;
+      uint32_t inst = 0;
+      if (fetchInstNoTrap(fva, ipa, pa2, gpa, inst) != ExceptionCause::NONE)
+        break;
+
+      // The block page generation does not cover the second page of a
+      // page-crossing instruction: such an instruction is run alone.
+      if (not isCompressedInst(inst) and va + 4 > pageEnd)
+        break;
+
+      // Decode through the shared decode cache: entries are reused
+      // across the run loops. An entry gets the block page generation,
+      // read before the fetch.
+      uint32_t ix = (ipa >> 1) & decodeCacheMask_;
+      DecodedInst& entry = decodeCache_[ix];
+      if (not entry.isValid() or entry.physAddress() != ipa or entry.inst() != inst)
+        decode(va, ipa, inst, entry);
+      decodePageGen_[ix] = useGen ? block.pageGen_ : block.pageGen_ - 1;
+
+      auto& di = block.insts_.emplace_back(entry);
+      di.resetAddr(va);
+
+      blockCodePages_.set(memory_.getPageIx(ipa) % blockPageFilterSize_);
+
+      va += di.instSize();
+      if (di.isBranch() or di.isXRet() or di.isCsr() or di.isFence_i())
+        break;
+    }
+
+  return not block.insts_.empty();
+}
+
+
 template <typename URV>
 bool
 Hart<URV>::simpleRunNoLimit()
 {
   while (noUserStop)
     {
-      tickTime();
+      if (blockCachePmaGen_ != pmaMgr_.generation()) [[unlikely]]
+        {
+          invalidateBlockCache();
+          blockCachePmaGen_ = pmaMgr_.generation();
+        }
 
-      currPc_ = pc_;
-      ++execCount_;
+      // Look up the block starting at pc by physical address, building
+      // it on a miss.
+      uint64_t pa = 0, gpa = 0;
+      DecodedBlock* block = nullptr;
+      if (translateInstAddr(pc_, pa, gpa) == ExceptionCause::NONE)
+        {
+          block = &blockCache_[(pa >> 1) & blockCacheMask_];
+          if (not isBlockValid(*block, pa) and not buildDecodedBlock(*block, pa))
+            block = nullptr;
+        }
 
-      // Fetch/decode unless match in decode cache.
-      uint32_t ix = (pc_ >> 1) & decodeCacheMask_;
-      DecodedInst* di = &decodeCache_[ix];
-      if (not di->isValid() or di->address() != pc_)
+      if (not block)
         {
-          uint32_t inst = 0;
-	  uint64_t physPc = 0;
-          if (not fetchInst(pc_, physPc, inst))
-            continue;
-          decode(pc_, physPc, inst, *di);
+          // Fetch fault or page-crossing instruction: run it (or take
+          // the fault) outside of the block cache.
+          tickTime();
+          currPc_ = pc_;
+          ++execCount_;
+          uint64_t physPc = 0;
+          DecodedInst* di = nullptr;
+          if (fetchDecodedInst(pc_, physPc, di))
+            {
+              di->resetAddr(pc_);
+              pc_ += di->instSize();
+              execute(di);
+              ++retireCount_;
+            }
+          continue;
         }
 
-      pc_ += di->instSize();
-      execute(di);
+      // Run the block until its end, a taken branch, a trap, or a store
+      // that invalidates cached code (generation change).
+      const uint64_t gen = blockCacheGen_;
+      for (const DecodedInst& di : block->insts_)
+        {
+          tickTime();
+
+          currPc_ = pc_;
+          ++execCount_;
+
+          URV nextPc = pc_ + di.instSize();
+          pc_ = nextPc;
+          execute(&di);
+
+          ++retireCount_;
 
-      ++retireCount_;
+          if (pc_ != nextPc or blockCacheGen_ != gen or not noUserStop)
+            break;
+        }
     }
 
   return true;
@@ -6952,10 +7731,6 @@ Hart<URV>::acceptGdbConnection()
 }
 
 
-//NOLINTNEXTLINE(bugprone-reserved-identifier, cppcoreguidelines-avoid-non-const-global-variables)
-extern void (*__tracerExtension)(void*);
-
-
 /// Run indefinitely.  If the tohost address is defined, then run till
 /// a write is attempted to that address.
 template <typename URV>
@@ -7374,23 +8149,22 @@ template <typename URV>
 void
 Hart<URV>::invalidateDecodeCache(URV addr, unsigned storeSize)
 {
-  // Consider putting this in a callback associated with memory
-  // write/poke. This way it can be applied only to pages marked
-  // execute.
-
-  // We want to check the location before the address just in case it
-  // contains a 4-byte instruction that overlaps what was written.
-  storeSize += 3;
-  addr -= 3;
-
-  for (unsigned i = 0; i < storeSize; i += 2)
-    {
-      URV instAddr = (addr + i) >> 1;
-      uint32_t cacheIx = instAddr & decodeCacheMask_;
-      auto& entry = decodeCache_[cacheIx];
-      if ((entry.address() >> 1) == instAddr)
-	entry.invalidate();
-    }
+  // The decode cache needs no work here: every RAM write advances the
+  // write generation of its page (Memory::poke) which invalidates the
+  // decoded instructions of that page.
+
+  // Drop the block cache if the store may overlap a page holding cached
+  // blocks. This stops a block modifying its own code at the store:
+  // stores by other harts are caught by the page generation of the
+  // block on its next lookup.
+  uint64_t firstPage = memory_.getPageIx(addr);
+  uint64_t lastPage = memory_.getPageIx(addr + storeSize - 1);
+  for (uint64_t page = firstPage; page <= lastPage; ++page)
+    if (blockCodePages_.test(page % blockPageFilterSize_))
+      {
+        invalidateBlockCache();
+        break;
+      }
 }
 
 
@@ -7400,6 +8174,7 @@ Hart<URV>::invalidateDecodeCache()
 {
   for (auto& entry : decodeCache_)
     entry.invalidate();
+  invalidateBlockCache();
 }
 
 
@@ -7461,7 +8236,8 @@ Hart<URV>::singleStep(DecodedInst& di, FILE* traceFile)
         }
 
       uint64_t physPc = 0;
-      if (not fetchInstWithTrigger(pc_, physPc, inst, traceFile))
+      DecodedInst* cached = nullptr;
+      if (not fetchInstWithTrigger(pc_, physPc, inst, cached, traceFile))
         {
           if (sdtrigOn_)
             {
@@ -7473,7 +8249,8 @@ Hart<URV>::singleStep(DecodedInst& di, FILE* traceFile)
           return;
         }
 
-      decode(pc_, physPc, inst, di);
+      di = *cached;
+      di.resetAddr(pc_);
 
       auto debugStopCount = isDebugModeStopCount(*this);
 
@@ -7541,7 +8318,7 @@ Hart<URV>::execLui(const DecodedInst* di)
 // NOLINTBEGIN(readability-function-size)
 template <typename URV>
 void
-Hart<URV>::execute(const DecodedInst* di)
+Hart<URV>::executeSwitch(const DecodedInst* di)
 {
   const InstEntry* entry = di->instEntry();
   hyperLs_ = false;
@@ -7554,4030 +8331,199 @@ Hart<URV>::execute(const DecodedInst* di)
 
   switch (entry->instId())
     {
-    case InstId::illegal:
-      illegalInst(di);
+#define INST_EXEC(id, method)                   \
+    case InstId::id:                            \
+      method(di);                               \
       return;
-
-    case InstId::lui:
-      execLui(di);
+#define INST_EXEC_ZC(id, ext, method)           \
+    case InstId::id:                            \
+      if (isRvzca() and ext())                  \
+        method(di);                             \
+      else                                      \
+        illegalInst(di);                        \
       return;
+#include "InstExecList.hpp"
 
-    case InstId::auipc:
-      execAuipc(di);
+    case InstId::illegal:
+      illegalInst(di);
       return;
 
-    case InstId::jal:
-      execJal(di);
+    case InstId::c_ld:
+      if (not isRvzca() or (not isRv64() and not isRvzclsd()))
+        illegalInst(di);  // Must have Zca, and in Rv32 must have Zclsd.
+      else
+        execLd(di);
       return;
 
-    case InstId::jalr:
-      execJalr(di);
+    case InstId::c_sd:
+      if (not isRvzca() or (not isRv64() and not isRvzclsd()))
+        illegalInst(di);  // Must have Zca, and in Rv32 must have Zclsd.
+      else
+        execSd(di);
       return;
 
-    case InstId::beq:
-      execBeq(di);
+    case InstId::c_srli64:
+      illegalInst(di);  // Only valid in rv128 which is not supported.
       return;
 
-    case InstId::bne:
-      execBne(di);
+    case InstId::c_srai64:
+      illegalInst(di);  // Only valid in rv128 which is not supported.
       return;
 
-    case InstId::beqi:
-      execBeqi(di);
+    case InstId::c_ldsp:
+      if (not isRvzca() or (not isRv64() and not isRvzclsd()))
+        illegalInst(di);  // Must have Zca, and in Rv32 must have Zclsd.
+      else
+        execLd(di);
       return;
 
-    case InstId::bnei:
-      execBnei(di);
+    case InstId::c_sdsp:
+      if (not isRvzca() or (not isRv64() and not isRvzclsd()))
+        illegalInst(di);  // Must have Zca, and in Rv32 must have Zclsd.
+      else
+        execSd(di);
       return;
 
-    case InstId::blt:
-      execBlt(di);
+    case InstId::endId_:
+      assert(0 && "Error: Shouldn't be able to get here");
       return;
+    }
 
-    case InstId::bge:
-      execBge(di);
-      return;
+  assert(0 && "Error: Shouldn't be able to get here if all cases above returned");
+}
 
-    case InstId::bltu:
-      execBltu(di);
-      return;
 
-    case InstId::bgeu:
-      execBgeu(di);
-      return;
+// Threaded dispatch: Map each instruction id to a handler calling the
+// corresponding exec method directly. The table and executeSwitch are
+// generated from the same list (InstExecList.hpp). Ids without an entry
+// (null handler) are executed through executeSwitch.
+template <typename URV>
+DecodedInst::ExecHandler
+Hart<URV>::resolveExecHandler(InstId id)
+{
+  using Table = std::array<DecodedInst::ExecHandler, size_t(InstId::endId_)>;
 
-    case InstId::lb:
-      execLb(di);
-      return;
+  static const Table table = []() {
+    using enum InstId;
+    Table t{};
 
-    case InstId::lb_aq:
-      execLb_aq(di);
-      return;
+#define INST_EXEC(id, method)                                   \
+    t[size_t(id)] = &execThunk<&Hart::method>;
+#define INST_EXEC_ZC(id, ext, method)                           \
+    t[size_t(id)] = &execZcThunk<&Hart::ext, &Hart::method>;
+#include "InstExecList.hpp"
 
-    case InstId::lh_aq:
-      execLh_aq(di);
-      return;
+    return t;
+  }();
 
-    case InstId::lw_aq:
-      execLw_aq(di);
-      return;
+  auto ix = size_t(id);
+  return ix < table.size() ? table[ix] : nullptr;
+}
+// NOLINTEND(readability-function-size)
 
-    case InstId::ld_aq:
-      execLd_aq(di);
-      return;
 
-    case InstId::sb_rl:
-      execSb_rl(di);
-      return;
+template <typename URV>
+void
+Hart<URV>::enableInstructionFrequency(bool b)
+{
+  instFreq_ = b;
+  instrumChanged_ = true;
+  if (b)
+    instProfs_.configure();
+}
 
-    case InstId::sh_rl:
-      execSh_rl(di);
-      return;
 
-    case InstId::sw_rl:
-      execSw_rl(di);
-      return;
+template <typename URV>
+void
+Hart<URV>::enterDebugMode_(DebugModeCause cause, URV pc)
+{
+  if (cancelLrOnDebug_)
+    cancelLr(CancelLrCause::ENTER_DEBUG);  // Lose LR reservation.
 
-    case InstId::sd_rl:
-      execSd_rl(di);
-      return;
+  if (debugMode_)
+    std::cerr << "Warning: Entering debug-mode while in debug-mode\n";
+  debugMode_ = true;
+  csRegs_.enterDebug(true);
+  enteredDebugMode_ = (cause == DebugModeCause::EBREAK) or
+                      (cause == DebugModeCause::TRIGGER);
 
-    case InstId::lh:
-      execLh(di);
-      return;
+  updateCachedTriggerState();
 
-    case InstId::lw:
-      execLw(di);
-      return;
+  URV value = 0;
+  if (peekCsr(CsrNumber::DCSR, value))
+    {
+      DcsrFields<URV> dcsr(value);
+      dcsr.bits_.CAUSE = URV(cause);
+      dcsr.bits_.PRV = URV(privMode_) & 0x3;
+      dcsr.bits_.V = virtMode_;
+      if (isRvZicfilp())
+        {
+          dcsr.bits_.PELP = elp_;
+          setElp(false);
+        }
 
-    case InstId::lbu:
-      execLbu(di);
-      return;
+      if (nmiPending_)
+        dcsr.bits_.NMIP = 1;
+      csRegs_.poke(CsrNumber::DCSR, dcsr.value_);
+    }
 
-    case InstId::lhu:
-      execLhu(di);
-      return;
+  csRegs_.poke(CsrNumber::DPC, pc);
+  setPrivilegeMode(PrivilegeMode::Machine);
+  setVirtualMode(false);
 
-    case InstId::sb:
-      execSb(di);
-      return;
+  // If hart is configured to jump to a special target on enetering debug mode, then set
+  // the pc to that target.
+  if (debugParkLoop_ != ~URV(0))
+    {
+      pc_ = debugParkLoop_;
+      inDebugParkLoop_ = true;
+    }
+}
 
-    case InstId::sh:
-      execSh(di);
-      return;
 
-    case InstId::sw:
-      execSw(di);
-      return;
+template <typename URV>
+void
+Hart<URV>::enterDebugMode(URV pc)
+{
+  // This method is used by the test-bench to make the simulator follow it into
+  // debug-mode. Do nothing if the simulator got into debug-mode on its own.
+  if (debugMode_)
+    return;   // Already in debug mode.
 
-    case InstId::addi:
-      execAddi(di);
-      return;
+  enterDebugMode_(DebugModeCause::HALTREQ, pc);
+}
 
-    case InstId::slti:
-      execSlti(di);
-      return;
 
-    case InstId::sltiu:
-      execSltiu(di);
+template <typename URV>
+void
+Hart<URV>::exitDebugMode()
+{
+  if (not debugMode_)
+    {
+      std::cerr << "Warning: Bench sent exit debug while not in debug mode.\n";
       return;
+    }
 
-    case InstId::xori:
-      execXori(di);
-      return;
+  if (cancelLrOnDebug_)
+    cancelLr(CancelLrCause::EXIT_DEBUG);  // Lose LR reservation.
 
-    case InstId::ori:
-      execOri(di);
-      return;
+  pc_ = peekCsr(CsrNumber::DPC);  // Restore PC
 
-    case InstId::andi:
-      execAndi(di);
-      return;
+  debugMode_ = false;
+  inDebugParkLoop_ = false;
+  csRegs_.enterDebug(false);
 
-    case InstId::slli:
-      execSlli(di);
-      return;
+  updateCachedTriggerState();
 
-    case InstId::srli:
-      execSrli(di);
-      return;
+  URV dcsrVal = 0;
+  if (not peekCsr(CsrNumber::DCSR, dcsrVal))
+    std::cerr << "Warning: Failed to read DCSR in exit debug.\n";
 
-    case InstId::srai:
-      execSrai(di);
-      return;
+  DcsrFields<URV> dcsrf(dcsrVal);
 
-    case InstId::add:
-      execAdd(di);
-      return;
-
-    case InstId::sub:
-      execSub(di);
-      return;
-
-    case InstId::sll:
-      execSll(di);
-      return;
-
-    case InstId::slt:
-      execSlt(di);
-      return;
-
-    case InstId::sltu:
-      execSltu(di);
-      return;
-
-    case InstId::xor_:
-      execXor(di);
-      return;
-
-    case InstId::srl:
-      execSrl(di);
-      return;
-
-    case InstId::sra:
-      execSra(di);
-      return;
-
-    case InstId::or_:
-      execOr(di);
-      return;
-
-    case InstId::and_:
-      execAnd(di);
-      return;
-
-    case InstId::fence:
-    case InstId::pause:
-      execFence(di);
-      return;
-
-    case InstId::fence_tso:
-      execFence_tso(di);
-      return;
-
-    case InstId::fence_i:
-      execFencei(di);
-      return;
-
-    case InstId::ecall:
-      execEcall(di);
-      return;
-
-    case InstId::ebreak:
-      execEbreak(di);
-      return;
-
-    case InstId::csrrw:
-      execCsrrw(di);
-      return;
-
-    case InstId::csrrs:
-      execCsrrs(di);
-      return;
-
-    case InstId::csrrc:
-      execCsrrc(di);
-      return;
-
-    case InstId::csrrwi:
-      execCsrrwi(di);
-      return;
-
-    case InstId::csrrsi:
-      execCsrrsi(di);
-      return;
-
-    case InstId::csrrci:
-      execCsrrci(di);
-      return;
-
-    case InstId::lwu:
-      execLwu(di);
-      return;
-
-    case InstId::ld:
-      execLd(di);
-      return;
-
-    case InstId::sd:
-      execSd(di);
-      return;
-
-    case InstId::addiw:
-      execAddiw(di);
-      return;
-
-    case InstId::slliw:
-      execSlliw(di);
-      return;
-
-    case InstId::srliw:
-      execSrliw(di);
-      return;
-
-    case InstId::sraiw:
-      execSraiw(di);
-      return;
-
-    case InstId::addw:
-      execAddw(di);
-      return;
-
-    case InstId::subw:
-      execSubw(di);
-      return;
-
-    case InstId::sllw:
-      execSllw(di);
-      return;
-
-    case InstId::srlw:
-      execSrlw(di);
-      return;
-
-    case InstId::sraw:
-      execSraw(di);
-      return;
-
-    case InstId::mul:
-      execMul(di);
-      return;
-
-    case InstId::mulh:
-      execMulh(di);
-      return;
-
-    case InstId::mulhsu:
-      execMulhsu(di);
-      return;
-
-    case InstId::mulhu:
-      execMulhu(di);
-      return;
-
-    case InstId::div:
-      execDiv(di);
-      return;
-
-    case InstId::divu:
-      execDivu(di);
-      return;
-
-    case InstId::rem:
-      execRem(di);
-      return;
-
-    case InstId::remu:
-      execRemu(di);
-      return;
-
-    case InstId::mulw:
-      execMulw(di);
-      return;
-
-    case InstId::divw:
-      execDivw(di);
-      return;
-
-    case InstId::divuw:
-      execDivuw(di);
-      return;
-
-    case InstId::remw:
-      execRemw(di);
-      return;
-
-    case InstId::remuw:
-      execRemuw(di);
-      return;
-
-    case InstId::lr_w:
-      execLr_w(di);
-      return;
-
-    case InstId::sc_w:
-      execSc_w(di);
-      return;
-
-    case InstId::amoswap_w:
-      execAmoswap_w(di);
-      return;
-
-    case InstId::amoadd_w:
-      execAmoadd_w(di);
-      return;
-
-    case InstId::amoxor_w:
-      execAmoxor_w(di);
-      return;
-
-    case InstId::amoand_w:
-      execAmoand_w(di);
-      return;
-
-    case InstId::amoor_w:
-      execAmoor_w(di);
-      return;
-
-    case InstId::amomin_w:
-      execAmomin_w(di);
-      return;
-
-    case InstId::amomax_w:
-      execAmomax_w(di);
-      return;
-
-    case InstId::amominu_w:
-      execAmominu_w(di);
-      return;
-
-    case InstId::amomaxu_w:
-      execAmomaxu_w(di);
-      return;
-
-    case InstId::amoswap_b:
-      execAmoswap_b(di);
-      return;
-    case InstId::amoadd_b:
-      execAmoadd_b(di);
-      return;
-    case InstId::amoxor_b:
-      execAmoxor_b(di);
-      return;
-    case InstId::amoand_b:
-      execAmoand_b(di);
-      return;
-    case InstId::amoor_b:
-      execAmoor_b(di);
-      return;
-    case InstId::amomin_b:
-      execAmomin_b(di);
-      return;
-    case InstId::amomax_b:
-      execAmomax_b(di);
-      return;
-    case InstId::amominu_b:
-      execAmominu_b(di);
-      return;
-    case InstId::amomaxu_b:
-      execAmomaxu_b(di);
-      return;
-    case InstId::amoswap_h:
-      execAmoswap_h(di);
-      return;
-    case InstId::amoadd_h:
-      execAmoadd_h(di);
-      return;
-    case InstId::amoxor_h:
-      execAmoxor_h(di);
-      return;
-    case InstId::amoand_h:
-      execAmoand_h(di);
-      return;
-    case InstId::amoor_h:
-      execAmoor_h(di);
-      return;
-    case InstId::amomin_h:
-      execAmomin_h(di);
-      return;
-    case InstId::amomax_h:
-      execAmomax_h(di);
-      return;
-    case InstId::amominu_h:
-      execAmominu_h(di);
-      return;
-    case InstId::amomaxu_h:
-      execAmomaxu_h(di);
-      return;
-    case InstId::amocas_b:
-      execAmocas_b(di);
-      return;
-    case InstId::amocas_h:
-      execAmocas_h(di);
-      return;
-
-    case InstId::lr_d:
-      execLr_d(di);
-      return;
-
-    case InstId::sc_d:
-      execSc_d(di);
-      return;
-
-    case InstId::amoswap_d:
-      execAmoswap_d(di);
-      return;
-
-    case InstId::amoadd_d:
-      execAmoadd_d(di);
-      return;
-
-    case InstId::amoxor_d:
-      execAmoxor_d(di);
-      return;
-
-    case InstId::amoand_d:
-      execAmoand_d(di);
-      return;
-
-    case InstId::amoor_d:
-      execAmoor_d(di);
-      return;
-
-    case InstId::amomin_d:
-      execAmomin_d(di);
-      return;
-
-    case InstId::amomax_d:
-      execAmomax_d(di);
-      return;
-
-    case InstId::amominu_d:
-      execAmominu_d(di);
-      return;
-
-    case InstId::amomaxu_d:
-      execAmomaxu_d(di);
-      return;
-
-    case InstId::flw:
-      execFlw(di);
-      return;
-
-    case InstId::fsw:
-      execFsw(di);
-      return;
-
-    case InstId::fmadd_s:
-      execFmadd_s(di);
-      return;
-
-    case InstId::fmsub_s:
-      execFmsub_s(di);
-      return;
-
-    case InstId::fnmsub_s:
-      execFnmsub_s(di);
-      return;
-
-    case InstId::fnmadd_s:
-      execFnmadd_s(di);
-      return;
-
-    case InstId::fadd_s:
-      execFadd_s(di);
-      return;
-
-    case InstId::fsub_s:
-      execFsub_s(di);
-      return;
-
-    case InstId::fmul_s:
-      execFmul_s(di);
-      return;
-
-    case InstId::fdiv_s:
-      execFdiv_s(di);
-      return;
-
-    case InstId::fsqrt_s:
-      execFsqrt_s(di);
-      return;
-
-    case InstId::fsgnj_s:
-      execFsgnj_s(di);
-      return;
-
-    case InstId::fsgnjn_s:
-      execFsgnjn_s(di);
-      return;
-
-    case InstId::fsgnjx_s:
-      execFsgnjx_s(di);
-      return;
-
-    case InstId::fmin_s:
-      execFmin_s(di);
-      return;
-
-    case InstId::fmax_s:
-      execFmax_s(di);
-      return;
-
-    case InstId::fcvt_w_s:
-      execFcvt_w_s(di);
-      return;
-
-    case InstId::fcvt_wu_s:
-      execFcvt_wu_s(di);
-      return;
-
-    case InstId::fmv_x_w:
-      execFmv_x_w(di);
-      return;
-
-    case InstId::feq_s:
-      execFeq_s(di);
-      return;
-
-    case InstId::flt_s:
-      execFlt_s(di);
-      return;
-
-    case InstId::fle_s:
-      execFle_s(di);
-      return;
-
-    case InstId::fclass_s:
-      execFclass_s(di);
-      return;
-
-    case InstId::fcvt_s_w:
-      execFcvt_s_w(di);
-      return;
-
-    case InstId::fcvt_s_wu:
-      execFcvt_s_wu(di);
-      return;
-
-    case InstId::fmv_w_x:
-      execFmv_w_x(di);
-      return;
-
-    case InstId::fcvt_l_s:
-      execFcvt_l_s(di);
-      return;
-
-    case InstId::fcvt_lu_s:
-      execFcvt_lu_s(di);
-      return;
-
-    case InstId::fcvt_s_l:
-      execFcvt_s_l(di);
-      return;
-
-    case InstId::fcvt_s_lu:
-      execFcvt_s_lu(di);
-      return;
-
-    case InstId::fld:
-      execFld(di);
-      return;
-
-    case InstId::fsd:
-      execFsd(di);
-      return;
-
-    case InstId::fmadd_d:
-      execFmadd_d(di);
-      return;
-
-    case InstId::fmsub_d:
-      execFmsub_d(di);
-      return;
-
-    case InstId::fnmsub_d:
-      execFnmsub_d(di);
-      return;
-
-    case InstId::fnmadd_d:
-      execFnmadd_d(di);
-      return;
-
-    case InstId::fadd_d:
-      execFadd_d(di);
-      return;
-
-    case InstId::fsub_d:
-      execFsub_d(di);
-      return;
-
-    case InstId::fmul_d:
-      execFmul_d(di);
-      return;
-
-    case InstId::fdiv_d:
-      execFdiv_d(di);
-      return;
-
-    case InstId::fsqrt_d:
-      execFsqrt_d(di);
-      return;
-
-    case InstId::fsgnj_d:
-      execFsgnj_d(di);
-      return;
-
-    case InstId::fsgnjn_d:
-      execFsgnjn_d(di);
-      return;
-
-    case InstId::fsgnjx_d:
-      execFsgnjx_d(di);
-      return;
-
-    case InstId::fmin_d:
-      execFmin_d(di);
-      return;
-
-    case InstId::fmax_d:
-      execFmax_d(di);
-      return;
-
-    case InstId::fcvt_s_d:
-      execFcvt_s_d(di);
-      return;
-
-    case InstId::fcvt_d_s:
-      execFcvt_d_s(di);
-      return;
-
-    case InstId::feq_d:
-      execFeq_d(di);
-      return;
-
-    case InstId::flt_d:
-      execFlt_d(di);
-      return;
-
-    case InstId::fle_d:
-      execFle_d(di);
-      return;
-
-    case InstId::fclass_d:
-      execFclass_d(di);
-      return;
-
-    case InstId::fcvt_w_d:
-      execFcvt_w_d(di);
-      return;
-
-    case InstId::fcvt_wu_d:
-      execFcvt_wu_d(di);
-      return;
-
-    case InstId::fcvt_d_w:
-      execFcvt_d_w(di);
-      return;
-
-    case InstId::fcvt_d_wu:
-      execFcvt_d_wu(di);
-      return;
-
-    case InstId::fcvt_l_d:
-      execFcvt_l_d(di);
-      return;
-
-    case InstId::fcvt_lu_d:
-      execFcvt_lu_d(di);
-      return;
-
-    case InstId::fmv_x_d:
-      execFmv_x_d(di);
-      return;
-
-    case InstId::fcvt_d_l:
-      execFcvt_d_l(di);
-      return;
-
-    case InstId::fcvt_d_lu:
-      execFcvt_d_lu(di);
-      return;
-
-    case InstId::fmv_d_x:
-      execFmv_d_x(di);
-      return;
-
-    case InstId::flh:
-      execFlh(di);
-      return;
-
-    case InstId::fsh:
-      execFsh(di);
-      return;
-
-    case InstId::fmadd_h:
-      execFmadd_h(di);
-      return;
-
-    case InstId::fmsub_h:
-      execFmsub_h(di);
-      return;
-
-    case InstId::fnmsub_h:
-      execFnmsub_h(di);
-      return;
-
-    case InstId::fnmadd_h:
-      execFnmadd_h(di);
-      return;
-
-    case InstId::fadd_h:
-      execFadd_h(di);
-      return;
-
-    case InstId::fsub_h:
-      execFsub_h(di);
-      return;
-
-    case InstId::fmul_h:
-      execFmul_h(di);
-      return;
-
-    case InstId::fdiv_h:
-      execFdiv_h(di);
-      return;
-
-    case InstId::fsqrt_h:
-      execFsqrt_h(di);
-      return;
-
-    case InstId::fsgnj_h:
-      execFsgnj_h(di);
-      return;
-
-    case InstId::fsgnjn_h:
-      execFsgnjn_h(di);
-      return;
-
-    case InstId::fsgnjx_h:
-      execFsgnjx_h(di);
-      return;
-
-    case InstId::fmin_h:
-      execFmin_h(di);
-      return;
-
-    case InstId::fmax_h:
-      execFmax_h(di);
-      return;
-
-    case InstId::fcvt_s_h:
-      execFcvt_s_h(di);
-      return;
-
-    case InstId::fcvt_d_h:
-      execFcvt_d_h(di);
-      return;
-
-    case InstId::fcvt_h_s:
-      execFcvt_h_s(di);
-      return;
-
-    case InstId::fcvt_h_d:
-      execFcvt_h_d(di);
-      return;
-
-    case InstId::fcvt_w_h:
-      execFcvt_w_h(di);
-      return;
-
-    case InstId::fcvt_wu_h:
-      execFcvt_wu_h(di);
-      return;
-
-    case InstId::fmv_x_h:
-      execFmv_x_h(di);
-      return;
-
-    case InstId::feq_h:
-      execFeq_h(di);
-      return;
-
-    case InstId::flt_h:
-      execFlt_h(di);
-      return;
-
-    case InstId::fle_h:
-      execFle_h(di);
-      return;
-
-    case InstId::fclass_h:
-      execFclass_h(di);
-      return;
-
-    case InstId::fcvt_h_w:
-      execFcvt_h_w(di);
-      return;
-
-    case InstId::fcvt_h_wu:
-      execFcvt_h_wu(di);
-      return;
-
-    case InstId::fmv_h_x:
-      execFmv_h_x(di);
-      return;
-
-    case InstId::fcvt_l_h:
-      execFcvt_l_h(di);
-      return;
-
-    case InstId::fcvt_lu_h:
-      execFcvt_lu_h(di);
-      return;
-
-    case InstId::fcvt_h_l:
-      execFcvt_h_l(di);
-      return;
-
-    case InstId::fcvt_h_lu:
-      execFcvt_h_lu(di);
-      return;
-
-    case InstId::fcvt_bf16_s:
-      execFcvt_bf16_s(di);
-      return;
-
-    case InstId::fcvt_s_bf16:
-      execFcvt_s_bf16(di);
-      return;
-
-    case InstId::mret:
-      execMret(di);
-      return;
-
-    case InstId::sret:
-      execSret(di);
-      return;
-
-    case InstId::mnret:
-      execMnret(di);
-      return;
-
-    case InstId::wfi:
-      execWfi(di);
-      return;
-
-    case InstId::dret:
-      execDret(di);
-      return;
-
-    case InstId::sfence_vma:
-      execSfence_vma(di);
-      return;
-
-    case InstId::c_addi4spn:
-      if (isRvzca()) execAddi(di); else illegalInst(di);
-      return;
-
-    case InstId::c_fld:
-      if (isRvzca() and isRvzcd()) execFld(di); else illegalInst(di);
-      return;
-
-    case InstId::c_lq:
-      if (isRvzca()) execLq(di); else illegalInst(di);
-      return;
-
-    case InstId::c_lw:
-      if (isRvzca()) execLw(di); else illegalInst(di);
-      return;
-
-    case InstId::c_flw:
-      if (isRvzca() and isRvzcf()) execFlw(di);  else illegalInst(di);
-      return;
-
-    case InstId::c_ld:
-      if (not isRvzca() or (not isRv64() and not isRvzclsd()))
-        illegalInst(di);  // Must have Zca, and in Rv32 must have Zclsd.
-      else
-        execLd(di);
-      return;
-
-    case InstId::c_fsd:
-      if (isRvzca() and isRvzcd()) execFsd(di); else illegalInst(di);
-      return;
-
-    case InstId::c_sq:
-      if (isRvzca()) execSq(di); else illegalInst(di);
-      return;
-
-    case InstId::c_sw:
-      if (isRvzca()) execSw(di); else illegalInst(di);
-      return;
-
-    case InstId::c_fsw:
-      if (isRvzca() and isRvzcf()) execFsw(di);  else illegalInst(di);
-      return;
-
-    case InstId::c_sd:
-      if (not isRvzca() or (not isRv64() and not isRvzclsd()))
-        illegalInst(di);  // Must have Zca, and in Rv32 must have Zclsd.
-      else
-        execSd(di);
-      return;
-
-    case InstId::c_addi:
-      if (isRvzca()) execAddi(di); else illegalInst(di);
-      return;
-
-    case InstId::c_jal:
-      if (isRvzca()) execJal(di); else illegalInst(di);
-      return;
-
-    case InstId::c_li:
-    case InstId::c_addi16sp:
-      if (isRvzca()) execAddi(di); else illegalInst(di);
-      return;
-
-    case InstId::c_lui:
-      if (isRvzca()) execLui(di); else illegalInst(di);
-      return;
-
-    case InstId::c_srli:
-      if (isRvzca()) execSrli(di); else illegalInst(di);
-      return;
-
-    case InstId::c_srli64:
-      illegalInst(di);  // Only valid in rv128 which is not supported.
-      return;
-
-    case InstId::c_srai:
-      if (isRvzca()) execSrai(di); else illegalInst(di);
-      return;
-
-    case InstId::c_srai64:
-      illegalInst(di);  // Only valid in rv128 which is not supported.
-      return;
-
-    case InstId::c_andi:
-      if (isRvzca()) execAndi(di); else illegalInst(di);
-      return;
-
-    case InstId::c_sub:
-      if (isRvzca()) execSub(di); else illegalInst(di);
-      return;
-
-    case InstId::c_xor:
-      if (isRvzca()) execXor(di); else illegalInst(di);
-      return;
-
-    case InstId::c_or:
-      if (isRvzca()) execOr(di); else illegalInst(di);
-      return;
-
-    case InstId::c_and:
-      if (isRvzca()) execAnd(di); else illegalInst(di);
-      return;
-
-    case InstId::c_subw:
-      if (isRvzca()) execSubw(di); else illegalInst(di);
-      return;
-
-    case InstId::c_addw:
-      if (isRvzca()) execAddw(di); else illegalInst(di);
-      return;
-
-    case InstId::c_j:
-      if (isRvzca()) execJal(di); else illegalInst(di);
-      return;
-
-    case InstId::c_beqz:
-      if (isRvzca()) execBeq(di); else illegalInst(di);
-      return;
-
-    case InstId::c_bnez:
-      if (isRvzca()) execBne(di); else illegalInst(di);
-      return;
-
-    case InstId::c_slli:
-    case InstId::c_slli64:
-      if (isRvzca()) execSlli(di); else illegalInst(di);
-      return;
-
-    case InstId::c_fldsp:
-      if (isRvzca() and isRvzcd()) execFld(di); else illegalInst(di);
-      return;
-
-    case InstId::c_lwsp:
-      if (isRvzca()) execLw(di); else illegalInst(di);
-      return;
-
-    case InstId::c_flwsp:
-      if (isRvzca() and isRvzcf()) execFlw(di); else illegalInst(di);
-      return;
-
-    case InstId::c_ldsp:
-      if (not isRvzca() or (not isRv64() and not isRvzclsd()))
-        illegalInst(di);  // Must have Zca, and in Rv32 must have Zclsd.
-      else
-        execLd(di);
-      return;
-
-    case InstId::c_jr:
-      if (isRvzca()) execJalr(di); else illegalInst(di);
-      return;
-
-    case InstId::c_mv:
-      if (isRvzca()) execAdd(di); else illegalInst(di);
-      return;
-
-    case InstId::c_ebreak:
-      if (isRvzca()) execEbreak(di); else illegalInst(di);
-      return;
-
-    case InstId::c_jalr:
-      if (isRvzca()) execJalr(di); else illegalInst(di);
-      return;
-
-    case InstId::c_add:
-      if (isRvzca()) execAdd(di); else illegalInst(di);
-      return;
-
-    case InstId::c_fsdsp:
-      if (isRvzca() and isRvzcd()) execFsd(di); else illegalInst(di);
-      return;
-
-    case InstId::c_swsp:
-      if (isRvzca()) execSw(di); else illegalInst(di);
-      return;
-
-    case InstId::c_fswsp:
-      if (isRvzca() and isRvzcf()) execFsw(di); else illegalInst(di);
-      return;
-
-    case InstId::c_addiw:
-      if (isRvzca()) execAddiw(di); else illegalInst(di);
-      return;
-
-    case InstId::c_sdsp:
-      if (not isRvzca() or (not isRv64() and not isRvzclsd()))
-        illegalInst(di);  // Must have Zca, and in Rv32 must have Zclsd.
-      else
-        execSd(di);
-      return;
-
-    case InstId::clz:
-      execClz(di);
-      return;
-
-    case InstId::ctz:
-      execCtz(di);
-      return;
-
-    case InstId::cpop:
-      execCpop(di);
-      return;
-
-    case InstId::clzw:
-      execClzw(di);
-      return;
-
-    case InstId::ctzw:
-      execCtzw(di);
-      return;
-
-    case InstId::cpopw:
-      execCpopw(di);
-      return;
-
-    case InstId::min:
-      execMin(di);
-      return;
-
-    case InstId::max:
-      execMax(di);
-      return;
-
-    case InstId::minu:
-      execMinu(di);
-      return;
-
-    case InstId::maxu:
-      execMaxu(di);
-      return;
-
-    case InstId::sext_b:
-      execSext_b(di);
-      return;
-
-    case InstId::sext_h:
-      execSext_h(di);
-      return;
-
-    case InstId::andn:
-      execAndn(di);
-      return;
-
-    case InstId::orc_b:
-      execOrc_b(di);
-      return;
-
-    case InstId::orn:
-      execOrn(di);
-      return;
-
-    case InstId::xnor:
-      execXnor(di);
-      return;
-
-    case InstId::rol:
-      execRol(di);
-      return;
-
-    case InstId::ror:
-      execRor(di);
-      return;
-
-    case InstId::rori:
-      execRori(di);
-      return;
-
-    case InstId::rolw:
-      execRolw(di);
-      return;
-
-    case InstId::rorw:
-      execRorw(di);
-      return;
-
-    case InstId::roriw:
-      execRoriw(di);
-      return;
-
-    case InstId::pack:
-      execPack(di);
-      return;
-
-    case InstId::packh:
-      execPackh(di);
-      return;
-
-    case InstId::packw:
-      execPackw(di);
-      return;
-
-    case InstId::brev8:
-      execBrev8(di);
-      return;
-
-    case InstId::rev8_32:
-      execRev8_32(di);
-      return;
-
-    case InstId::rev8_64:
-      execRev8_64(di);
-      return;
-
-    case InstId::zip:
-      execZip(di);
-      return;
-
-    case InstId::unzip:
-      execUnzip(di);
-      return;
-
-    case InstId::xperm_n:
-      execXperm_n(di);
-      return;
-
-    case InstId::xperm_b:
-      execXperm_b(di);
-      return;
-
-    case InstId::bset:
-      execBset(di);
-      return;
-
-    case InstId::bclr:
-      execBclr(di);
-      return;
-
-    case InstId::binv:
-      execBinv(di);
-      return;
-
-    case InstId::bext:
-      execBext(di);
-      return;
-
-    case InstId::bseti:
-      execBseti(di);
-      return;
-
-    case InstId::bclri:
-      execBclri(di);
-      return;
-
-    case InstId::binvi:
-      execBinvi(di);
-      return;
-
-    case InstId::bexti:
-      execBexti(di);
-      return;
-
-    case InstId::clmul:
-      execClmul(di);
-      return;
-
-    case InstId::clmulh:
-      execClmulh(di);
-      return;
-
-    case InstId::clmulr:
-      execClmulr(di);
-      return;
-
-    case InstId::sh1add:
-      execSh1add(di);
-      return;
-
-    case InstId::sh2add:
-      execSh2add(di);
-      return;
-
-    case InstId::sh3add:
-      execSh3add(di);
-      return;
-
-    case InstId::sh1add_uw:
-      execSh1add_uw(di);
-      return;
-
-    case InstId::sh2add_uw:
-      execSh2add_uw(di);
-      return;
-
-    case InstId::sh3add_uw:
-      execSh3add_uw(di);
-      return;
-
-    case InstId::add_uw:
-      execAdd_uw(di);
-      return;
-
-    case InstId::slli_uw:
-      execSlli_uw(di);
-      return;
-
-    case InstId::vsetvli:
-      execVsetvli(di);
-      return;
-
-    case InstId::vsetivli:
-      execVsetivli(di);
-      return;
-
-    case InstId::vsetvl:
-      execVsetvl(di);
-      return;
-
-    case InstId::vadd_vv:
-      execVadd_vv(di);
-      return;
-
-    case InstId::vadd_vx:
-      execVadd_vx(di);
-      return;
-
-    case InstId::vadd_vi:
-      execVadd_vi(di);
-      return;
-
-    case InstId::vsub_vv:
-      execVsub_vv(di);
-      return;
-
-    case InstId::vsub_vx:
-      execVsub_vx(di);
-      return;
-
-    case InstId::vrsub_vx:
-      execVrsub_vx(di);
-      return;
-
-    case InstId::vrsub_vi:
-      execVrsub_vi(di);
-      return;
-
-    case InstId::vwaddu_vv:
-      execVwaddu_vv(di);
-      return;
-
-    case InstId::vwaddu_vx:
-      execVwaddu_vx(di);
-      return;
-
-    case InstId::vwsubu_vv:
-      execVwsubu_vv(di);
-      return;
-
-    case InstId::vwsubu_vx:
-      execVwsubu_vx(di);
-      return;
-
-    case InstId::vwadd_vv:
-      execVwadd_vv(di);
-      return;
-
-    case InstId::vwadd_vx:
-      execVwadd_vx(di);
-      return;
-
-    case InstId::vwsub_vv:
-      execVwsub_vv(di);
-      return;
-
-    case InstId::vwsub_vx:
-      execVwsub_vx(di);
-      return;
-
-    case InstId::vwaddu_wv:
-      execVwaddu_wv(di);
-      return;
-
-    case InstId::vwaddu_wx:
-      execVwaddu_wx(di);
-      return;
-
-    case InstId::vwsubu_wv:
-      execVwsubu_wv(di);
-      return;
-
-    case InstId::vwsubu_wx:
-      execVwsubu_wx(di);
-      return;
-
-    case InstId::vwadd_wv:
-      execVwadd_wv(di);
-      return;
-
-    case InstId::vwadd_wx:
-      execVwadd_wx(di);
-      return;
-
-    case InstId::vwsub_wv:
-      execVwsub_wv(di);
-      return;
-
-    case InstId::vwsub_wx:
-      execVwsub_wx(di);
-      return;
-
-    case InstId::vmseq_vv:
-      execVmseq_vv(di);
-      return;
-
-    case InstId::vmseq_vx:
-      execVmseq_vx(di);
-      return;
-
-    case InstId::vmseq_vi:
-      execVmseq_vi(di);
-      return;
-
-    case InstId::vmsne_vv:
-      execVmsne_vv(di);
-      return;
-
-    case InstId::vmsne_vx:
-      execVmsne_vx(di);
-      return;
-
-    case InstId::vmsne_vi:
-      execVmsne_vi(di);
-      return;
-
-    case InstId::vmsltu_vv:
-      execVmsltu_vv(di);
-      return;
-
-    case InstId::vmsltu_vx:
-      execVmsltu_vx(di);
-      return;
-
-    case InstId::vmslt_vv:
-      execVmslt_vv(di);
-      return;
-
-    case InstId::vmslt_vx:
-      execVmslt_vx(di);
-      return;
-
-    case InstId::vmsleu_vv:
-      execVmsleu_vv(di);
-      return;
-
-    case InstId::vmsleu_vx:
-      execVmsleu_vx(di);
-      return;
-
-    case InstId::vmsleu_vi:
-      execVmsleu_vi(di);
-      return;
-
-    case InstId::vmsle_vv:
-      execVmsle_vv(di);
-      return;
-
-    case InstId::vmsle_vx:
-      execVmsle_vx(di);
-      return;
-
-    case InstId::vmsle_vi:
-      execVmsle_vi(di);
-      return;
-
-    case InstId::vmsgtu_vx:
-      execVmsgtu_vx(di);
-      return;
-
-    case InstId::vmsgtu_vi:
-      execVmsgtu_vi(di);
-      return;
-
-    case InstId::vmsgt_vx:
-      execVmsgt_vx(di);
-      return;
-
-    case InstId::vmsgt_vi:
-      execVmsgt_vi(di);
-      return;
-
-    case InstId::vminu_vv:
-      execVminu_vv(di);
-      return;
-
-    case InstId::vminu_vx:
-      execVminu_vx(di);
-      return;
-
-    case InstId::vmin_vv:
-      execVmin_vv(di);
-      return;
-
-    case InstId::vmin_vx:
-      execVmin_vx(di);
-      return;
-
-    case InstId::vmaxu_vv:
-      execVmaxu_vv(di);
-      return;
-
-    case InstId::vmaxu_vx:
-      execVmaxu_vx(di);
-      return;
-
-    case InstId::vmax_vv:
-      execVmax_vv(di);
-      return;
-
-    case InstId::vmax_vx:
-      execVmax_vx(di);
-      return;
-
-    case InstId::vand_vv:
-      execVand_vv(di);
-      return;
-
-    case InstId::vand_vx:
-      execVand_vx(di);
-      return;
-
-    case InstId::vand_vi:
-      execVand_vi(di);
-      return;
-
-    case InstId::vor_vv:
-      execVor_vv(di);
-      return;
-
-    case InstId::vor_vx:
-      execVor_vx(di);
-      return;
-
-    case InstId::vor_vi:
-      execVor_vi(di);
-      return;
-
-    case InstId::vxor_vv:
-      execVxor_vv(di);
-      return;
-
-    case InstId::vxor_vx:
-      execVxor_vx(di);
-      return;
-
-    case InstId::vxor_vi:
-      execVxor_vi(di);
-      return;
-
-    case InstId::vsll_vv:
-      execVsll_vv(di);
-      return;
-
-    case InstId::vsll_vx:
-      execVsll_vx(di);
-      return;
-
-    case InstId::vsll_vi:
-      execVsll_vi(di);
-      return;
-
-    case InstId::vsrl_vv:
-      execVsrl_vv(di);
-      return;
-
-    case InstId::vsrl_vx:
-      execVsrl_vx(di);
-      return;
-
-    case InstId::vsrl_vi:
-      execVsrl_vi(di);
-      return;
-
-    case InstId::vsra_vv:
-      execVsra_vv(di);
-      return;
-
-    case InstId::vsra_vx:
-      execVsra_vx(di);
-      return;
-
-    case InstId::vsra_vi:
-      execVsra_vi(di);
-      return;
-
-    case InstId::vnsrl_wv:
-      execVnsrl_wv(di);
-      return;
-
-    case InstId::vnsrl_wx:
-      execVnsrl_wx(di);
-      return;
-
-    case InstId::vnsrl_wi:
-      execVnsrl_wi(di);
-      return;
-
-    case InstId::vnsra_wv:
-      execVnsra_wv(di);
-      return;
-
-    case InstId::vnsra_wx:
-      execVnsra_wx(di);
-      return;
-
-    case InstId::vnsra_wi:
-      execVnsra_wi(di);
-      return;
-
-    case InstId::vrgather_vv:
-      execVrgather_vv(di);
-      return;
-
-    case InstId::vrgather_vx:
-      execVrgather_vx(di);
-      return;
-
-    case InstId::vrgather_vi:
-      execVrgather_vi(di);
-      return;
-
-    case InstId::vrgatherei16_vv:
-      execVrgatherei16_vv(di);
-      return;
-
-    case InstId::vcompress_vm:
-      execVcompress_vm(di);
-      return;
-
-    case InstId::vredsum_vs:
-      execVredsum_vs(di);
-      return;
-
-    case InstId::vredand_vs:
-      execVredand_vs(di);
-      return;
-
-    case InstId::vredor_vs:
-      execVredor_vs(di);
-      return;
-
-    case InstId::vredxor_vs:
-      execVredxor_vs(di);
-      return;
-
-    case InstId::vredminu_vs:
-      execVredminu_vs(di);
-      return;
-
-    case InstId::vredmin_vs:
-      execVredmin_vs(di);
-      return;
-
-    case InstId::vredmaxu_vs:
-      execVredmaxu_vs(di);
-      return;
-
-    case InstId::vredmax_vs:
-      execVredmax_vs(di);
-      return;
-
-    case InstId::vwredsumu_vs:
-      execVwredsumu_vs(di);
-      return;
-
-    case InstId::vwredsum_vs:
-      execVwredsum_vs(di);
-      return;
-
-    case InstId::vmand_mm:
-      execVmand_mm(di);
-      return;
-
-    case InstId::vmnand_mm:
-      execVmnand_mm(di);
-      return;
-
-    case InstId::vmandn_mm:
-      execVmandn_mm(di);
-      return;
-
-    case InstId::vmxor_mm:
-      execVmxor_mm(di);
-      return;
-
-    case InstId::vmor_mm:
-      execVmor_mm(di);
-      return;
-
-    case InstId::vmnor_mm:
-      execVmnor_mm(di);
-      return;
-
-    case InstId::vmorn_mm:
-      execVmorn_mm(di);
-      return;
-
-    case InstId::vmxnor_mm:
-      execVmxnor_mm(di);
-      return;
-
-    case InstId::vcpop_m:
-      execVcpop_m(di);
-      return;
-
-    case InstId::vfirst_m:
-      execVfirst_m(di);
-      return;
-
-    case InstId::vmsbf_m:
-      execVmsbf_m(di);
-      return;
-
-    case InstId::vmsif_m:
-      execVmsif_m(di);
-      return;
-
-    case InstId::vmsof_m:
-      execVmsof_m(di);
-      return;
-
-    case InstId::viota_m:
-      execViota_m(di);
-      return;
-
-    case InstId::vid_v:
-      execVid_v(di);
-      return;
-
-    case InstId::vslideup_vx:
-      execVslideup_vx(di);
-      return;
-
-    case InstId::vslideup_vi:
-      execVslideup_vi(di);
-      return;
-
-    case InstId::vslide1up_vx:
-      execVslide1up_vx(di);
-      return;
-
-    case InstId::vslidedown_vx:
-      execVslidedown_vx(di);
-      return;
-
-    case InstId::vslidedown_vi:
-      execVslidedown_vi(di);
-      return;
-
-    case InstId::vslide1down_vx:
-      execVslide1down_vx(di);
-      return;
-
-    case InstId::vfslide1up_vf:
-      execVfslide1up_vf(di);
-      return;
-
-    case InstId::vfslide1down_vf:
-      execVfslide1down_vf(di);
-      return;
-
-    case InstId::vmul_vv:
-      execVmul_vv(di);
-      return;
-
-    case InstId::vmul_vx:
-      execVmul_vx(di);
-      return;
-
-    case InstId::vmulh_vv:
-      execVmulh_vv(di);
-      return;
-
-    case InstId::vmulh_vx:
-      execVmulh_vx(di);
-      return;
-
-    case InstId::vmulhu_vv:
-      execVmulhu_vv(di);
-      return;
-
-    case InstId::vmulhu_vx:
-      execVmulhu_vx(di);
-      return;
-
-    case InstId::vmulhsu_vv:
-      execVmulhsu_vv(di);
-      return;
-
-    case InstId::vmulhsu_vx:
-      execVmulhsu_vx(di);
-      return;
-
-    case InstId::vmadd_vv:
-      execVmadd_vv(di);
-      return;
-
-    case InstId::vmadd_vx:
-      execVmadd_vx(di);
-      return;
-
-    case InstId::vnmsub_vv:
-      execVnmsub_vv(di);
-      return;
-
-    case InstId::vnmsub_vx:
-      execVnmsub_vx(di);
-      return;
-
-    case InstId::vmacc_vv:
-      execVmacc_vv(di);
-      return;
-
-    case InstId::vmacc_vx:
-      execVmacc_vx(di);
-      return;
-
-    case InstId::vnmsac_vv:
-      execVnmsac_vv(di);
-      return;
-
-    case InstId::vnmsac_vx:
-      execVnmsac_vx(di);
-      return;
-
-    case InstId::vwmulu_vv:
-      execVwmulu_vv(di);
-      return;
-
-    case InstId::vwmulu_vx:
-      execVwmulu_vx(di);
-      return;
-
-    case InstId::vwmul_vv:
-      execVwmul_vv(di);
-      return;
-
-    case InstId::vwmul_vx:
-      execVwmul_vx(di);
-      return;
-
-    case InstId::vwmulsu_vv:
-      execVwmulsu_vv(di);
-      return;
-
-    case InstId::vwmulsu_vx:
-      execVwmulsu_vx(di);
-      return;
-
-    case InstId::vwmaccu_vv:
-      execVwmaccu_vv(di);
-      return;
-
-    case InstId::vwmaccu_vx:
-      execVwmaccu_vx(di);
-      return;
-
-    case InstId::vwmacc_vv:
-      execVwmacc_vv(di);
-      return;
-
-    case InstId::vwmacc_vx:
-      execVwmacc_vx(di);
-      return;
-
-    case InstId::vwmaccsu_vv:
-      execVwmaccsu_vv(di);
-      return;
-
-    case InstId::vwmaccsu_vx:
-      execVwmaccsu_vx(di);
-      return;
-
-    case InstId::vwmaccus_vx:
-      execVwmaccus_vx(di);
-      return;
-
-    case InstId::vdivu_vv:
-      execVdivu_vv(di);
-      return;
-
-    case InstId::vdivu_vx:
-      execVdivu_vx(di);
-      return;
-
-    case InstId::vdiv_vv:
-      execVdiv_vv(di);
-      return;
-
-    case InstId::vdiv_vx:
-      execVdiv_vx(di);
-      return;
-
-    case InstId::vremu_vv:
-      execVremu_vv(di);
-      return;
-
-    case InstId::vremu_vx:
-      execVremu_vx(di);
-      return;
-
-    case InstId::vrem_vv:
-      execVrem_vv(di);
-      return;
-
-    case InstId::vrem_vx:
-      execVrem_vx(di);
-      return;
-
-    case InstId::vsext_vf2:
-      execVsext_vf2(di);
-      return;
-
-    case InstId::vsext_vf4:
-      execVsext_vf4(di);
-      return;
-
-    case InstId::vsext_vf8:
-      execVsext_vf8(di);
-      return;
-
-    case InstId::vzext_vf2:
-      execVzext_vf2(di);
-      return;
-
-    case InstId::vzext_vf4:
-      execVzext_vf4(di);
-      return;
-
-    case InstId::vzext_vf8:
-      execVzext_vf8(di);
-      return;
-
-    case InstId::vadc_vvm:
-      execVadc_vvm(di);
-      return;
-
-    case InstId::vadc_vxm:
-      execVadc_vxm(di);
-      return;
-
-    case InstId::vadc_vim:
-      execVadc_vim(di);
-      return;
-
-    case InstId::vsbc_vvm:
-      execVsbc_vvm(di);
-      return;
-
-    case InstId::vsbc_vxm:
-      execVsbc_vxm(di);
-      return;
-
-    case InstId::vmadc_vvm:
-      execVmadc_vvm(di);
-      return;
-
-    case InstId::vmadc_vxm:
-      execVmadc_vxm(di);
-      return;
-
-    case InstId::vmadc_vim:
-      execVmadc_vim(di);
-      return;
-
-    case InstId::vmsbc_vvm:
-      execVmsbc_vvm(di);
-      return;
-
-    case InstId::vmsbc_vxm:
-      execVmsbc_vxm(di);
-      return;
-
-    case InstId::vmerge_vvm:
-      execVmerge_vvm(di);
-      return;
-
-    case InstId::vmerge_vxm:
-      execVmerge_vxm(di);
-      return;
-
-    case InstId::vmerge_vim:
-      execVmerge_vim(di);
-      return;
-
-    case InstId::vmv_x_s:
-      execVmv_x_s(di);
-      return;
-
-    case InstId::vmv_s_x:
-      execVmv_s_x(di);
-      return;
-
-    case InstId::vfmv_f_s:
-      execVfmv_f_s(di);
-      return;
-
-    case InstId::vfmv_s_f:
-      execVfmv_s_f(di);
-      return;
-
-    case InstId::vmv_v_v:
-      execVmv_v_v(di);
-      return;
-
-    case InstId::vmv_v_x:
-      execVmv_v_x(di);
-      return;
-
-    case InstId::vmv_v_i:
-      execVmv_v_i(di);
-      return;
-
-    case InstId::vmv1r_v:
-      execVmv1r_v(di);
-      return;
-
-    case InstId::vmv2r_v:
-      execVmv2r_v(di);
-      return;
-
-    case InstId::vmv4r_v:
-      execVmv4r_v(di);
-      return;
-
-    case InstId::vmv8r_v:
-      execVmv8r_v(di);
-      return;
-
-    case InstId::vsaddu_vv:
-      execVsaddu_vv(di);
-      return;
-
-    case InstId::vsaddu_vx:
-      execVsaddu_vx(di);
-      return;
-
-    case InstId::vsaddu_vi:
-      execVsaddu_vi(di);
-      return;
-
-    case InstId::vsadd_vv:
-      execVsadd_vv(di);
-      return;
-
-    case InstId::vsadd_vx:
-      execVsadd_vx(di);
-      return;
-
-    case InstId::vsadd_vi:
-      execVsadd_vi(di);
-      return;
-
-    case InstId::vssubu_vv:
-      execVssubu_vv(di);
-      return;
-
-    case InstId::vssubu_vx:
-      execVssubu_vx(di);
-      return;
-
-    case InstId::vssub_vv:
-      execVssub_vv(di);
-      return;
-
-    case InstId::vssub_vx:
-      execVssub_vx(di);
-      return;
-
-    case InstId::vaaddu_vv:
-      execVaaddu_vv(di);
-      return;
-
-    case InstId::vaaddu_vx:
-      execVaaddu_vx(di);
-      return;
-
-    case InstId::vaadd_vv:
-      execVaadd_vv(di);
-      return;
-
-    case InstId::vaadd_vx:
-      execVaadd_vx(di);
-      return;
-
-    case InstId::vasubu_vv:
-      execVasubu_vv(di);
-      return;
-
-    case InstId::vasubu_vx:
-      execVasubu_vx(di);
-      return;
-
-    case InstId::vasub_vv:
-      execVasub_vv(di);
-      return;
-
-    case InstId::vasub_vx:
-      execVasub_vx(di);
-      return;
-
-    case InstId::vsmul_vv:
-      execVsmul_vv(di);
-      return;
-
-    case InstId::vsmul_vx:
-      execVsmul_vx(di);
-      return;
-
-    case InstId::vssrl_vv:
-      execVssrl_vv(di);
-      return;
-
-    case InstId::vssrl_vx:
-      execVssrl_vx(di);
-      return;
-
-    case InstId::vssrl_vi:
-      execVssrl_vi(di);
-      return;
-
-    case InstId::vssra_vv:
-      execVssra_vv(di);
-      return;
-
-    case InstId::vssra_vx:
-      execVssra_vx(di);
-      return;
-
-    case InstId::vssra_vi:
-      execVssra_vi(di);
-      return;
-
-    case InstId::vnclipu_wv:
-      execVnclipu_wv(di);
-      return;
-
-    case InstId::vnclipu_wx:
-      execVnclipu_wx(di);
-      return;
-
-    case InstId::vnclipu_wi:
-      execVnclipu_wi(di);
-      return;
-
-    case InstId::vnclip_wv:
-      execVnclip_wv(di);
-      return;
-
-    case InstId::vnclip_wx:
-      execVnclip_wx(di);
-      return;
-
-    case InstId::vnclip_wi:
-      execVnclip_wi(di);
-      return;
-
-    case InstId::vle8_v:
-      execVle8_v(di);
-      return;
-
-    case InstId::vle16_v:
-      execVle16_v(di);
-      return;
-
-    case InstId::vle32_v:
-      execVle32_v(di);
-      return;
-
-    case InstId::vle64_v:
-      execVle64_v(di);
-      return;
-
-    case InstId::vle128_v:
-      execVle128_v(di);
-      return;
-
-    case InstId::vle256_v:
-      execVle256_v(di);
-      return;
-
-    case InstId::vle512_v:
-      execVle512_v(di);
-      return;
-
-    case InstId::vle1024_v:
-      execVle1024_v(di);
-      return;
-
-    case InstId::vse8_v:
-      execVse8_v(di);
-      return;
-
-    case InstId::vse16_v:
-      execVse16_v(di);
-      return;
-
-    case InstId::vse32_v:
-      execVse32_v(di);
-      return;
-
-    case InstId::vse64_v:
-      execVse64_v(di);
-      return;
-
-    case InstId::vse128_v:
-      execVse128_v(di);
-      return;
-
-    case InstId::vse256_v:
-      execVse256_v(di);
-      return;
-
-    case InstId::vse512_v:
-      execVse512_v(di);
-      return;
-
-    case InstId::vse1024_v:
-      execVse1024_v(di);
-      return;
-
-    case InstId::vlm_v:
-      execVlm_v(di);
-      return;
-
-    case InstId::vsm_v:
-      execVsm_v(di);
-      return;
-
-    case InstId::vlre8_v:
-      execVlre8_v(di);
-      return;
-
-    case InstId::vlre16_v:
-      execVlre16_v(di);
-      return;
-
-    case InstId::vlre32_v:
-      execVlre32_v(di);
-      return;
-
-    case InstId::vlre64_v:
-      execVlre64_v(di);
-      return;
-
-    case InstId::vlre128_v:
-      execVlre128_v(di);
-      return;
-
-    case InstId::vlre256_v:
-      execVlre256_v(di);
-      return;
-
-    case InstId::vlre512_v:
-      execVlre512_v(di);
-      return;
-
-    case InstId::vlre1024_v:
-      execVlre1024_v(di);
-      return;
-
-    case InstId::vs1r_v:
-      execVs1r_v(di);
-      return;
-
-    case InstId::vs2r_v:
-      execVs2r_v(di);
-      return;
-
-    case InstId::vs4r_v:
-      execVs4r_v(di);
-      return;
-
-    case InstId::vs8r_v:
-      execVs8r_v(di);
-      return;
-
-    case InstId::vle8ff_v:
-      execVle8ff_v(di);
-      return;
-
-    case InstId::vle16ff_v:
-      execVle16ff_v(di);
-      return;
-
-    case InstId::vle32ff_v:
-      execVle32ff_v(di);
-      return;
-
-    case InstId::vle64ff_v:
-      execVle64ff_v(di);
-      return;
-
-    case InstId::vle128ff_v:
-      execVle128ff_v(di);
-      return;
-
-    case InstId::vle256ff_v:
-      execVle256ff_v(di);
-      return;
-
-    case InstId::vle512ff_v:
-      execVle512ff_v(di);
-      return;
-
-    case InstId::vle1024ff_v:
-      execVle1024ff_v(di);
-      return;
-
-    case InstId::vlse8_v:
-      execVlse8_v(di);
-      return;
-
-    case InstId::vlse16_v:
-      execVlse16_v(di);
-      return;
-
-    case InstId::vlse32_v:
-      execVlse32_v(di);
-      return;
-
-    case InstId::vlse64_v:
-      execVlse64_v(di);
-      return;
-
-    case InstId::vlse128_v:
-      execVlse128_v(di);
-      return;
-
-    case InstId::vlse256_v:
-      execVlse256_v(di);
-      return;
-
-    case InstId::vlse512_v:
-      execVlse512_v(di);
-      return;
-
-    case InstId::vlse1024_v:
-      execVlse1024_v(di);
-      return;
-
-    case InstId::vsse8_v:
-      execVsse8_v(di);
-      return;
-
-    case InstId::vsse16_v:
-      execVsse16_v(di);
-      return;
-
-    case InstId::vsse32_v:
-      execVsse32_v(di);
-      return;
-
-    case InstId::vsse64_v:
-      execVsse64_v(di);
-      return;
-
-    case InstId::vsse128_v:
-      execVsse128_v(di);
-      return;
-
-    case InstId::vsse256_v:
-      execVsse256_v(di);
-      return;
-
-    case InstId::vsse512_v:
-      execVsse512_v(di);
-      return;
-
-    case InstId::vsse1024_v:
-      execVsse1024_v(di);
-      return;
-
-    case InstId::vloxei8_v:
-      execVloxei8_v(di);
-      return;
-
-    case InstId::vloxei16_v:
-      execVloxei16_v(di);
-      return;
-
-    case InstId::vloxei32_v:
-      execVloxei32_v(di);
-      return;
-
-    case InstId::vloxei64_v:
-      execVloxei64_v(di);
-      return;
-
-    case InstId::vloxei128_v:
-      execVloxei128_v(di);
-      return;
-
-    case InstId::vloxei256_v:
-      execVloxei256_v(di);
-      return;
-
-    case InstId::vloxei512_v:
-      execVloxei512_v(di);
-      return;
-
-    case InstId::vloxei1024_v:
-      execVloxei1024_v(di);
-      return;
-
-    case InstId::vluxei8_v:
-      execVluxei8_v(di);
-      return;
-
-    case InstId::vluxei16_v:
-      execVluxei16_v(di);
-      return;
-
-    case InstId::vluxei32_v:
-      execVluxei32_v(di);
-      return;
-
-    case InstId::vluxei64_v:
-      execVluxei64_v(di);
-      return;
-
-    case InstId::vluxei128_v:
-      execVluxei128_v(di);
-      return;
-
-    case InstId::vluxei256_v:
-      execVluxei256_v(di);
-      return;
-
-    case InstId::vluxei512_v:
-      execVluxei512_v(di);
-      return;
-
-    case InstId::vluxei1024_v:
-      execVluxei1024_v(di);
-      return;
-
-    case InstId::vsoxei8_v:
-      execVsoxei8_v(di);
-      return;
-
-    case InstId::vsoxei16_v:
-      execVsoxei16_v(di);
-      return;
-
-    case InstId::vsoxei32_v:
-      execVsoxei32_v(di);
-      return;
-
-    case InstId::vsoxei64_v:
-      execVsoxei64_v(di);
-      return;
-
-    case InstId::vsoxei128_v:
-      execVsoxei128_v(di);
-      return;
-
-    case InstId::vsoxei256_v:
-      execVsoxei256_v(di);
-      return;
-
-    case InstId::vsoxei512_v:
-      execVsoxei512_v(di);
-      return;
-
-    case InstId::vsoxei1024_v:
-      execVsoxei1024_v(di);
-      return;
-
-    case InstId::vsuxei8_v:
-      execVsuxei8_v(di);
-      return;
-
-    case InstId::vsuxei16_v:
-      execVsuxei16_v(di);
-      return;
-
-    case InstId::vsuxei32_v:
-      execVsuxei32_v(di);
-      return;
-
-    case InstId::vsuxei64_v:
-      execVsuxei64_v(di);
-      return;
-
-    case InstId::vsuxei128_v:
-      execVsuxei128_v(di);
-      return;
-
-    case InstId::vsuxei256_v:
-      execVsuxei256_v(di);
-      return;
-
-    case InstId::vsuxei512_v:
-      execVsuxei512_v(di);
-      return;
-
-    case InstId::vsuxei1024_v:
-      execVsuxei1024_v(di);
-      return;
-
-    case InstId::vlsege8_v:
-      execVlsege8_v(di);
-      return;
-
-    case InstId::vlsege16_v:
-      execVlsege16_v(di);
-      return;
-
-    case InstId::vlsege32_v:
-      execVlsege32_v(di);
-      return;
-
-    case InstId::vlsege64_v:
-      execVlsege64_v(di);
-      return;
-
-    case InstId::vlsege128_v:
-      execVlsege128_v(di);
-      return;
-
-    case InstId::vlsege256_v:
-      execVlsege256_v(di);
-      return;
-
-    case InstId::vlsege512_v:
-      execVlsege512_v(di);
-      return;
-
-    case InstId::vlsege1024_v:
-      execVlsege1024_v(di);
-      return;
-
-    case InstId::vssege8_v:
-      execVssege8_v(di);
-      return;
-
-    case InstId::vssege16_v:
-      execVssege16_v(di);
-      return;
-
-    case InstId::vssege32_v:
-      execVssege32_v(di);
-      return;
-
-    case InstId::vssege64_v:
-      execVssege64_v(di);
-      return;
-
-    case InstId::vssege128_v:
-      execVssege128_v(di);
-      return;
-
-    case InstId::vssege256_v:
-      execVssege256_v(di);
-      return;
-
-    case InstId::vssege512_v:
-      execVssege512_v(di);
-      return;
-
-    case InstId::vssege1024_v:
-      execVssege1024_v(di);
-      return;
-
-    case InstId::vlssege8_v:
-      execVlssege8_v(di);
-      return;
-
-    case InstId::vlssege16_v:
-      execVlssege16_v(di);
-      return;
-
-    case InstId::vlssege32_v:
-      execVlssege32_v(di);
-      return;
-
-    case InstId::vlssege64_v:
-      execVlssege64_v(di);
-      return;
-
-    case InstId::vlssege128_v:
-      execVlssege128_v(di);
-      return;
-
-    case InstId::vlssege256_v:
-      execVlssege256_v(di);
-      return;
-
-    case InstId::vlssege512_v:
-      execVlssege512_v(di);
-      return;
-
-    case InstId::vlssege1024_v:
-      execVlssege1024_v(di);
-      return;
-
-    case InstId::vsssege8_v:
-      execVsssege8_v(di);
-      return;
-
-    case InstId::vsssege16_v:
-      execVsssege16_v(di);
-      return;
-
-    case InstId::vsssege32_v:
-      execVsssege32_v(di);
-      return;
-
-    case InstId::vsssege64_v:
-      execVsssege64_v(di);
-      return;
-
-    case InstId::vsssege128_v:
-      execVsssege128_v(di);
-      return;
-
-    case InstId::vsssege256_v:
-      execVsssege256_v(di);
-      return;
-
-    case InstId::vsssege512_v:
-      execVsssege512_v(di);
-      return;
-
-    case InstId::vsssege1024_v:
-      execVsssege1024_v(di);
-      return;
-
-    case InstId::vluxsegei8_v:
-      execVluxsegei8_v(di);
-      return;
-
-    case InstId::vluxsegei16_v:
-      execVluxsegei16_v(di);
-      return;
-
-    case InstId::vluxsegei32_v:
-      execVluxsegei32_v(di);
-      return;
-
-    case InstId::vluxsegei64_v:
-      execVluxsegei64_v(di);
-      return;
-
-    case InstId::vluxsegei128_v:
-      execVluxsegei128_v(di);
-      return;
-
-    case InstId::vluxsegei256_v:
-      execVluxsegei256_v(di);
-      return;
-
-    case InstId::vluxsegei512_v:
-      execVluxsegei512_v(di);
-      return;
-
-    case InstId::vluxsegei1024_v:
-      execVluxsegei1024_v(di);
-      return;
-
-    case InstId::vsuxsegei8_v:
-      execVsuxsegei8_v(di);
-      return;
-
-    case InstId::vsuxsegei16_v:
-      execVsuxsegei16_v(di);
-      return;
-
-    case InstId::vsuxsegei32_v:
-      execVsuxsegei32_v(di);
-      return;
-
-    case InstId::vsuxsegei64_v:
-      execVsuxsegei64_v(di);
-      return;
-
-    case InstId::vsuxsegei128_v:
-      execVsuxsegei128_v(di);
-      return;
-
-    case InstId::vsuxsegei256_v:
-      execVsuxsegei256_v(di);
-      return;
-
-    case InstId::vsuxsegei512_v:
-      execVsuxsegei512_v(di);
-      return;
-
-    case InstId::vsuxsegei1024_v:
-      execVsuxsegei1024_v(di);
-      return;
-
-    case InstId::vloxsegei8_v:
-      execVloxsegei8_v(di);
-      return;
-
-    case InstId::vloxsegei16_v:
-      execVloxsegei16_v(di);
-      return;
-
-    case InstId::vloxsegei32_v:
-      execVloxsegei32_v(di);
-      return;
-
-    case InstId::vloxsegei64_v:
-      execVloxsegei64_v(di);
-      return;
-
-    case InstId::vloxsegei128_v:
-      execVloxsegei128_v(di);
-      return;
-
-    case InstId::vloxsegei256_v:
-      execVloxsegei256_v(di);
-      return;
-
-    case InstId::vloxsegei512_v:
-      execVloxsegei512_v(di);
-      return;
-
-    case InstId::vloxsegei1024_v:
-      execVloxsegei1024_v(di);
-      return;
-
-    case InstId::vsoxsegei8_v:
-      execVsoxsegei8_v(di);
-      return;
-
-    case InstId::vsoxsegei16_v:
-      execVsoxsegei16_v(di);
-      return;
-
-    case InstId::vsoxsegei32_v:
-      execVsoxsegei32_v(di);
-      return;
-
-    case InstId::vsoxsegei64_v:
-      execVsoxsegei64_v(di);
-      return;
-
-    case InstId::vsoxsegei128_v:
-      execVsoxsegei128_v(di);
-      return;
-
-    case InstId::vsoxsegei256_v:
-      execVsoxsegei256_v(di);
-      return;
-
-    case InstId::vsoxsegei512_v:
-      execVsoxsegei512_v(di);
-      return;
-
-    case InstId::vsoxsegei1024_v:
-      execVsoxsegei1024_v(di);
-      return;
-
-    case InstId::vlsege8ff_v:
-      execVlsege8ff_v(di);
-      return;
-
-    case InstId::vlsege16ff_v:
-      execVlsege16ff_v(di);
-      return;
-
-    case InstId::vlsege32ff_v:
-      execVlsege32ff_v(di);
-      return;
-
-    case InstId::vlsege64ff_v:
-      execVlsege64ff_v(di);
-      return;
-
-    case InstId::vlsege128ff_v:
-      execVlsege128ff_v(di);
-      return;
-
-    case InstId::vlsege256ff_v:
-      execVlsege256ff_v(di);
-      return;
-
-    case InstId::vlsege512ff_v:
-      execVlsege512ff_v(di);
-      return;
-
-    case InstId::vlsege1024ff_v:
-      execVlsege1024ff_v(di);
-      return;
-
-    case InstId::vfadd_vv:
-      execVfadd_vv(di);
-      return;
-
-    case InstId::vfadd_vf:
-      execVfadd_vf(di);
-      return;
-
-    case InstId::vfsub_vv:
-      execVfsub_vv(di);
-      return;
-
-    case InstId::vfsub_vf:
-      execVfsub_vf(di);
-      return;
-
-    case InstId::vfrsub_vf:
-      execVfrsub_vf(di);
-      return;
-
-    case InstId::vfwadd_vv:
-      execVfwadd_vv(di);
-      return;
-
-    case InstId::vfwadd_vf:
-      execVfwadd_vf(di);
-      return;
-
-    case InstId::vfwsub_vv:
-      execVfwsub_vv(di);
-      return;
-
-    case InstId::vfwsub_vf:
-      execVfwsub_vf(di);
-      return;
-
-    case InstId::vfwadd_wv:
-      execVfwadd_wv(di);
-      return;
-
-    case InstId::vfwadd_wf:
-      execVfwadd_wf(di);
-      return;
-
-    case InstId::vfwsub_wv:
-      execVfwsub_wv(di);
-      return;
-
-    case InstId::vfwsub_wf:
-      execVfwsub_wf(di);
-      return;
-
-    case InstId::vfmul_vv:
-      execVfmul_vv(di);
-      return;
-
-    case InstId::vfmul_vf:
-      execVfmul_vf(di);
-      return;
-
-    case InstId::vfdiv_vv:
-      execVfdiv_vv(di);
-      return;
-
-    case InstId::vfdiv_vf:
-      execVfdiv_vf(di);
-      return;
-
-    case InstId::vfrdiv_vf:
-      execVfrdiv_vf(di);
-      return;
-
-    case InstId::vfwmul_vv:
-      execVfwmul_vv(di);
-      return;
-
-    case InstId::vfwmul_vf:
-      execVfwmul_vf(di);
-      return;
-
-    case InstId::vfmadd_vv:
-      execVfmadd_vv(di);
-      return;
-
-    case InstId::vfmadd_vf:
-      execVfmadd_vf(di);
-      return;
-
-    case InstId::vfnmadd_vv:
-      execVfnmadd_vv(di);
-      return;
-
-    case InstId::vfnmadd_vf:
-      execVfnmadd_vf(di);
-      return;
-
-    case InstId::vfmsub_vv:
-      execVfmsub_vv(di);
-      return;
-
-    case InstId::vfmsub_vf:
-      execVfmsub_vf(di);
-      return;
-
-    case InstId::vfnmsub_vv:
-      execVfnmsub_vv(di);
-      return;
-
-    case InstId::vfnmsub_vf:
-      execVfnmsub_vf(di);
-      return;
-
-    case InstId::vfmacc_vv:
-      execVfmacc_vv(di);
-      return;
-
-    case InstId::vfmacc_vf:
-      execVfmacc_vf(di);
-      return;
-
-    case InstId::vfnmacc_vv:
-      execVfnmacc_vv(di);
-      return;
-
-    case InstId::vfnmacc_vf:
-      execVfnmacc_vf(di);
-      return;
-
-    case InstId::vfmsac_vv:
-      execVfmsac_vv(di);
-      return;
-
-    case InstId::vfmsac_vf:
-      execVfmsac_vf(di);
-      return;
-
-    case InstId::vfnmsac_vv:
-      execVfnmsac_vv(di);
-      return;
-
-    case InstId::vfnmsac_vf:
-      execVfnmsac_vf(di);
-      return;
-
-    case InstId::vfwmacc_vv:
-      execVfwmacc_vv(di);
-      return;
-
-    case InstId::vfwmacc_vf:
-      execVfwmacc_vf(di);
-      return;
-
-    case InstId::vfwnmacc_vv:
-      execVfwnmacc_vv(di);
-      return;
-
-    case InstId::vfwnmacc_vf:
-      execVfwnmacc_vf(di);
-      return;
-
-    case InstId::vfwmsac_vv:
-      execVfwmsac_vv(di);
-      return;
-
-    case InstId::vfwmsac_vf:
-      execVfwmsac_vf(di);
-      return;
-
-    case InstId::vfwnmsac_vv:
-      execVfwnmsac_vv(di);
-      return;
-
-    case InstId::vfwnmsac_vf:
-      execVfwnmsac_vf(di);
-      return;
-
-    case InstId::vfsqrt_v:
-      execVfsqrt_v(di);
-      return;
-
-    case InstId::vfmerge_vfm:
-      execVfmerge_vfm(di);
-      return;
-
-    case InstId::vfmv_v_f:
-      execVfmv_v_f(di);
-      return;
-
-    case InstId::vmfeq_vv:
-      execVmfeq_vv(di);
-      return;
-
-    case InstId::vmfeq_vf:
-      execVmfeq_vf(di);
-      return;
-
-    case InstId::vmfne_vv:
-      execVmfne_vv(di);
-      return;
-
-    case InstId::vmfne_vf:
-      execVmfne_vf(di);
-      return;
-
-    case InstId::vmflt_vv:
-      execVmflt_vv(di);
-      return;
-
-    case InstId::vmflt_vf:
-      execVmflt_vf(di);
-      return;
-
-    case InstId::vmfle_vv:
-      execVmfle_vv(di);
-      return;
-
-    case InstId::vmfle_vf:
-      execVmfle_vf(di);
-      return;
-
-    case InstId::vmfgt_vf:
-      execVmfgt_vf(di);
-      return;
-
-    case InstId::vmfge_vf:
-      execVmfge_vf(di);
-      return;
-
-    case InstId::vfclass_v:
-      execVfclass_v(di);
-      return;
-
-    case InstId::vfcvt_xu_f_v:
-      execVfcvt_xu_f_v(di);
-      return;
-
-    case InstId::vfcvt_x_f_v:
-      execVfcvt_x_f_v(di);
-      return;
-
-    case InstId::vfcvt_rtz_xu_f_v:
-      execVfcvt_rtz_xu_f_v(di);
-      return;
-
-    case InstId::vfcvt_rtz_x_f_v:
-      execVfcvt_rtz_x_f_v(di);
-      return;
-
-    case InstId::vfcvt_f_xu_v:
-      execVfcvt_f_xu_v(di);
-      return;
-
-    case InstId::vfcvt_f_x_v:
-      execVfcvt_f_x_v(di);
-      return;
-
-    case InstId::vfwcvt_xu_f_v:
-      execVfwcvt_xu_f_v(di);
-      return;
-
-    case InstId::vfwcvt_x_f_v:
-      execVfwcvt_x_f_v(di);
-      return;
-
-    case InstId::vfwcvt_rtz_xu_f_v:
-      execVfwcvt_rtz_xu_f_v(di);
-      return;
-
-    case InstId::vfwcvt_rtz_x_f_v:
-      execVfwcvt_rtz_x_f_v(di);
-      return;
-
-    case InstId::vfwcvt_f_xu_v:
-      execVfwcvt_f_xu_v(di);
-      return;
-
-    case InstId::vfwcvt_f_x_v:
-      execVfwcvt_f_x_v(di);
-      return;
-
-    case InstId::vfwcvt_f_f_v:
-      execVfwcvt_f_f_v(di);
-      return;
-
-    case InstId::vfncvt_xu_f_w:
-      execVfncvt_xu_f_w(di);
-      return;
-
-    case InstId::vfncvt_x_f_w:
-      execVfncvt_x_f_w(di);
-      return;
-
-    case InstId::vfncvt_rtz_xu_f_w:
-      execVfncvt_rtz_xu_f_w(di);
-      return;
-
-    case InstId::vfncvt_rtz_x_f_w:
-      execVfncvt_rtz_x_f_w(di);
-      return;
-
-    case InstId::vfncvt_f_xu_w:
-      execVfncvt_f_xu_w(di);
-      return;
-
-    case InstId::vfncvt_f_x_w:
-      execVfncvt_f_x_w(di);
-      return;
-
-    case InstId::vfncvt_f_f_w:
-      execVfncvt_f_f_w(di);
-      return;
-
-    case InstId::vfncvt_rod_f_f_w:
-      execVfncvt_rod_f_f_w(di);
-      return;
-
-    case InstId::vfredusum_vs:
-      execVfredusum_vs(di);
-      return;
-
-    case InstId::vfredosum_vs:
-      execVfredosum_vs(di);
-      return;
-
-    case InstId::vfredmin_vs:
-      execVfredmin_vs(di);
-      return;
-
-    case InstId::vfredmax_vs:
-      execVfredmax_vs(di);
-      return;
-
-    case InstId::vfwredusum_vs:
-      execVfwredusum_vs(di);
-      return;
-
-    case InstId::vfwredosum_vs:
-      execVfwredosum_vs(di);
-      return;
-
-    case InstId::vfrsqrt7_v:
-      execVfrsqrt7_v(di);
-      return;
-
-    case InstId::vfrec7_v:
-      execVfrec7_v(di);
-      return;
-
-    case InstId::vfmin_vv:
-      execVfmin_vv(di);
-      return;
-
-    case InstId::vfmin_vf:
-      execVfmin_vf(di);
-      return;
-
-    case InstId::vfmax_vv:
-      execVfmax_vv(di);
-      return;
-
-    case InstId::vfmax_vf:
-      execVfmax_vf(di);
-      return;
-
-    case InstId::vfsgnj_vv:
-      execVfsgnj_vv(di);
-      return;
-
-    case InstId::vfsgnj_vf:
-      execVfsgnj_vf(di);
-      return;
-
-    case InstId::vfsgnjn_vv:
-      execVfsgnjn_vv(di);
-      return;
-
-    case InstId::vfsgnjn_vf:
-      execVfsgnjn_vf(di);
-      return;
-
-    case InstId::vfsgnjx_vv:
-      execVfsgnjx_vv(di);
-      return;
-
-    case InstId::vfsgnjx_vf:
-      execVfsgnjx_vf(di);
-      return;
-
-    case InstId::vandn_vv:
-      execVandn_vv(di);
-      return;
-
-    case InstId::vandn_vx:
-      execVandn_vx(di);
-      return;
-
-    case InstId::vbrev_v:
-      execVbrev_v(di);
-      return;
-
-    case InstId::vbrev8_v:
-      execVbrev8_v(di);
-      return;
-
-    case InstId::vrev8_v:
-      execVrev8_v(di);
-      return;
-
-    case InstId::vclz_v:
-      execVclz_v(di);
-      return;
-
-    case InstId::vctz_v:
-      execVctz_v(di);
-      return;
-
-    case InstId::vcpop_v:
-      execVcpop_v(di);
-      return;
-
-    case InstId::vrol_vv:
-      execVrol_vv(di);
-      return;
-
-    case InstId::vrol_vx:
-      execVrol_vx(di);
-      return;
-
-    case InstId::vror_vv:
-      execVror_vv(di);
-      return;
-
-    case InstId::vror_vx:
-      execVror_vx(di);
-      return;
-
-    case InstId::vror_vi:
-      execVror_vi(di);
-      return;
-
-    case InstId::vwsll_vv:
-      execVwsll_vv(di);
-      return;
-
-    case InstId::vwsll_vx:
-      execVwsll_vx(di);
-      return;
-
-    case InstId::vwsll_vi:
-      execVwsll_vi(di);
-      return;
-
-    case InstId::vfncvtbf16_f_f_w:
-      execVfncvtbf16_f_f_w(di);
-      return;
-
-    case InstId::vfwcvtbf16_f_f_v:
-      execVfwcvtbf16_f_f_v(di);
-      return;
-
-    case InstId::vfwmaccbf16_vv:
-      execVfwmaccbf16_vv(di);
-      return;
-
-    case InstId::vfwmaccbf16_vf:
-      execVfwmaccbf16_vf(di);
-      return;
-
-    case InstId::vfncvtbf16_sat_f_f_w:
-      execVfncvtbf16_sat_f_f_w(di);
-      return;
-
-    case InstId::vfncvt_f_f_q:
-      execVfncvt_f_f_q(di);
-      return;
-
-    case InstId::vfncvt_sat_f_f_q:
-      execVfncvt_sat_f_f_q(di);
-      return;
-
-    case InstId::vclmul_vv:
-      execVclmul_vv(di);
-      return;
-
-    case InstId::vclmul_vx:
-      execVclmul_vx(di);
-      return;
-
-    case InstId::vclmulh_vv:
-      execVclmulh_vv(di);
-      return;
-
-    case InstId::vclmulh_vx:
-      execVclmulh_vx(di);
-      return;
-
-    case InstId::vghsh_vv:
-      execVghsh_vv(di);
-      return;
-
-    case InstId::vgmul_vv:
-      execVgmul_vv(di);
-      return;
-
-    case InstId::vaesdf_vv:
-      execVaesdf_vv(di);
-      return;
-
-    case InstId::vaesdf_vs:
-      execVaesdf_vs(di);
-      return;
-
-    case InstId::vaesef_vv:
-      execVaesef_vv(di);
-      return;
-
-    case InstId::vaesef_vs:
-      execVaesef_vs(di);
-      return;
-
-    case InstId::vaesem_vv:
-      execVaesem_vv(di);
-      return;
-
-    case InstId::vaesem_vs:
-      execVaesem_vs(di);
-      return;
-
-    case InstId::vaesdm_vv:
-      execVaesdm_vv(di);
-      return;
-
-    case InstId::vaesdm_vs:
-      execVaesdm_vs(di);
-      return;
-
-    case InstId::vaeskf1_vi:
-      execVaeskf1_vi(di);
-      return;
-
-    case InstId::vaeskf2_vi:
-      execVaeskf2_vi(di);
-      return;
-
-    case InstId::vaesz_vs:
-      execVaesz_vs(di);
-      return;
-
-    case InstId::vsha2ms_vv:
-      execVsha2ms_vv(di);
-      return;
-
-    case InstId::vsha2ch_vv:
-      execVsha2ch_vv(di);
-      return;
-
-    case InstId::vsha2cl_vv:
-      execVsha2cl_vv(di);
-      return;
-
-    case InstId::vsm4k_vi:
-      execVsm4k_vi(di);
-      return;
-
-    case InstId::vsm4r_vv:
-      execVsm4r_vv(di);
-      return;
-
-    case InstId::vsm4r_vs:
-      execVsm4r_vs(di);
-      return;
-
-    case InstId::vsm3me_vv:
-      execVsm3me_vv(di);
-      return;
-
-    case InstId::vsm3c_vi:
-      execVsm3c_vi(di);
-      return;
-
-    case InstId::aes32dsi:
-      execAes32dsi(di);
-      return;
-
-    case InstId::aes32dsmi:
-      execAes32dsmi(di);
-      return;
-
-    case InstId::aes32esi:
-      execAes32esi(di);
-      return;
-
-    case InstId::aes32esmi:
-      execAes32esmi(di);
-      return;
-
-    case InstId::aes64ds:
-      execAes64ds(di);
-      return;
-
-    case InstId::aes64dsm:
-      execAes64dsm(di);
-      return;
-
-    case InstId::aes64es:
-      execAes64es(di);
-      return;
-
-    case InstId::aes64esm:
-      execAes64esm(di);
-      return;
-
-    case InstId::aes64im:
-      execAes64im(di);
-      return;
-
-    case InstId::aes64ks1i:
-      execAes64ks1i(di);
-      return;
-
-    case InstId::aes64ks2:
-      execAes64ks2(di);
-      return;
-
-    case InstId::sha256sig0:
-      execSha256sig0(di);
-      return;
-
-    case InstId::sha256sig1:
-      execSha256sig1(di);
-      return;
-
-    case InstId::sha256sum0:
-      execSha256sum0(di);
-      return;
-
-    case InstId::sha256sum1:
-      execSha256sum1(di);
-      return;
-
-    case InstId::sha512sig0h:
-      execSha512sig0h(di);
-      return;
-
-    case InstId::sha512sig0l:
-      execSha512sig0l(di);
-      return;
-
-    case InstId::sha512sig1h:
-      execSha512sig1h(di);
-      return;
-
-    case InstId::sha512sig1l:
-      execSha512sig1l(di);
-      return;
-
-    case InstId::sha512sum0r:
-      execSha512sum0r(di);
-      return;
-
-    case InstId::sha512sum1r:
-      execSha512sum1r(di);
-      return;
-
-    case InstId::sha512sig0:
-      execSha512sig0(di);
-      return;
-
-    case InstId::sha512sig1:
-      execSha512sig1(di);
-      return;
-
-    case InstId::sha512sum0:
-      execSha512sum0(di);
-      return;
-
-    case InstId::sha512sum1:
-      execSha512sum1(di);
-      return;
-
-    case InstId::sm3p0:
-      execSm3p0(di);
-      return;
-
-    case InstId::sm3p1:
-      execSm3p1(di);
-      return;
-
-    case InstId::sm4ed:
-      execSm4ed(di);
-      return;
-
-    case InstId::sm4ks:
-      execSm4ks(di);
-      return;
-
-    case InstId::vqdot_vv:
-      execVqdot_vv(di);
-      return;
-
-    case InstId::vqdot_vx:
-      execVqdot_vx(di);
-      return;
-
-    case InstId::vqdotu_vv:
-      execVqdotu_vv(di);
-      return;
-
-    case InstId::vqdotu_vx:
-      execVqdotu_vx(di);
-      return;
-
-    case InstId::vqdotsu_vv:
-      execVqdotsu_vv(di);
-      return;
-
-    case InstId::vqdotsu_vx:
-      execVqdotsu_vx(di);
-      return;
-
-    case InstId::vqdotus_vx:
-      execVqdotus_vx(di);
-      return;
-
-    case InstId::vzip_vv:
-      execVzip_vv(di);
-      return;
-
-    case InstId::vunzipe_v:
-      execVunzipe_v(di);
-      return;
-
-    case InstId::vunzipo_v:
-      execVunzipo_v(di);
-      return;
-
-    case InstId::vpaire_vv:
-      execVpaire_vv(di);
-      return;
-
-    case InstId::vpairo_vv:
-      execVpairo_vv(di);
-      return;
-
-    case InstId::vabs_v:
-      execVabs_v(di);
-      return;
-
-    case InstId::vabd_vv:
-      execVabd_vv(di);
-      return;
-
-    case InstId::vabdu_vv:
-      execVabdu_vv(di);
-      return;
-
-    case InstId::vwabda_vv:
-      execVwabda_vv(di);
-      return;
-
-    case InstId::vwabdau_vv:
-      execVwabdau_vv(di);
-      return;
-
-    case InstId::sinval_vma:
-      execSinval_vma(di);
-      return;
-
-    case InstId::sfence_w_inval:
-      execSfence_w_inval(di);
-      return;
-
-    case InstId::sfence_inval_ir:
-      execSfence_inval_ir(di);
-      return;
-
-    case InstId::cbo_clean:
-      execCbo_clean(di);
-      return;
-
-    case InstId::cbo_flush:
-      execCbo_flush(di);
-      return;
-
-    case InstId::cbo_inval:
-      execCbo_inval(di);
-      return;
-
-    case InstId::cbo_zero:
-      execCbo_zero(di);
-      return;
-
-    case InstId::prefetch_i:
-      execPrefetch_i(di);
-      return;
-
-    case InstId::prefetch_r:
-      execPrefetch_r(di);
-      return;
-
-    case InstId::prefetch_w:
-      execPrefetch_w(di);
-      return;
-
-    case InstId::wrs_nto:
-      execWrs_nto(di);
-      return;
-
-    case InstId::wrs_sto:
-      execWrs_sto(di);
-      return;
-
-    case InstId::hfence_vvma:
-      execHfence_vvma(di);
-      return;
-
-    case InstId::hfence_gvma:
-      execHfence_gvma(di);
-      return;
-
-    case InstId::hlv_b:
-      execHlv_b(di);
-      return;
-
-    case InstId::hlv_bu:
-      execHlv_bu(di);
-      return;
-
-    case InstId::hlv_h:
-      execHlv_h(di);
-      return;
-
-    case InstId::hlv_hu:
-      execHlv_hu(di);
-      return;
-
-    case InstId::hlv_w:
-      execHlv_w(di);
-      return;
-
-    case InstId::hlvx_hu:
-      execHlvx_hu(di);
-      return;
-
-    case InstId::hlvx_wu:
-      execHlvx_wu(di);
-      return;
-
-    case InstId::hsv_b:
-      execHsv_b(di);
-      return;
-
-    case InstId::hsv_h:
-      execHsv_h(di);
-      return;
-
-    case InstId::hsv_w:
-      execHsv_w(di);
-      return;
-
-    case InstId::hlv_wu:
-      execHlv_wu(di);
-      return;
-
-    case InstId::hlv_d:
-      execHlv_d(di);
-      return;
-
-    case InstId::hsv_d:
-      execHsv_d(di);
-      return;
-
-    case InstId::hinval_vvma:
-      execHinval_vvma(di);
-      return;
-
-    case InstId::hinval_gvma:
-      execHinval_gvma(di);
-      return;
-
-    case InstId::czero_eqz:
-      execCzero_eqz(di);
-      return;
-
-    case InstId::czero_nez:
-      execCzero_nez(di);
-      return;
-
-    case InstId::c_lbu:
-      if (isRvzca() and isRvzcb()) execLbu(di); else illegalInst(di);
-      return;
-
-    case InstId::c_lhu:
-      if (isRvzca() and isRvzcb()) execLhu(di); else illegalInst(di);
-      return;
-
-    case InstId::c_lh:
-      if (isRvzca() and isRvzcb()) execLh(di); else illegalInst(di);
-      return;
-
-    case InstId::c_sb:
-      if (isRvzca() and isRvzcb()) execSb(di); else illegalInst(di);
-      return;
-
-    case InstId::c_sh:
-      if (isRvzca() and isRvzcb()) execSh(di); else illegalInst(di);
-      return;
-
-    case InstId::c_zext_b:
-      if (isRvzca() and isRvzcb()) execAndi(di); else illegalInst(di);
-      return;
-
-    case InstId::c_sext_b:
-      if (isRvzca() and isRvzcb()) execSext_b(di); else illegalInst(di);
-      return;
-
-    case InstId::c_zext_h:
-      if (isRvzca() and isRvzcb()) execC_zext_h(di); else illegalInst(di);
-      return;
-
-    case InstId::c_sext_h:
-      if (isRvzca() and isRvzcb()) execSext_h(di); else illegalInst(di);
-      return;
-
-    case InstId::c_zext_w:
-      if (isRvzca() and isRvzcb()) execAdd_uw(di); else illegalInst(di);
-      return;
-
-    case InstId::c_not:
-      if (isRvzca() and isRvzcb()) execXori(di);  else illegalInst(di);
-      return;
-
-    case InstId::c_mul:
-      if (isRvzca() and isRvzcb()) execMul(di); else illegalInst(di);
-      return;
-
-    // Zfa
-    case InstId::fcvtmod_w_d:
-      execFcvtmod_w_d(di);
-      return;
-
-    case InstId::fli_h:
-      execFli_h(di);
-      return;
-
-    case InstId::fli_s:
-      execFli_s(di);
-      return;
-
-    case InstId::fli_d:
-      execFli_d(di);
-      return;
-
-    case InstId::fleq_h:
-      execFleq_h(di);
-      return;
-
-    case InstId::fleq_s:
-      execFleq_s(di);
-      return;
-
-    case InstId::fleq_d:
-      execFleq_d(di);
-      return;
-
-    case InstId::fltq_h:
-      execFltq_h(di);
-      return;
-
-    case InstId::fltq_s:
-      execFltq_s(di);
-      return;
-
-    case InstId::fltq_d:
-      execFltq_d(di);
-      return;
-
-    case InstId::fmaxm_h:
-      execFmaxm_h(di);
-      return;
-
-    case InstId::fmaxm_s:
-      execFmaxm_s(di);
-      return;
-
-    case InstId::fmaxm_d:
-      execFmaxm_d(di);
-      return;
-
-    case InstId::fminm_h:
-      execFminm_h(di);
-      return;
-
-    case InstId::fminm_s:
-      execFminm_s(di);
-      return;
-
-    case InstId::fminm_d:
-      execFminm_d(di);
-      return;
-
-    case InstId::fmvh_x_d:
-      execFmvh_x_d(di);
-      return;
-
-    case InstId::fmvp_d_x:
-      execFmvp_d_x(di);
-      return;
-
-    case InstId::fround_h:
-      execFround_h(di);
-      return;
-
-    case InstId::fround_s:
-      execFround_s(di);
-      return;
-
-    case InstId::fround_d:
-      execFround_d(di);
-      return;
-
-    case InstId::froundnx_h:
-      execFroundnx_h(di);
-      return;
-
-    case InstId::froundnx_s:
-      execFroundnx_s(di);
-      return;
-
-    case InstId::froundnx_d:
-      execFroundnx_d(di);
-      return;
-
-    case InstId::amocas_w:
-      execAmocas_w(di);
-      return;
-
-    case InstId::amocas_d:
-      execAmocas_d(di);
-      return;
-
-    case InstId::amocas_q:
-      execAmocas_q(di);
-      return;
-
-    case InstId::mop_r:
-      execMop_r(di);
-      return;
-
-    case InstId::mop_rr:
-      execMop_rr(di);
-      return;
-
-    case InstId::c_mop:
-      execCmop(di);
-      return;
-
-    case InstId::ssamoswap_w:
-      execSsamoswap_w(di);
-      return;
-
-    case InstId::ssamoswap_d:
-      execSsamoswap_d(di);
-      return;
-
-    case InstId::mcspspush:
-      execMcspspush(di);
-      return;
-
-    case InstId::mcspspop:
-      execMcspspop(di);
-      return;
-
-    case InstId::scspspush:
-      execScspspush(di);
-      return;
-
-    case InstId::scspspop:
-      execScspspop(di);
-      return;
-
-    case InstId::mipopret:
-      execMipopret(di);
-      return;
-
-    case InstId::sipopret:
-      execSipopret(di);
-      return;
-
-    case InstId::vqwdotau_vv:
-      execVqwdotau_vv(di);
-      return;
-
-    case InstId::vqwdotas_vv:
-      execVqwdotas_vv(di);
-      return;
-
-    case InstId::vqwbdotau_vv:
-      execVqwbdotau_vv(di);
-      return;
-
-    case InstId::vqwbdotas_vv:
-      execVqwbdotas_vv(di);
-      return;
-
-    case InstId::vfbdota_vv:
-      execVfbdota_vv(di);
-      return;
-
-    case InstId::vfwdota_vv:
-      execVfwdota_vv(di);
-      return;
-
-    case InstId::vfqwdota_vv:
-      execVfqwdota_vv(di);
-      return;
-
-    case InstId::vfqwbdota_vv:
-      execVfqwbdota_vv(di);
-      return;
-
-    case InstId::vfwbdota_vv:
-      execVfwbdota_vv(di);
-      return;
-
-    case InstId::endId_:
-      assert(0 && "Error: Shouldn't be able to get here");
-      return;
-    }
-
-  assert(0 && "Error: Shouldn't be able to get here if all cases above returned");
-}
-// NOLINTEND(readability-function-size)
-
-
-template <typename URV>
-void
-Hart<URV>::enableInstructionFrequency(bool b)
-{
-  instFreq_ = b;
-  if (b)
-    instProfs_.configure();
-}
-
-
-template <typename URV>
-void
-Hart<URV>::enterDebugMode_(DebugModeCause cause, URV pc)
-{
-  if (cancelLrOnDebug_)
-    cancelLr(CancelLrCause::ENTER_DEBUG);  // Lose LR reservation.
-
-  if (debugMode_)
-    std::cerr << "Warning: Entering debug-mode while in debug-mode\n";
-  debugMode_ = true;
-  csRegs_.enterDebug(true);
-  enteredDebugMode_ = (cause == DebugModeCause::EBREAK) or
-                      (cause == DebugModeCause::TRIGGER);
-
-  updateCachedTriggerState();
-
-  URV value = 0;
-  if (peekCsr(CsrNumber::DCSR, value))
-    {
-      DcsrFields<URV> dcsr(value);
-      dcsr.bits_.CAUSE = URV(cause);
-      dcsr.bits_.PRV = URV(privMode_) & 0x3;
-      dcsr.bits_.V = virtMode_;
-      if (isRvZicfilp())
-        {
-          dcsr.bits_.PELP = elp_;
-          setElp(false);
-        }
-
-      if (nmiPending_)
-        dcsr.bits_.NMIP = 1;
-      csRegs_.poke(CsrNumber::DCSR, dcsr.value_);
-    }
-
-  csRegs_.poke(CsrNumber::DPC, pc);
-  setPrivilegeMode(PrivilegeMode::Machine);
-  setVirtualMode(false);
-
-  // If hart is configured to jump to a special target on enetering debug mode, then set
-  // the pc to that target.
-  if (debugParkLoop_ != ~URV(0))
-    {
-      pc_ = debugParkLoop_;
-      inDebugParkLoop_ = true;
-    }
-}
-
-
-template <typename URV>
-void
-Hart<URV>::enterDebugMode(URV pc)
-{
-  // This method is used by the test-bench to make the simulator follow it into
-  // debug-mode. Do nothing if the simulator got into debug-mode on its own.
-  if (debugMode_)
-    return;   // Already in debug mode.
-
-  enterDebugMode_(DebugModeCause::HALTREQ, pc);
-}
-
-
-template <typename URV>
-void
-Hart<URV>::exitDebugMode()
-{
-  if (not debugMode_)
-    {
-      std::cerr << "Warning: Bench sent exit debug while not in debug mode.\n";
-      return;
-    }
-
-  if (cancelLrOnDebug_)
-    cancelLr(CancelLrCause::EXIT_DEBUG);  // Lose LR reservation.
-
-  pc_ = peekCsr(CsrNumber::DPC);  // Restore PC
-
-  debugMode_ = false;
-  inDebugParkLoop_ = false;
-  csRegs_.enterDebug(false);
-
-  updateCachedTriggerState();
-
-  URV dcsrVal = 0;
-  if (not peekCsr(CsrNumber::DCSR, dcsrVal))
-    std::cerr << "Warning: Failed to read DCSR in exit debug.\n";
-
-  DcsrFields<URV> dcsrf(dcsrVal);
-
-  // Restore privilege mode.
-  auto pm = PrivilegeMode{dcsrf.bits_.PRV};
-  setPrivilegeMode(pm);
+  // Restore privilege mode.
+  auto pm = PrivilegeMode{dcsrf.bits_.PRV};
+  setPrivilegeMode(pm);
 
   // Restore virtual mode.
   bool vm = dcsrf.bits_.V;
@@ -11977,6 +8923,10 @@ Hart<URV>::execFencei(const DecodedInst* di)
     traceCache(0, 0, 0, false, false, false, true, false);
 
   // invalidateDecodeCache();  // No need for this. We invalidate on each write.
+
+  // Stores already invalidate overlapping blocks. Dropping the blocks
+  // here is cheap and keeps fence.i a hard barrier for the block cache.
+  invalidateBlockCache();
 }
 
 
@@ -12172,8 +9122,11 @@ Hart<URV>::execSfence_vma(const DecodedInst* di)
         tlb.invalidateVirtualPageAsid(vpn, asid, wid);
     }
 
-  // The page-walk PTE cache is a translation cache too: flush it on sfence.vma.
+  // The page-walk PTE cache and the fetch/data micro-TLBs are
+  // translation caches too: flush them on sfence.vma.
   virtMem_.flushPteCache();
+  flushFetchTlb();
+  flushDataTlb();
 
 #if 0
   if (mcm_)
@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <bitset>
 #include <utility>
@@ -316,6 +317,12 @@ namespace WdRiscv
     /// first). Return true on success, return false if reg is out of bounds.
     bool peekVecRegLsb(unsigned reg, std::vector<uint8_t>& value) const;
 
+    /// Return the bytes of the given vector register (least significant byte first)
+    /// without copying them. Return an empty span if reg is out of bounds or if vector
+    /// extension is not enabled.
+    std::span<const uint8_t> vecRegBytes(unsigned reg) const
+    { return isRvv() ? vecRegs_.getVecData(reg) : std::span<const uint8_t>(); }
+
     /// Put the bytes of value in the given vector register. The first byte in value
     /// should be the least significant. If value is smaller than vector register size, it
     /// is padded with zeros on the most-significant side.
@@ -869,6 +876,31 @@ namespace WdRiscv
     /// if program is "finished".
     bool runSteps(uint64_t steps, bool& stop, FILE* file = nullptr);
 
+    /// Same as runSteps but stop early, setting sync, at an instruction
+    /// that must not execute while other harts run with buffered stores
+    /// (see Memory::bufferStores): an atomic instruction or a fence
+    /// ordering earlier stores with later loads. That instruction is
+    /// not executed: the caller executes it with runSteps once the
+    /// other harts are stopped and their stores are committed.
+    bool runStepsToSync(uint64_t steps, bool& stop, bool& sync, FILE* file = nullptr);
+
+    /// When flag is true, effects of this hart on other harts (ACLINT
+    /// software-interrupt and timer-compare writes, IMSIC writes) are
+    /// queued instead of applied. The queue is drained by
+    /// applyCrossHartEffects. This is used by the quantum scheduler to
+    /// apply such effects at a barrier in a fixed order.
+    void deferCrossHartEffects(bool flag)
+    { deferCrossHart_ = flag; }
+
+    /// Apply (in program order) the cross-hart effects queued while
+    /// deferCrossHartEffects was on and clear the queue.
+    void applyCrossHartEffects()
+    {
+      for (auto& effect : crossHartEffects_)
+        effect();
+      crossHartEffects_.clear();
+    }
+
     /// Define the program counter value at which the run method will
     /// stop.
     void setStopAddress(URV address)
@@ -954,7 +986,7 @@ namespace WdRiscv
     /// memory lines. Return true on success and false if file cannot
     /// be opened.
     void setInitialStateFile(const util::file::SharedFile& file)
-    { initStateFile_ = file; }
+    { initStateFile_ = file; instrumChanged_ = true; }
 
     /// Disassemble given instruction putting results into the given
     /// string.
@@ -986,6 +1018,7 @@ namespace WdRiscv
       decoder_.decode(addr, physAddr, inst, di);
       if (di.isMop())
         di.setShadowStack(isShadowStackEnabled(privMode_, virtMode_));
+      di.setExecHandler(resolveExecHandler(di.instId()));
     }
 
     /// Return the 32-bit instruction corresponding to the given 16-bit
@@ -1071,6 +1104,20 @@ namespace WdRiscv
     bool pokeMemory(uint64_t addr, uint64_t val, bool usePma,
                     bool skipFetch = false, bool skipData = false, bool skipMem = false);
 
+    /// Copy the given bytes to memory at the given physical address.
+    /// Same as poking the bytes one at a time, but each page of regular
+    /// memory is checked once and written with one copy. Return the
+    /// number of bytes copied: it is less than the size of data if a
+    /// byte could not be written.
+    uint64_t copyToGuest(uint64_t addr, std::span<const uint8_t> data, bool usePma);
+
+    /// Copy bytes from memory at the given physical address into the
+    /// given buffer. Same as peeking the bytes one at a time, but each
+    /// page of regular memory is checked once and read with one
+    /// copy. Return the number of bytes copied: it is less than the
+    /// size of data if a byte could not be read.
+    uint64_t copyFromGuest(uint64_t addr, std::span<uint8_t> data, bool usePma);
+
     /// Define value of program counter after a reset.
     void defineResetPc(URV addr)
     { resetPc_ = addr; }
@@ -1666,6 +1713,7 @@ namespace WdRiscv
     void enableSdtrig(bool flag)
     {
       sdtrigOn_ = flag;
+      instrumChanged_ = true;
       csRegs_.enableSdtrig(flag);
       updateCachedTriggerState();
     }
@@ -1689,11 +1737,11 @@ namespace WdRiscv
     /// Enable performance counters (count up for some enabled performance counters when
     /// their events do occur).
     void enablePerformanceCounters(bool flag)
-    { enableCounters_ = flag;  }
+    { enableCounters_ = flag; instrumChanged_ = true; }
 
     /// Enable gdb-mode.
     void enableGdb(bool flag)
-    { enableGdb_ = flag; }
+    { enableGdb_ = flag; instrumChanged_ = true; }
 
     /// Open TCP socket for gdb
     bool openTcpForGdb();
@@ -2388,9 +2436,36 @@ namespace WdRiscv
       return false;
     }
 
-    /// Set number of TLB entries.
+    /// Set number of TLB entries. This reallocates the TLB entries
+    /// which the micro-TLBs point to: flush them.
     void setTlbSize(unsigned size)
-    { virtMem_.setTlbSize(size); }
+    {
+      virtMem_.setTlbSize(size);
+      flushMicroTlbs();
+    }
+
+    /// Set number of entries per TLB set. See setTlbSize.
+    void setTlbWays(unsigned ways)
+    {
+      virtMem_.setTlbWays(ways);
+      flushMicroTlbs();
+    }
+
+    /// Set number of entries of each superpage TLB array (zero to keep
+    /// superpages in the main TLB array). See setTlbSize.
+    void setSuperpageTlbSize(unsigned size)
+    {
+      virtMem_.setSuperpageTlbSize(size);
+      flushMicroTlbs();
+    }
+
+    /// Return the number of TLB hits, misses, and evictions.
+    void tlbStats(uint64_t& hits, uint64_t& misses, uint64_t& evictions) const
+    { virtMem_.tlbStats(hits, misses, evictions); }
+
+    /// Return the number of page-walk cache hits and misses.
+    void pageWalkCacheStats(uint64_t& hits, uint64_t& misses) const
+    { virtMem_.pageWalkCacheStats(hits, misses); }
 
     /// Debug method: print address translation table.
     void printPageTable(std::ostream& out) const
@@ -2399,7 +2474,7 @@ namespace WdRiscv
     /// Trace the last n branches to the given file. No tracing is
     /// done if n is 0.
     void traceBranches(const std::string& file, uint64_t n)
-    { branchTraceFile_ = file; branchBuffer_.resize(n); }
+    { branchTraceFile_ = file; branchBuffer_.resize(n); instrumChanged_ = true; }
 
     /// Write the collected branch traces to the file at the given path.
     bool saveBranchTrace(const std::string& path, bool compress = false);
@@ -2543,6 +2618,15 @@ namespace WdRiscv
     /// Invalidate whole cache.
     void invalidateDecodeCache();
 
+    /// Invalidate the fetch and data micro-TLBs. They hold host
+    /// addresses of memory pages and TLB entry pointers: this must be
+    /// called when either changes.
+    void flushMicroTlbs()
+    {
+      flushFetchTlb();
+      flushDataTlb();
+    }
+
     /// Register a callback to be invoked before a CSR instruction
     /// accesses its target CSR. Callback is invoked with the
     /// hart-index (hart index in system) and CSR number. This is for
@@ -2560,7 +2644,7 @@ namespace WdRiscv
 
     /// Callback to invoke before the execution of an instruction.
     void registerPreInst(std::function<void(Hart<URV>&, bool&, bool&)> callback)
-    { preInst_ = std::move(callback); }
+    { preInst_ = std::move(callback); instrumChanged_ = true; }
 
     /// Define/re-define a physical memory attribute region at index ix. Region addresses
     /// are between low and high inclusive. To define a 1024-byte region at address zero
@@ -2623,7 +2707,7 @@ namespace WdRiscv
     /// Enable basic block stats if given file is non-null. Print
     /// stats every instCount instructions.
     void enableBasicBlocks(util::file::SharedFile file, uint64_t instCount)
-    { bbFile_ = std::move(file); bbLimit_ = instCount; }
+    { bbFile_ = std::move(file); bbLimit_ = instCount; instrumChanged_ = true; }
 
     /// Enable memory consistency model.
     void setMcm(std::shared_ptr<Mcm<URV>> mcm,
@@ -2637,7 +2721,7 @@ namespace WdRiscv
 
     /// Enable instruction line address tracing.
     void enableInstructionLineTrace(bool flag)
-    { instrLineTrace_ = flag; }
+    { instrLineTrace_ = flag; instrumChanged_ = true; }
 
     /// Enable instruction line address tracing.
     void enableDataLineTrace(bool flag)
@@ -2841,15 +2925,23 @@ namespace WdRiscv
       auto& cache = getMcmCache<C>();
       bool poked = cache.poke(addr, byte);
       // A committed store that lands in the MCM data cache (rather than memory_)
-      // bypasses the Memory::write/poke invalidation observer; keep the page-walk
-      // PTE cache coherent by invalidating here too. (The page-table walk reads
-      // the data cache via peekMemory under mcm_+dataCache_.)
+      // bypasses the Memory::write/poke page generations; keep the page-walk PTE
+      // caches of all harts coherent by advancing the generation here too. (The
+      // page-table walk reads the data cache via peekMemory under mcm_+dataCache_.)
       if constexpr (C == McmMem::Data)
         if (poked)
-          virtMem_.invalidatePteCache(addr, 1);
+          memory_.notifyWrite(addr, 1);
       return poked;
     }
 
+    /// Return the host address of the given physical range (within one
+    /// page) if it can be read (or written if write is true) directly:
+    /// regular memory with no memory model cache, no memory mapped
+    /// register, no IO device or hart device (ACLINT, IMSIC, PCI, APLIC,
+    /// IOMMU) and uniform attributes allowing the access. Return nullptr
+    /// otherwise.
+    uint8_t* bulkHostAddress(uint64_t pa, uint64_t size, bool write, bool usePma);
+
     /// Return data (if it exists) within cache. May perform multiple peeks
     /// for cache-line crossing accesses.
     template <McmMem C, typename SZ>
@@ -3001,7 +3093,7 @@ namespace WdRiscv
     { return aclintAlarm_; }
 
     void enableRoiRange(bool flag)
-    { traceOn_ = not flag; hasRoiRange_ = flag; }
+    { traceOn_ = not flag; hasRoiRange_ = flag; instrumChanged_ = true; }
 
     bool hasRoiTraceEnabled() const
     { return hasRoiRange_; }
@@ -3414,13 +3506,6 @@ namespace WdRiscv
     /// PMP.
     void setupVirtMemCallbacks();
 
-    /// Enable the page-walk PTE cache only where it can be kept coherent: a single
-    /// hart (the invalidation observer is bound to one hart). The MCM/perfApi
-    /// store-commit path (Memory::poke) now fires the same observer as Memory::write,
-    /// so out-of-order configs no longer need to disable the cache.
-    void updatePteCacheActive()
-    { virtMem_.setPteCacheActive(numHarts_ == 1); }
-
     /// Tie frequency updated CSRs to variables in this object for fast access.
     void tieCsrs();
 
@@ -3522,11 +3607,25 @@ namespace WdRiscv
       if (bigEnd_)
 	value = util::byteswap(value);
 
+      bool cas = casPending_;
+      casPending_ = false;
+
       if (pa1 == pa2)
 	{
 	  if (not steeInsec1_)
             {
               bool mmr = pmaMgr_.getPma(pa1).hasMemMappedReg() and pmaMgr_.isMemMappedReg(pa1);
+              auto ioLock = lockIoForWrite(pa1, pa2, sizeof(value), mmr);
+              if (cas and not mmr) [[unlikely]]
+                {
+                  STORE_TYPE expected = casExpected_;
+                  if (bigEnd_)
+                    expected = util::byteswap(expected);
+                  casFailed_ = not memory_.compareExchange(pa1, expected, value);
+                  if (casFailed_)
+                    casExpected_ = bigEnd_ ? util::byteswap(expected) : expected;
+                  return;
+                }
               bool ok = mmr? pmaMgr_.writeRegister(pa1, value) : memory_.write(pa1, value);
               if (not ok)
                 assert(0 && "Error: Assertion failed");
@@ -3536,6 +3635,15 @@ namespace WdRiscv
 
       if constexpr (sizeof(STORE_TYPE) > 1)
 	{
+          // Keep the bytes of a page-crossing store from interleaving
+          // with those of another hart running in a separate thread.
+          std::pair<std::unique_lock<SpinLock>, std::unique_lock<SpinLock>> locks;
+          if (memory_.isConcurrent())
+            locks = memory_.lockLines(pa1, pa2);
+          bool mmrs = ( (pmaMgr_.getPma(pa1).hasMemMappedReg() and pmaMgr_.isMemMappedReg(pa1)) or
+                        (pmaMgr_.getPma(pa2).hasMemMappedReg() and pmaMgr_.isMemMappedReg(pa2)) );
+          auto ioLock = lockIoForWrite(pa1, pa2, sizeof(value), mmrs);
+
           unsigned size = sizeof(value);
           unsigned size1 = size - (pa1 & (size - 1));
           unsigned size2 = size - size1;
@@ -3566,6 +3674,66 @@ namespace WdRiscv
 	}
     }
 
+    /// Make the next memWrite of an atomic instruction (AMO, SC) a
+    /// compare-exchange against the given (previously loaded) value if
+    /// harts run in separate threads: plain stores of other harts take
+    /// no lock and may land between the load and the store.
+    void expectOnWrite(uint64_t value)
+    {
+      casPending_ = memory_.isConcurrent();
+      casExpected_ = value;
+      casFailed_ = false;
+    }
+
+    /// Return true if the memWrite armed by expectOnWrite found a value
+    /// other than the expected one and did not write. Disarm.
+    bool expectedWriteFailed()
+    {
+      bool failed = casFailed_;
+      casPending_ = casFailed_ = false;
+      return failed;
+    }
+
+    /// Complete the write of an atomic instruction after
+    /// expectedWriteFailed returned true: retry the compare-exchange
+    /// alone at the given physical address, computing the value to store
+    /// from the value found in memory using the given function, until it
+    /// succeeds. Return the value replaced. Unlike re-executing the
+    /// instruction, this does not repeat its trigger, trace and MCM side
+    /// effects.
+    template <typename T, typename F>
+    T retryExpectedWrite(uint64_t pa, F newValue)
+    {
+      T found = T(casExpected_);
+      while (true)
+        {
+          T expected = found, desired = newValue(found);
+          if (bigEnd_)
+            {
+              expected = util::byteswap(expected);
+              desired = util::byteswap(desired);
+            }
+          if (memory_.compareExchange(pa, expected, desired))
+            return found;
+          found = bigEnd_ ? util::byteswap(expected) : expected;
+        }
+    }
+
+    /// Return a lock serializing the write of the given size at pa1/pa2
+    /// with other device and memory-mapped-register writes if harts run
+    /// in separate threads and the write targets an IO device or a
+    /// memory-mapped register (mmr is true). Return an empty lock
+    /// otherwise: plain memory writes do not lock.
+    std::unique_lock<std::mutex> lockIoForWrite(uint64_t pa1, uint64_t pa2, unsigned size, bool mmr)
+    {
+      if (not memory_.isConcurrent()) [[likely]]
+        return {};
+      if (mmr or memory_.hasIoInRange(pa1, pa1 + size - 1) or
+          (pa2 != pa1 and memory_.hasIoInRange(pa2, pa2 + size - 1)))
+        return std::unique_lock(memory_.ioMutex_);
+      return {};
+    }
+
     /// Peek an item that may span 2 physical pages. See memRead.
     /// Unlike read, this will not access IO devices.
     template <typename LOAD_TYPE>
@@ -3800,10 +3968,229 @@ namespace WdRiscv
     /// present.
     bool simpleRunWithLimit();
 
+    /// Instrumentation features checked by the untilAddress loop. The
+    /// loop is specialized on the set of active features so that a run
+    /// does not pay for the checks of the inactive ones.
+    enum InstrumFeature : unsigned
+      {
+        IfTrigger     = 1,    // Debug triggers (sdtrig).
+        IfGdb         = 2,    // Gdb mode.
+        IfPreInst     = 4,    // Pre-instruction callback.
+        IfBasicBlock  = 8,    // Basic-block stats.
+        IfLineTrace   = 16,   // Instruction line address trace.
+        IfInitState   = 32,   // Initial memory state dump.
+        IfRoi         = 64,   // Region-of-interest tracing.
+        IfStats       = 128,  // Instruction frequency or performance counters.
+        IfBranchTrace = 256,  // Branch trace.
+        IfTraceFile   = 512,  // Instruction trace: log file or tracer extension.
+        IfAll         = 1023
+      };
+
+    /// Return the set of instrumentation features (InstrumFeature bits)
+    /// currently active for a run with the given trace file.
+    unsigned activeInstrumentation(FILE* traceFile) const;
+
+    /// Helper to untilAddress: Run until the given address or until an
+    /// instruction limit is reached checking only the instrumentation
+    /// features in the FEATURES mask (features not in the mask must be
+    /// inactive). Return early setting reselect to true if a feature is
+    /// toggled during the run.
+    template <unsigned FEATURES>
+    bool untilAddressLoop(uint64_t address, FILE* traceFile, bool& reselect);
+
     /// Helper to simpleRun method when no instruction count limit is
     /// present.
     bool simpleRunNoLimit();
 
+    /// Invalidate all the blocks of the basic-block cache.
+    void invalidateBlockCache()
+    {
+      ++blockCacheGen_;
+      blockCodePages_.reset();
+    }
+
+    // Instruction fetch micro-TLB: a few direct-mapped entries mapping a
+    // recently fetched virtual page to its physical page and host
+    // address. An entry is filled only after the fetch checks passed for
+    // a page with uniform PMP/PMA attributes, so a hit needs no further
+    // checks. It is flushed on changes to address translation, PMP, PMA
+    // (compared by generation) and on TLB fences. An entry of a translated
+    // page is used only while the TLB entries of the translation are
+    // resident (see touchMainTlb).
+    struct FetchTlbEntry
+    {
+      uint64_t vpn_ = ~uint64_t(0);     // Virtual page number (~0 if invalid).
+      uint64_t ppa_ = 0;                // Physical address of page.
+      uint64_t gpa_ = 0;                // Guest physical address of page.
+      const uint8_t* host_ = nullptr;   // Host address of page.
+      TlbEntry* tlb1_ = nullptr;        // First/single stage TLB entry of page.
+      TlbEntry* tlb2_ = nullptr;        // Second stage TLB entry of page.
+      PrivilegeMode priv_ = PrivilegeMode::Machine;
+      bool virt_ = false;
+      bool translated_ = false;         // True if filled with translation on.
+    };
+    static constexpr unsigned fetchTlbSize_ = 16;
+    static constexpr unsigned fetchTlbPageShift_ = 12;
+    static constexpr uint64_t fetchTlbPageMask_ = (uint64_t(1) << fetchTlbPageShift_) - 1;
+
+    /// Invalidate all the entries of the instruction fetch micro-TLB.
+    void flushFetchTlb()
+    {
+      for (auto& entry : fetchTlb_)
+        entry.vpn_ = ~uint64_t(0);
+    }
+
+    /// Return the fetch micro-TLB entry of the page containing the given
+    /// instruction address or nullptr if there is no such entry for the
+    /// current privilege/virtual mode.
+    const FetchTlbEntry* fetchTlbLookup(uint64_t va)
+    {
+      if (fetchTlbPmaGen_ != pmaMgr_.generation()) [[unlikely]]
+        {
+          flushFetchTlb();
+          fetchTlbPmaGen_ = pmaMgr_.generation();
+        }
+      uint64_t vpn = va >> fetchTlbPageShift_;
+      const auto& entry = fetchTlb_[vpn & (fetchTlbSize_ - 1)];
+      if (entry.vpn_ == vpn and entry.priv_ == privMode_ and entry.virt_ == virtMode_)
+        return &entry;
+      return nullptr;
+    }
+
+    /// Return true if the fetch micro-TLB may be used: it bypasses the
+    /// per-access PMP/PMA checks (and their trace) and STEE.
+    bool fetchTlbUsable() const
+    {
+      return not steeEnabled_ and not pmpMgr_.isTraceEnabled() and
+        not pmaMgr_.isTraceEnabled();
+    }
+
+    /// Record in the fetch micro-TLB the translation of the given
+    /// instruction virtual address (which passed the fetch checks) to
+    /// the given physical/guest-physical address. No-op unless the whole
+    /// page has uniform PMP/PMA attributes and resides in host memory.
+    void fillFetchTlb(uint64_t va, uint64_t pa, uint64_t gpa);
+
+    /// Set te1/te2 to the entries of the first/second stage TLBs that
+    /// hold the translation of the given virtual address (to the given
+    /// guest physical address) in the given mode, or to nullptr for a
+    /// stage not in use. Return false if a stage in use has no entry (its
+    /// TLB declined to replace an entry): the translation would walk
+    /// again on the next access.
+    bool findMainTlbEntries(uint64_t va, uint64_t gpa, PrivilegeMode pm, bool virt,
+                            TlbEntry*& te1, TlbEntry*& te2);
+
+    /// Account for count hits in the TLB entries backing the given
+    /// micro-TLB entry: advance their replacement counters and the TLB
+    /// hit count as count translations would so that replacement (and
+    /// hence page table walks and their trace) and statistics are the
+    /// same as without the micro-TLB. Return false, with no side effect,
+    /// if an entry no longer holds the translation of the page: the
+    /// access must then translate.
+    template <typename ENTRY>
+    bool touchMainTlb(const ENTRY& entry, unsigned count = 1)
+    {
+      TlbEntry* te1 = entry.tlb1_;
+      TlbEntry* te2 = entry.tlb2_;
+      uint64_t ppn = entry.ppa_ >> fetchTlbPageShift_;
+      uint64_t gpn = entry.gpa_ >> fetchTlbPageShift_;
+      if (te1 and not te1->maps(entry.vpn_, te2 ? gpn : ppn))
+        return false;
+      if (te2 and not te2->maps(gpn, ppn))
+        return false;
+      if (te1)
+        te1->counter_ = (te1->counter_ + count) & 3;
+      if (te2)
+        te2->counter_ = (te2->counter_ + count) & 3;
+      virtMem_.countTlbHits(uint64_t(count) * ((te1 != nullptr) + (te2 != nullptr)));
+      return true;
+    }
+
+    // Data micro-TLB: a small direct-mapped cache mapping recently
+    // accessed virtual data pages to their physical page and host
+    // address. An entry is filled only after a load (store) passed the
+    // translation/PMP/PMA checks on a page of ordinary memory (uniform
+    // PMP/PMA, idempotent, no IO device, no memory mapped register), so
+    // a hit reads (writes) host memory directly unless it targets a
+    // console-io/to-host location. It is flushed at the
+    // same points as the fetch micro-TLB and on changes of MSTATUS or
+    // VSSTATUS SUM/MXR. Like the fetch micro-TLB, it defers to the TLB
+    // entries of a translated page (see touchMainTlb).
+    struct DataTlbEntry
+    {
+      uint64_t vpn_ = ~uint64_t(0);     // Virtual page number (~0 if invalid).
+      uint64_t ppa_ = 0;                // Physical address of page.
+      uint64_t gpa_ = 0;                // Guest physical address of page.
+      uint8_t* host_ = nullptr;         // Host address of page.
+      TlbEntry* tlb1_ = nullptr;        // First/single stage TLB entry of page.
+      TlbEntry* tlb2_ = nullptr;        // Second stage TLB entry of page.
+      Pma pma_;                         // PMA of page (after PBMT override).
+      PrivilegeMode priv_ = PrivilegeMode::Machine;  // Effective ld/st mode.
+      bool virt_ = false;               // Effective ld/st virtual mode.
+      bool read_ = false;               // True if a load passed the checks.
+      bool write_ = false;              // True if a store passed the checks.
+      bool special_ = false;            // True if page has console-io/to-host.
+    };
+    static constexpr unsigned dataTlbSize_ = 64;
+    static constexpr unsigned dataTlbPageShift_ = 12;
+    static constexpr uint64_t dataTlbPageMask_ = (uint64_t(1) << dataTlbPageShift_) - 1;
+
+    /// Invalidate all the entries of the data micro-TLB.
+    void flushDataTlb()
+    {
+      for (auto& entry : dataTlb_)
+        entry.vpn_ = ~uint64_t(0);
+    }
+
+    /// Return the data micro-TLB entry of the page containing the given
+    /// (pointer-masked) data address or nullptr if there is no such
+    /// entry for the effective load/store privilege/virtual mode.
+    DataTlbEntry* dataTlbLookup(uint64_t va)
+    {
+      if (dataTlbPmaGen_ != pmaMgr_.generation()) [[unlikely]]
+        {
+          flushDataTlb();
+          dataTlbPmaGen_ = pmaMgr_.generation();
+        }
+      uint64_t vpn = va >> dataTlbPageShift_;
+      auto& entry = dataTlb_[vpn & (dataTlbSize_ - 1)];
+      if (entry.vpn_ != vpn)
+        return nullptr;
+      auto [pm, virt] = effLdStMode();
+      if (entry.priv_ == pm and entry.virt_ == virt)
+        return &entry;
+      return nullptr;
+    }
+
+    /// Return true if the current load/store of the given size to the
+    /// given address may use the data micro-TLB: the access must be
+    /// aligned, must not be a hypervisor or atomic access, and must have
+    /// no side effect (trigger, MCM/perf-model, trace, endian swap,
+    /// injected exception) other than reading/writing memory.
+    bool dataTlbUsable(const DecodedInst* di, uint64_t va, unsigned size) const
+    {
+      return (va & (size - 1)) == 0 and not hyperLs_ and not di->isAmo() and
+        not hasActiveTrigger() and not ooo_ and not mcm_ and not bigEnd_ and
+        not initStateFile_ and not dataLineTrace_ and not traceCacheOn_ and
+        injectException_ == ExceptionCause::NONE and not steeEnabled_ and
+        not pmpMgr_.isTraceEnabled() and not pmaMgr_.isTraceEnabled();
+    }
+
+    /// Record in the data micro-TLB that a load (or store if write is
+    /// true) of the given pointer-masked virtual address passed all the
+    /// checks and maps to the given guest-physical/physical address with
+    /// the given PMA. No-op unless the page holds ordinary memory.
+    void fillDataTlb(uint64_t va, uint64_t gpa, uint64_t pa, const Pma& pma, bool write);
+
+    /// Return true if any part of the physical address range [addr0,
+    /// addr1] is occupied by a device.
+    bool hasDeviceInRange(uint64_t addr0, uint64_t addr1) const;
+
+    /// Return true if the given physical address is that of console-io
+    /// or to-host: accessing it has side effects.
+    bool isSpecialAddr(uint64_t addr) const
+    { return (conIoValid_ and addr == conIo_) or isToHostAddr(addr); }
+
     /// Helper to decode. Used for compressed instructions.
     const InstEntry& decode16(uint16_t inst, uint32_t& op0, uint32_t& op1,
 			      uint32_t& op2);
@@ -4176,11 +4563,52 @@ namespace WdRiscv
     /// physical address corresponding to the given virtual address.
     bool fetchInst(URV virAddr, uint64_t& physAddr, uint32_t& instr);
 
-    /// Helper to the run methods: Fetch an instruction taking debug triggers
-    /// into consideration. Return true if successful. Return false if
-    /// instruction fetch fails (an exception is signaled in that case).
+    /// Translate the given instruction virtual address and check the
+    /// fetch permissions (PMP/PMA) of its first 2 bytes without reading
+    /// memory. Return the exception cause (NONE on success). Set pa to
+    /// the physical address and gpa to the guest physical address.
+    ExceptionCause translateInstAddr(uint64_t va, uint64_t& pa, uint64_t& gpa);
+
+    /// Read the instruction at physical address pa previously obtained
+    /// from translateInstAddr. The instruction must not cross a page.
+    /// Check the fetch permissions of the upper half of a misaligned
+    /// 32-bit instruction. On a fault in the upper half, va and gpa are
+    /// advanced by 2 to report the faulting portion.
+    ExceptionCause readTranslatedInst(uint64_t& va, uint64_t pa, uint64_t& gpa,
+                                      uint32_t& inst);
+
+    /// Fetch and decode the instruction at the given virtual address
+    /// through the physically tagged decode cache. Return true on
+    /// success setting physAddr and di (pointing into the decode
+    /// cache). Return false on fail (in which case an exception is
+    /// initiated). A hit in a page not written since the entry was
+    /// decoded does not re-read the instruction word.
+    bool fetchDecodedInst(URV virtAddr, uint64_t& physAddr, DecodedInst*& di);
+
+    /// Return true if the instruction at the PC must not execute while
+    /// other harts run with buffered stores. See runStepsToSync.
+    bool atSyncInst();
+
+    /// Return true if a decode cache entry may be validated by page
+    /// write generation. Fetches with side effects (MCM fetch cache,
+    /// initial state dump, cache or PMP/PMA trace), with STEE address
+    /// rewriting or from memory modeled by external callbacks (whose
+    /// writes do not advance the generations) must read the
+    /// instruction word.
+    bool decodeCacheUsesGen() const
+    {
+      return not (mcm_ and fetchCache_) and not initStateFile_ and
+        not traceCacheOn_ and not steeEnabled_ and not pmpMgr_.isTraceEnabled() and
+        not pmaMgr_.isTraceEnabled() and not memory_.hasExternalCallbacks();
+    }
+
+    /// Helper to the run methods: Fetch and decode an instruction
+    /// taking debug triggers into consideration. Return true if
+    /// successful setting di to the decode cache entry of the
+    /// instruction. Return false if instruction fetch fails (an
+    /// exception is signaled in that case).
     bool fetchInstWithTrigger(URV addr, uint64_t& physAddr, uint32_t& inst,
-			      FILE* trace);
+			      DecodedInst*& di, FILE* trace);
 
     /// Helper to fetchInstWithTrigger. Fetch an instruction given that a trigger has
     /// tripped. Return true on success. Return false on a a fail in which case a trigger
@@ -4240,8 +4668,48 @@ namespace WdRiscv
     void orFcsrFlags(FpFlags value);
 
     /// Execute decoded instruction. Branch/jump instructions will
-    /// modify pc_.
-    void execute(const DecodedInst* di);
+    /// modify pc_. Dispatch through the handler resolved at decode
+    /// time, if any, falling back on executeSwitch otherwise. Build
+    /// with SWITCH_DISPATCH to always use the switch.
+    void execute(const DecodedInst* di)
+    {
+#ifndef SWITCH_DISPATCH
+      auto handler = di->execHandler();
+      if (handler and not (elp_ and isRvZicfilp()))
+        {
+          hyperLs_ = false;
+          handler(this, di);
+          return;
+        }
+#endif
+      executeSwitch(di);
+    }
+
+    /// Execute decoded instruction by switching on its instruction id.
+    void executeSwitch(const DecodedInst* di);
+
+    /// Return the handler executing instructions with the given id in
+    /// a hart of this class, or nullptr if such instructions must go
+    /// through executeSwitch.
+    static DecodedInst::ExecHandler resolveExecHandler(InstId id);
+
+    /// Threaded-dispatch handler calling the given exec method.
+    template <void (Hart::*EXEC)(const DecodedInst*)>
+    static void execThunk(void* hart, const DecodedInst* di)
+    { (static_cast<Hart*>(hart)->*EXEC)(di); }
+
+    /// Threaded-dispatch handler for compressed instructions: Call the
+    /// given exec method if Zca and the given extension are enabled;
+    /// otherwise, take an illegal instruction trap.
+    template <bool (Hart::*EXT)() const, void (Hart::*EXEC)(const DecodedInst*)>
+    static void execZcThunk(void* hart, const DecodedInst* di)
+    {
+      auto& self = *static_cast<Hart*>(hart);
+      if (self.isRvzca() and (self.*EXT)())
+        (self.*EXEC)(di);
+      else
+        self.illegalInst(di);
+    }
 
     /// Helper to disassembleInst32: Disassemble instructions
     /// associated with opcode 1010011.
@@ -4860,39 +5328,103 @@ namespace WdRiscv
     void execVsetvl(const DecodedInst*);
 
     /// Helper to vector vv instructions (eg vadd.vv, vsub.vv). Operation
-    /// to be performed (eg. add, sub) is passed in op.
-    template<typename ELEM_TYPE>
+    /// to be performed (eg. add, sub) is passed in op (a functor called
+    /// with two ELEM_TYPE values). Unmasked operations with a zero vstart
+    /// and undisturbed tail are done on contiguous spans of the register
+    /// file in a loop that the compiler can vectorize.
+    template<typename ELEM_TYPE, typename OP>
     void vop_vv(unsigned vd, unsigned vs1, unsigned vs2, unsigned group,
-		unsigned start, unsigned elems, bool masked,
-		std::function<ELEM_TYPE(ELEM_TYPE, ELEM_TYPE)> op);
+		unsigned start, unsigned elems, bool masked, OP op)
+    {
+      ELEM_TYPE e1{}, e2{}, dest{};
+
+      unsigned destGroup = std::max(VecRegs::groupMultiplierX8(GroupMultiplier::One), group);
+
+      if (start >= vecRegs_.elemCount())
+        return;
+
+      if (start == 0 and not masked and vecRegs_.isTailKept())
+        {
+          // Destination may be the same as a source.
+          unsigned vl = vecRegs_.elemCount();
+          const auto* src1 = vecRegs_.elemData<ELEM_TYPE>(vs1, vl, group);
+          const auto* src2 = vecRegs_.elemData<ELEM_TYPE>(vs2, vl, group);
+          if (src1 and src2)
+            if (auto* dst = vecRegs_.writableElemData<ELEM_TYPE>(vd, vl, destGroup))
+              {
+                for (unsigned ix = 0; ix < vl; ++ix)
+                  dst[ix] = static_cast<ELEM_TYPE>(op(src1[ix], src2[ix]));
+                return;
+              }
+        }
+
+      for (unsigned ix = start; ix < elems; ++ix)
+        {
+          if (vecRegs_.isDestActive(vd, ix, destGroup, masked, dest))
+            {
+              vecRegs_.read(vs1, ix, group, e1);
+              vecRegs_.read(vs2, ix, group, e2);
+              dest = static_cast<ELEM_TYPE>(op(e1, e2));
+            }
+          vecRegs_.write(vd, ix, destGroup, dest);
+        }
+    }
 
     /// Same as vop_vv, but for floating-point operations. This updates
     /// incremental fp flags for each vector element.
-    template<typename ELEM_TYPE>
+    template<typename ELEM_TYPE, typename OP>
     void vfop_vv(unsigned vd, unsigned vs1, unsigned vs2, unsigned group,
-		 unsigned start, unsigned elems, bool masked,
-		 std::function<ELEM_TYPE(ELEM_TYPE, ELEM_TYPE)> fop);
+		 unsigned start, unsigned elems, bool masked, OP fop);
 
     /// Helper to vector vv instructions (eg vadd.vx, vsub.vx). Operation
-    /// to be performed (eg. add, sub) is passed in op.
-    template<typename ELEM_TYPE>
+    /// to be performed (eg. add, sub) is passed in op. Same fast path
+    /// as vop_vv.
+    template<typename ELEM_TYPE, typename OP>
     void vop_vx(unsigned vd, unsigned vs1, ELEM_TYPE e2, unsigned group,
-		unsigned start, unsigned elems, bool masked,
-		std::function<ELEM_TYPE(ELEM_TYPE, ELEM_TYPE)> op);
+		unsigned start, unsigned elems, bool masked, OP op)
+    {
+      ELEM_TYPE e1 = 0, dest = 0;
+
+      unsigned destGroup = std::max(VecRegs::groupMultiplierX8(GroupMultiplier::One), group);
+
+      if (start >= vecRegs_.elemCount())
+        return;
+
+      if (start == 0 and not masked and vecRegs_.isTailKept())
+        {
+          unsigned vl = vecRegs_.elemCount();
+          const auto* src1 = vecRegs_.elemData<ELEM_TYPE>(vs1, vl, group);
+          if (src1)
+            if (auto* dst = vecRegs_.writableElemData<ELEM_TYPE>(vd, vl, destGroup))
+              {
+                for (unsigned ix = 0; ix < vl; ++ix)
+                  dst[ix] = static_cast<ELEM_TYPE>(op(src1[ix], e2));
+                return;
+              }
+        }
+
+      for (unsigned ix = start; ix < elems; ++ix)
+        {
+          if (vecRegs_.isDestActive(vd, ix, destGroup, masked, dest))
+            {
+              vecRegs_.read(vs1, ix, group, e1);
+              dest = static_cast<ELEM_TYPE>(op(e1, e2));
+            }
+          vecRegs_.write(vd, ix, destGroup, dest);
+        }
+    }
 
     /// Helper to vector mask vv instructions (eg vmseq.vv). Operation
     /// to be performed (eg. equal_to) passed in op.
-    template<typename ELEM_TYPE>
+    template<typename ELEM_TYPE, typename OP>
     void vmop_vv(unsigned vd, unsigned vs1, unsigned vs2, unsigned group,
-		 unsigned start, unsigned elems, bool masked,
-		 std::function<bool(ELEM_TYPE, ELEM_TYPE)> op);
+		 unsigned start, unsigned elems, bool masked, OP op);
 
     /// Helper to vector mask vv instructions (eg vmseq.vx). Operation
     /// to be performed (eg. equal_to) passed in op.
-    template<typename ELEM_TYPE>
+    template<typename ELEM_TYPE, typename OP>
     void vmop_vx(unsigned vd, unsigned vs1, ELEM_TYPE e2, unsigned group,
-		 unsigned start, unsigned elems, bool masked,
-		 std::function<bool(ELEM_TYPE, ELEM_TYPE)> op);
+		 unsigned start, unsigned elems, bool masked, OP op);
 
     /// Helper to vector vv integer instructions. Operation to be
     /// performed (e.g. std::plus for vadd.vv) is passed in op.
@@ -4930,10 +5462,9 @@ namespace WdRiscv
     /// Helper to vector vs integer reduction instructions (eg
     /// vredsum.vs). Operation to be performed (eg. std::plus) is
     /// passed in op.
-    template<typename ELEM_TYPE>
+    template<typename ELEM_TYPE, typename OP>
     void vredop_vs(unsigned vd, unsigned vs1, unsigned vs2, unsigned group,
-		   unsigned start, unsigned elems, bool masked,
-		   std::function<ELEM_TYPE(ELEM_TYPE, ELEM_TYPE)> op);
+		   unsigned start, unsigned elems, bool masked, OP op);
 
     /// Helper to vector vs integer reduction instructions (eg vredsum.vs). Operation
     /// to be performed (eg. std::plus) is passed in op.
@@ -5531,6 +6062,16 @@ namespace WdRiscv
     [[nodiscard]]
     bool vectorLoad(const DecodedInst*, ElementWidth, bool faultOnFirstOnly);
 
+    /// Bulk path of unit-stride vector load (store if isLoad is false):
+    /// if the page of the element at index ix and address addr has a
+    /// data micro-TLB entry, copy the elements from ix up to the end of
+    /// that page (stopping at index end) directly between host memory
+    /// and vector register group vd, recording them in the ld/st info.
+    /// Return the number of elements copied (0 if none).
+    template <typename ELEM_TYPE>
+    unsigned vecLdStPageBulk(unsigned vd, unsigned groupX8, uint64_t addr,
+                            unsigned ix, unsigned end, bool isLoad);
+
     void execVle8_v(const DecodedInst*);
     void execVle16_v(const DecodedInst*);
     void execVle32_v(const DecodedInst*);
@@ -6338,6 +6879,18 @@ namespace WdRiscv
     void execVqdotsu_vx(const DecodedInst*);
     void execVqdotus_vx(const DecodedInst*);
 
+    /// Helper to the vqdot vv instructions: Add to each active element of
+    /// vd the dot product of the 4 bytes of the corresponding elements of
+    /// vs2 and vs1. Bytes of vs2/vs1 are of type B2/B1 (int8_t/uint8_t).
+    template<typename B2, typename B1>
+    void vqdot_vv(unsigned vd, unsigned vs2, unsigned vs1, unsigned group,
+                  unsigned start, unsigned elems, bool masked);
+
+    /// Same as vqdot_vv but using the bytes of e1 instead of those of vs1.
+    template<typename B2, typename B1>
+    void vqdot_vx(unsigned vd, unsigned vs2, uint32_t e1, unsigned group,
+                  unsigned start, unsigned elems, bool masked);
+
     // Vector zip/unzip
     template<typename ELEM_TYPE>
     void vzip_vv(unsigned vd, unsigned vs1, unsigned vs2, unsigned group,
@@ -6843,11 +7396,80 @@ namespace WdRiscv
     std::vector<InterruptCause> vsInterrupts_; // Possible VS interrupts in high to low priority.
     std::vector<uint64_t> nmInterrupts_;       // Possible NMIs in high to low priority.
 
-    // Decoded instruction cache.
+    std::array<FetchTlbEntry, fetchTlbSize_> fetchTlb_;  // Instruction fetch micro-TLB.
+    uint64_t fetchTlbPmaGen_ = 0;  // PMA generation of fetch micro-TLB contents.
+    std::array<DataTlbEntry, dataTlbSize_> dataTlb_;  // Data micro-TLB.
+    uint64_t dataTlbPmaGen_ = 0;  // PMA generation of data micro-TLB contents.
+
+    bool casPending_ = false;     // Next memWrite is a compare-exchange.
+    bool casFailed_ = false;      // Last compare-exchange found another value.
+    uint64_t casExpected_ = 0;    // Expected value of compare-exchange.
+    uint64_t lrValue_ = 0;        // Bytes loaded by last load-reserve.
+    uint64_t lrValueAddr_ = 0;    // Physical address of lrValue_.
+    unsigned lrValueSize_ = 0;    // Size in bytes of lrValue_.
+
+    bool deferCrossHart_ = false;  // Queue effects on other harts (quantum runs).
+    std::vector<std::function<void()>> crossHartEffects_;
+
+    // Decoded instruction cache indexed and tagged by physical
+    // address. An entry is valid without re-reading memory if the
+    // write generation of its page (see Memory::pageGeneration)
+    // matches the one recorded in decodePageGen_ when it was decoded.
     std::vector<DecodedInst> decodeCache_;
+    std::vector<uint64_t> decodePageGen_;
     uint32_t decodeCacheSize_;
     uint32_t decodeCacheMask_;  // Derived from decodeCacheSize_
 
+    // Basic-block cache (used by simpleRunNoLimit). A block is a
+    // straight-line run of decoded instructions ending with a branch
+    // (or similar) within one page. It is indexed by the physical
+    // address of its first instruction and tagged with that address,
+    // the virtual pc and the privilege/virtual mode in which it was
+    // fetched. A block is valid only if its generation matches
+    // blockCacheGen_ (invalidating the whole cache is a generation bump)
+    // and if the write generation of its page (see
+    // Memory::pageGeneration) is unchanged: a store by any hart to the
+    // page drops the block.
+    struct DecodedBlock
+    {
+      uint64_t pc_ = 0;                 // Virtual address of first instruction.
+      uint64_t pa_ = 0;                 // Physical address of first instruction.
+      uint64_t gen_ = 0;                // Cache generation when built.
+      uint64_t pageGen_ = 0;            // Page write generation when built.
+      PrivilegeMode priv_ = PrivilegeMode::Machine;
+      bool virt_ = false;
+      std::vector<DecodedInst> insts_;  // Instructions in program order.
+    };
+    static constexpr unsigned maxBlockInsts_ = 32;
+
+    // Helper to simpleRunNoLimit: Fetch and decode the straight-line
+    // run of instructions starting at the current pc (translated to
+    // physical address pa) into the given block. Stop after the first
+    // branch, xret, CSR or fence.i instruction, before an instruction
+    // crossing the page boundary, at a fetch fault, or when the block
+    // reaches its maximum length. Return false if the block is empty.
+    bool buildDecodedBlock(DecodedBlock& block, uint64_t pa);
+
+    // Helper to simpleRunNoLimit: Return true if the given block holds
+    // the instructions at the current pc translated to physical address
+    // pa in the current privilege/virtual mode.
+    bool isBlockValid(const DecodedBlock& block, uint64_t pa) const
+    {
+      return block.gen_ == blockCacheGen_ and block.pa_ == pa and block.pc_ == pc_ and
+        block.priv_ == privMode_ and block.virt_ == virtMode_ and
+        block.pageGen_ == memory_.pageGeneration(pa);
+    }
+
+    std::vector<DecodedBlock> blockCache_;
+    uint32_t blockCacheMask_ = 0;
+    uint64_t blockCacheGen_ = 1;
+    uint64_t blockCachePmaGen_ = 0;  // PMA generation of block cache contents.
+
+    // Pages (hashed) holding instructions of cached blocks. A store to
+    // a marked page invalidates the block cache.
+    static constexpr unsigned blockPageFilterSize_ = 4096;
+    std::bitset<blockPageFilterSize_> blockCodePages_;
+
     // Following is for test-bench support. It allow us to cancel div/rem
     bool hasLastDiv_ = false;
     URV priorDivRdVal_ = 0;  // Prior value of most recent div/rem dest register.
@@ -6869,6 +7491,7 @@ namespace WdRiscv
 
     bool traceOn_ = true;
     bool traceFileActive_ = false;   // An instruction-trace file is being written.
+    bool instrumChanged_ = false;    // An untilAddress instrumentation feature was toggled.
     uint64_t traceBegin_ = 0;
     uint64_t traceEnd_ = 0;
     uint64_t traceCount_ = 0;
@@ -2546,6 +2546,36 @@ HartConfig::applyConfig(Hart<URV>& hart, bool userMode, bool verbose) const
       }
     }
 
+  tag = "tlb_ways";
+  if (config_ -> contains(tag))
+    {
+      unsigned ways = 0;
+      if (not getJsonUnsigned(tag, config_ -> at(tag), ways))
+        errors++;
+      else if (ways == 0 or (ways & (ways - 1)) != 0)
+        {
+          cerr << "Error: TLB ways must be a non-zero power of 2\n";
+          errors++;
+        }
+      else
+        hart.setTlbWays(ways);
+    }
+
+  tag = "tlb_superpage_entries";
+  if (config_ -> contains(tag))
+    {
+      unsigned size = 0;
+      if (not getJsonUnsigned(tag, config_ -> at(tag), size))
+        errors++;
+      else if ((size & (size - 1)) != 0)
+        {
+          cerr << "Error: TLB superpage entries must be a power of 2\n";
+          errors++;
+        }
+      else
+        hart.setSuperpageTlbSize(size);
+    }
+
   tag = "clear_mprv_on_ret";
   if (config_ -> contains(tag))
     {
@@ -0,0 +1,1008 @@
+// Copyright 2025 Tenstorrent Corporation or its affiliates.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// List of the instructions executed by a single exec method of
+// Hart. Both Hart::executeSwitch and the threaded-dispatch table of
+// Hart::resolveExecHandler are generated from this list: define the
+// following macros before including this file (it undefines them).
+//
+//   INST_EXEC(id, method)          Instruction id is executed by method.
+//   INST_EXEC_ZC(id, ext, method)  Compressed instruction id is executed
+//                                  by method if Zca and the extension
+//                                  tested by the ext method are enabled,
+//                                  and is illegal otherwise.
+//
+// Instructions with irregular bodies are not listed: they are executed
+// by executeSwitch only.
+
+INST_EXEC(lui, execLui)
+INST_EXEC(auipc, execAuipc)
+INST_EXEC(jal, execJal)
+INST_EXEC(jalr, execJalr)
+INST_EXEC(beq, execBeq)
+INST_EXEC(bne, execBne)
+INST_EXEC(beqi, execBeqi)
+INST_EXEC(bnei, execBnei)
+INST_EXEC(blt, execBlt)
+INST_EXEC(bge, execBge)
+INST_EXEC(bltu, execBltu)
+INST_EXEC(bgeu, execBgeu)
+INST_EXEC(lb, execLb)
+INST_EXEC(lb_aq, execLb_aq)
+INST_EXEC(lh_aq, execLh_aq)
+INST_EXEC(lw_aq, execLw_aq)
+INST_EXEC(ld_aq, execLd_aq)
+INST_EXEC(sb_rl, execSb_rl)
+INST_EXEC(sh_rl, execSh_rl)
+INST_EXEC(sw_rl, execSw_rl)
+INST_EXEC(sd_rl, execSd_rl)
+INST_EXEC(lh, execLh)
+INST_EXEC(lw, execLw)
+INST_EXEC(lbu, execLbu)
+INST_EXEC(lhu, execLhu)
+INST_EXEC(sb, execSb)
+INST_EXEC(sh, execSh)
+INST_EXEC(sw, execSw)
+INST_EXEC(addi, execAddi)
+INST_EXEC(slti, execSlti)
+INST_EXEC(sltiu, execSltiu)
+INST_EXEC(xori, execXori)
+INST_EXEC(ori, execOri)
+INST_EXEC(andi, execAndi)
+INST_EXEC(slli, execSlli)
+INST_EXEC(srli, execSrli)
+INST_EXEC(srai, execSrai)
+INST_EXEC(add, execAdd)
+INST_EXEC(sub, execSub)
+INST_EXEC(sll, execSll)
+INST_EXEC(slt, execSlt)
+INST_EXEC(sltu, execSltu)
+INST_EXEC(xor_, execXor)
+INST_EXEC(srl, execSrl)
+INST_EXEC(sra, execSra)
+INST_EXEC(or_, execOr)
+INST_EXEC(and_, execAnd)
+INST_EXEC(fence, execFence)
+INST_EXEC(pause, execFence)
+INST_EXEC(fence_tso, execFence_tso)
+INST_EXEC(fence_i, execFencei)
+INST_EXEC(ecall, execEcall)
+INST_EXEC(ebreak, execEbreak)
+INST_EXEC(csrrw, execCsrrw)
+INST_EXEC(csrrs, execCsrrs)
+INST_EXEC(csrrc, execCsrrc)
+INST_EXEC(csrrwi, execCsrrwi)
+INST_EXEC(csrrsi, execCsrrsi)
+INST_EXEC(csrrci, execCsrrci)
+INST_EXEC(lwu, execLwu)
+INST_EXEC(ld, execLd)
+INST_EXEC(sd, execSd)
+INST_EXEC(addiw, execAddiw)
+INST_EXEC(slliw, execSlliw)
+INST_EXEC(srliw, execSrliw)
+INST_EXEC(sraiw, execSraiw)
+INST_EXEC(addw, execAddw)
+INST_EXEC(subw, execSubw)
+INST_EXEC(sllw, execSllw)
+INST_EXEC(srlw, execSrlw)
+INST_EXEC(sraw, execSraw)
+INST_EXEC(mul, execMul)
+INST_EXEC(mulh, execMulh)
+INST_EXEC(mulhsu, execMulhsu)
+INST_EXEC(mulhu, execMulhu)
+INST_EXEC(div, execDiv)
+INST_EXEC(divu, execDivu)
+INST_EXEC(rem, execRem)
+INST_EXEC(remu, execRemu)
+INST_EXEC(mulw, execMulw)
+INST_EXEC(divw, execDivw)
+INST_EXEC(divuw, execDivuw)
+INST_EXEC(remw, execRemw)
+INST_EXEC(remuw, execRemuw)
+INST_EXEC(lr_w, execLr_w)
+INST_EXEC(sc_w, execSc_w)
+INST_EXEC(amoswap_w, execAmoswap_w)
+INST_EXEC(amoadd_w, execAmoadd_w)
+INST_EXEC(amoxor_w, execAmoxor_w)
+INST_EXEC(amoand_w, execAmoand_w)
+INST_EXEC(amoor_w, execAmoor_w)
+INST_EXEC(amomin_w, execAmomin_w)
+INST_EXEC(amomax_w, execAmomax_w)
+INST_EXEC(amominu_w, execAmominu_w)
+INST_EXEC(amomaxu_w, execAmomaxu_w)
+INST_EXEC(amoswap_b, execAmoswap_b)
+INST_EXEC(amoadd_b, execAmoadd_b)
+INST_EXEC(amoxor_b, execAmoxor_b)
+INST_EXEC(amoand_b, execAmoand_b)
+INST_EXEC(amoor_b, execAmoor_b)
+INST_EXEC(amomin_b, execAmomin_b)
+INST_EXEC(amomax_b, execAmomax_b)
+INST_EXEC(amominu_b, execAmominu_b)
+INST_EXEC(amomaxu_b, execAmomaxu_b)
+INST_EXEC(amoswap_h, execAmoswap_h)
+INST_EXEC(amoadd_h, execAmoadd_h)
+INST_EXEC(amoxor_h, execAmoxor_h)
+INST_EXEC(amoand_h, execAmoand_h)
+INST_EXEC(amoor_h, execAmoor_h)
+INST_EXEC(amomin_h, execAmomin_h)
+INST_EXEC(amomax_h, execAmomax_h)
+INST_EXEC(amominu_h, execAmominu_h)
+INST_EXEC(amomaxu_h, execAmomaxu_h)
+INST_EXEC(amocas_b, execAmocas_b)
+INST_EXEC(amocas_h, execAmocas_h)
+INST_EXEC(lr_d, execLr_d)
+INST_EXEC(sc_d, execSc_d)
+INST_EXEC(amoswap_d, execAmoswap_d)
+INST_EXEC(amoadd_d, execAmoadd_d)
+INST_EXEC(amoxor_d, execAmoxor_d)
+INST_EXEC(amoand_d, execAmoand_d)
+INST_EXEC(amoor_d, execAmoor_d)
+INST_EXEC(amomin_d, execAmomin_d)
+INST_EXEC(amomax_d, execAmomax_d)
+INST_EXEC(amominu_d, execAmominu_d)
+INST_EXEC(amomaxu_d, execAmomaxu_d)
+INST_EXEC(flw, execFlw)
+INST_EXEC(fsw, execFsw)
+INST_EXEC(fmadd_s, execFmadd_s)
+INST_EXEC(fmsub_s, execFmsub_s)
+INST_EXEC(fnmsub_s, execFnmsub_s)
+INST_EXEC(fnmadd_s, execFnmadd_s)
+INST_EXEC(fadd_s, execFadd_s)
+INST_EXEC(fsub_s, execFsub_s)
+INST_EXEC(fmul_s, execFmul_s)
+INST_EXEC(fdiv_s, execFdiv_s)
+INST_EXEC(fsqrt_s, execFsqrt_s)
+INST_EXEC(fsgnj_s, execFsgnj_s)
+INST_EXEC(fsgnjn_s, execFsgnjn_s)
+INST_EXEC(fsgnjx_s, execFsgnjx_s)
+INST_EXEC(fmin_s, execFmin_s)
+INST_EXEC(fmax_s, execFmax_s)
+INST_EXEC(fcvt_w_s, execFcvt_w_s)
+INST_EXEC(fcvt_wu_s, execFcvt_wu_s)
+INST_EXEC(fmv_x_w, execFmv_x_w)
+INST_EXEC(feq_s, execFeq_s)
+INST_EXEC(flt_s, execFlt_s)
+INST_EXEC(fle_s, execFle_s)
+INST_EXEC(fclass_s, execFclass_s)
+INST_EXEC(fcvt_s_w, execFcvt_s_w)
+INST_EXEC(fcvt_s_wu, execFcvt_s_wu)
+INST_EXEC(fmv_w_x, execFmv_w_x)
+INST_EXEC(fcvt_l_s, execFcvt_l_s)
+INST_EXEC(fcvt_lu_s, execFcvt_lu_s)
+INST_EXEC(fcvt_s_l, execFcvt_s_l)
+INST_EXEC(fcvt_s_lu, execFcvt_s_lu)
+INST_EXEC(fld, execFld)
+INST_EXEC(fsd, execFsd)
+INST_EXEC(fmadd_d, execFmadd_d)
+INST_EXEC(fmsub_d, execFmsub_d)
+INST_EXEC(fnmsub_d, execFnmsub_d)
+INST_EXEC(fnmadd_d, execFnmadd_d)
+INST_EXEC(fadd_d, execFadd_d)
+INST_EXEC(fsub_d, execFsub_d)
+INST_EXEC(fmul_d, execFmul_d)
+INST_EXEC(fdiv_d, execFdiv_d)
+INST_EXEC(fsqrt_d, execFsqrt_d)
+INST_EXEC(fsgnj_d, execFsgnj_d)
+INST_EXEC(fsgnjn_d, execFsgnjn_d)
+INST_EXEC(fsgnjx_d, execFsgnjx_d)
+INST_EXEC(fmin_d, execFmin_d)
+INST_EXEC(fmax_d, execFmax_d)
+INST_EXEC(fcvt_s_d, execFcvt_s_d)
+INST_EXEC(fcvt_d_s, execFcvt_d_s)
+INST_EXEC(feq_d, execFeq_d)
+INST_EXEC(flt_d, execFlt_d)
+INST_EXEC(fle_d, execFle_d)
+INST_EXEC(fclass_d, execFclass_d)
+INST_EXEC(fcvt_w_d, execFcvt_w_d)
+INST_EXEC(fcvt_wu_d, execFcvt_wu_d)
+INST_EXEC(fcvt_d_w, execFcvt_d_w)
+INST_EXEC(fcvt_d_wu, execFcvt_d_wu)
+INST_EXEC(fcvt_l_d, execFcvt_l_d)
+INST_EXEC(fcvt_lu_d, execFcvt_lu_d)
+INST_EXEC(fmv_x_d, execFmv_x_d)
+INST_EXEC(fcvt_d_l, execFcvt_d_l)
+INST_EXEC(fcvt_d_lu, execFcvt_d_lu)
+INST_EXEC(fmv_d_x, execFmv_d_x)
+INST_EXEC(flh, execFlh)
+INST_EXEC(fsh, execFsh)
+INST_EXEC(fmadd_h, execFmadd_h)
+INST_EXEC(fmsub_h, execFmsub_h)
+INST_EXEC(fnmsub_h, execFnmsub_h)
+INST_EXEC(fnmadd_h, execFnmadd_h)
+INST_EXEC(fadd_h, execFadd_h)
+INST_EXEC(fsub_h, execFsub_h)
+INST_EXEC(fmul_h, execFmul_h)
+INST_EXEC(fdiv_h, execFdiv_h)
+INST_EXEC(fsqrt_h, execFsqrt_h)
+INST_EXEC(fsgnj_h, execFsgnj_h)
+INST_EXEC(fsgnjn_h, execFsgnjn_h)
+INST_EXEC(fsgnjx_h, execFsgnjx_h)
+INST_EXEC(fmin_h, execFmin_h)
+INST_EXEC(fmax_h, execFmax_h)
+INST_EXEC(fcvt_s_h, execFcvt_s_h)
+INST_EXEC(fcvt_d_h, execFcvt_d_h)
+INST_EXEC(fcvt_h_s, execFcvt_h_s)
+INST_EXEC(fcvt_h_d, execFcvt_h_d)
+INST_EXEC(fcvt_w_h, execFcvt_w_h)
+INST_EXEC(fcvt_wu_h, execFcvt_wu_h)
+INST_EXEC(fmv_x_h, execFmv_x_h)
+INST_EXEC(feq_h, execFeq_h)
+INST_EXEC(flt_h, execFlt_h)
+INST_EXEC(fle_h, execFle_h)
+INST_EXEC(fclass_h, execFclass_h)
+INST_EXEC(fcvt_h_w, execFcvt_h_w)
+INST_EXEC(fcvt_h_wu, execFcvt_h_wu)
+INST_EXEC(fmv_h_x, execFmv_h_x)
+INST_EXEC(fcvt_l_h, execFcvt_l_h)
+INST_EXEC(fcvt_lu_h, execFcvt_lu_h)
+INST_EXEC(fcvt_h_l, execFcvt_h_l)
+INST_EXEC(fcvt_h_lu, execFcvt_h_lu)
+INST_EXEC(fcvt_bf16_s, execFcvt_bf16_s)
+INST_EXEC(fcvt_s_bf16, execFcvt_s_bf16)
+INST_EXEC(mret, execMret)
+INST_EXEC(sret, execSret)
+INST_EXEC(mnret, execMnret)
+INST_EXEC(wfi, execWfi)
+INST_EXEC(dret, execDret)
+INST_EXEC(sfence_vma, execSfence_vma)
+INST_EXEC_ZC(c_addi4spn, isRvzca, execAddi)
+INST_EXEC_ZC(c_fld, isRvzcd, execFld)
+INST_EXEC_ZC(c_lq, isRvzca, execLq)
+INST_EXEC_ZC(c_lw, isRvzca, execLw)
+INST_EXEC_ZC(c_flw, isRvzcf, execFlw)
+INST_EXEC_ZC(c_fsd, isRvzcd, execFsd)
+INST_EXEC_ZC(c_sq, isRvzca, execSq)
+INST_EXEC_ZC(c_sw, isRvzca, execSw)
+INST_EXEC_ZC(c_fsw, isRvzcf, execFsw)
+INST_EXEC_ZC(c_addi, isRvzca, execAddi)
+INST_EXEC_ZC(c_jal, isRvzca, execJal)
+INST_EXEC_ZC(c_li, isRvzca, execAddi)
+INST_EXEC_ZC(c_addi16sp, isRvzca, execAddi)
+INST_EXEC_ZC(c_lui, isRvzca, execLui)
+INST_EXEC_ZC(c_srli, isRvzca, execSrli)
+INST_EXEC_ZC(c_srai, isRvzca, execSrai)
+INST_EXEC_ZC(c_andi, isRvzca, execAndi)
+INST_EXEC_ZC(c_sub, isRvzca, execSub)
+INST_EXEC_ZC(c_xor, isRvzca, execXor)
+INST_EXEC_ZC(c_or, isRvzca, execOr)
+INST_EXEC_ZC(c_and, isRvzca, execAnd)
+INST_EXEC_ZC(c_subw, isRvzca, execSubw)
+INST_EXEC_ZC(c_addw, isRvzca, execAddw)
+INST_EXEC_ZC(c_j, isRvzca, execJal)
+INST_EXEC_ZC(c_beqz, isRvzca, execBeq)
+INST_EXEC_ZC(c_bnez, isRvzca, execBne)
+INST_EXEC_ZC(c_slli, isRvzca, execSlli)
+INST_EXEC_ZC(c_slli64, isRvzca, execSlli)
+INST_EXEC_ZC(c_fldsp, isRvzcd, execFld)
+INST_EXEC_ZC(c_lwsp, isRvzca, execLw)
+INST_EXEC_ZC(c_flwsp, isRvzcf, execFlw)
+INST_EXEC_ZC(c_jr, isRvzca, execJalr)
+INST_EXEC_ZC(c_mv, isRvzca, execAdd)
+INST_EXEC_ZC(c_ebreak, isRvzca, execEbreak)
+INST_EXEC_ZC(c_jalr, isRvzca, execJalr)
+INST_EXEC_ZC(c_add, isRvzca, execAdd)
+INST_EXEC_ZC(c_fsdsp, isRvzcd, execFsd)
+INST_EXEC_ZC(c_swsp, isRvzca, execSw)
+INST_EXEC_ZC(c_fswsp, isRvzcf, execFsw)
+INST_EXEC_ZC(c_addiw, isRvzca, execAddiw)
+INST_EXEC(clz, execClz)
+INST_EXEC(ctz, execCtz)
+INST_EXEC(cpop, execCpop)
+INST_EXEC(clzw, execClzw)
+INST_EXEC(ctzw, execCtzw)
+INST_EXEC(cpopw, execCpopw)
+INST_EXEC(min, execMin)
+INST_EXEC(max, execMax)
+INST_EXEC(minu, execMinu)
+INST_EXEC(maxu, execMaxu)
+INST_EXEC(sext_b, execSext_b)
+INST_EXEC(sext_h, execSext_h)
+INST_EXEC(andn, execAndn)
+INST_EXEC(orc_b, execOrc_b)
+INST_EXEC(orn, execOrn)
+INST_EXEC(xnor, execXnor)
+INST_EXEC(rol, execRol)
+INST_EXEC(ror, execRor)
+INST_EXEC(rori, execRori)
+INST_EXEC(rolw, execRolw)
+INST_EXEC(rorw, execRorw)
+INST_EXEC(roriw, execRoriw)
+INST_EXEC(pack, execPack)
+INST_EXEC(packh, execPackh)
+INST_EXEC(packw, execPackw)
+INST_EXEC(brev8, execBrev8)
+INST_EXEC(rev8_32, execRev8_32)
+INST_EXEC(rev8_64, execRev8_64)
+INST_EXEC(zip, execZip)
+INST_EXEC(unzip, execUnzip)
+INST_EXEC(xperm_n, execXperm_n)
+INST_EXEC(xperm_b, execXperm_b)
+INST_EXEC(bset, execBset)
+INST_EXEC(bclr, execBclr)
+INST_EXEC(binv, execBinv)
+INST_EXEC(bext, execBext)
+INST_EXEC(bseti, execBseti)
+INST_EXEC(bclri, execBclri)
+INST_EXEC(binvi, execBinvi)
+INST_EXEC(bexti, execBexti)
+INST_EXEC(clmul, execClmul)
+INST_EXEC(clmulh, execClmulh)
+INST_EXEC(clmulr, execClmulr)
+INST_EXEC(sh1add, execSh1add)
+INST_EXEC(sh2add, execSh2add)
+INST_EXEC(sh3add, execSh3add)
+INST_EXEC(sh1add_uw, execSh1add_uw)
+INST_EXEC(sh2add_uw, execSh2add_uw)
+INST_EXEC(sh3add_uw, execSh3add_uw)
+INST_EXEC(add_uw, execAdd_uw)
+INST_EXEC(slli_uw, execSlli_uw)
+INST_EXEC(vsetvli, execVsetvli)
+INST_EXEC(vsetivli, execVsetivli)
+INST_EXEC(vsetvl, execVsetvl)
+INST_EXEC(vadd_vv, execVadd_vv)
+INST_EXEC(vadd_vx, execVadd_vx)
+INST_EXEC(vadd_vi, execVadd_vi)
+INST_EXEC(vsub_vv, execVsub_vv)
+INST_EXEC(vsub_vx, execVsub_vx)
+INST_EXEC(vrsub_vx, execVrsub_vx)
+INST_EXEC(vrsub_vi, execVrsub_vi)
+INST_EXEC(vwaddu_vv, execVwaddu_vv)
+INST_EXEC(vwaddu_vx, execVwaddu_vx)
+INST_EXEC(vwsubu_vv, execVwsubu_vv)
+INST_EXEC(vwsubu_vx, execVwsubu_vx)
+INST_EXEC(vwadd_vv, execVwadd_vv)
+INST_EXEC(vwadd_vx, execVwadd_vx)
+INST_EXEC(vwsub_vv, execVwsub_vv)
+INST_EXEC(vwsub_vx, execVwsub_vx)
+INST_EXEC(vwaddu_wv, execVwaddu_wv)
+INST_EXEC(vwaddu_wx, execVwaddu_wx)
+INST_EXEC(vwsubu_wv, execVwsubu_wv)
+INST_EXEC(vwsubu_wx, execVwsubu_wx)
+INST_EXEC(vwadd_wv, execVwadd_wv)
+INST_EXEC(vwadd_wx, execVwadd_wx)
+INST_EXEC(vwsub_wv, execVwsub_wv)
+INST_EXEC(vwsub_wx, execVwsub_wx)
+INST_EXEC(vmseq_vv, execVmseq_vv)
+INST_EXEC(vmseq_vx, execVmseq_vx)
+INST_EXEC(vmseq_vi, execVmseq_vi)
+INST_EXEC(vmsne_vv, execVmsne_vv)
+INST_EXEC(vmsne_vx, execVmsne_vx)
+INST_EXEC(vmsne_vi, execVmsne_vi)
+INST_EXEC(vmsltu_vv, execVmsltu_vv)
+INST_EXEC(vmsltu_vx, execVmsltu_vx)
+INST_EXEC(vmslt_vv, execVmslt_vv)
+INST_EXEC(vmslt_vx, execVmslt_vx)
+INST_EXEC(vmsleu_vv, execVmsleu_vv)
+INST_EXEC(vmsleu_vx, execVmsleu_vx)
+INST_EXEC(vmsleu_vi, execVmsleu_vi)
+INST_EXEC(vmsle_vv, execVmsle_vv)
+INST_EXEC(vmsle_vx, execVmsle_vx)
+INST_EXEC(vmsle_vi, execVmsle_vi)
+INST_EXEC(vmsgtu_vx, execVmsgtu_vx)
+INST_EXEC(vmsgtu_vi, execVmsgtu_vi)
+INST_EXEC(vmsgt_vx, execVmsgt_vx)
+INST_EXEC(vmsgt_vi, execVmsgt_vi)
+INST_EXEC(vminu_vv, execVminu_vv)
+INST_EXEC(vminu_vx, execVminu_vx)
+INST_EXEC(vmin_vv, execVmin_vv)
+INST_EXEC(vmin_vx, execVmin_vx)
+INST_EXEC(vmaxu_vv, execVmaxu_vv)
+INST_EXEC(vmaxu_vx, execVmaxu_vx)
+INST_EXEC(vmax_vv, execVmax_vv)
+INST_EXEC(vmax_vx, execVmax_vx)
+INST_EXEC(vand_vv, execVand_vv)
+INST_EXEC(vand_vx, execVand_vx)
+INST_EXEC(vand_vi, execVand_vi)
+INST_EXEC(vor_vv, execVor_vv)
+INST_EXEC(vor_vx, execVor_vx)
+INST_EXEC(vor_vi, execVor_vi)
+INST_EXEC(vxor_vv, execVxor_vv)
+INST_EXEC(vxor_vx, execVxor_vx)
+INST_EXEC(vxor_vi, execVxor_vi)
+INST_EXEC(vsll_vv, execVsll_vv)
+INST_EXEC(vsll_vx, execVsll_vx)
+INST_EXEC(vsll_vi, execVsll_vi)
+INST_EXEC(vsrl_vv, execVsrl_vv)
+INST_EXEC(vsrl_vx, execVsrl_vx)
+INST_EXEC(vsrl_vi, execVsrl_vi)
+INST_EXEC(vsra_vv, execVsra_vv)
+INST_EXEC(vsra_vx, execVsra_vx)
+INST_EXEC(vsra_vi, execVsra_vi)
+INST_EXEC(vnsrl_wv, execVnsrl_wv)
+INST_EXEC(vnsrl_wx, execVnsrl_wx)
+INST_EXEC(vnsrl_wi, execVnsrl_wi)
+INST_EXEC(vnsra_wv, execVnsra_wv)
+INST_EXEC(vnsra_wx, execVnsra_wx)
+INST_EXEC(vnsra_wi, execVnsra_wi)
+INST_EXEC(vrgather_vv, execVrgather_vv)
+INST_EXEC(vrgather_vx, execVrgather_vx)
+INST_EXEC(vrgather_vi, execVrgather_vi)
+INST_EXEC(vrgatherei16_vv, execVrgatherei16_vv)
+INST_EXEC(vcompress_vm, execVcompress_vm)
+INST_EXEC(vredsum_vs, execVredsum_vs)
+INST_EXEC(vredand_vs, execVredand_vs)
+INST_EXEC(vredor_vs, execVredor_vs)
+INST_EXEC(vredxor_vs, execVredxor_vs)
+INST_EXEC(vredminu_vs, execVredminu_vs)
+INST_EXEC(vredmin_vs, execVredmin_vs)
+INST_EXEC(vredmaxu_vs, execVredmaxu_vs)
+INST_EXEC(vredmax_vs, execVredmax_vs)
+INST_EXEC(vwredsumu_vs, execVwredsumu_vs)
+INST_EXEC(vwredsum_vs, execVwredsum_vs)
+INST_EXEC(vmand_mm, execVmand_mm)
+INST_EXEC(vmnand_mm, execVmnand_mm)
+INST_EXEC(vmandn_mm, execVmandn_mm)
+INST_EXEC(vmxor_mm, execVmxor_mm)
+INST_EXEC(vmor_mm, execVmor_mm)
+INST_EXEC(vmnor_mm, execVmnor_mm)
+INST_EXEC(vmorn_mm, execVmorn_mm)
+INST_EXEC(vmxnor_mm, execVmxnor_mm)
+INST_EXEC(vcpop_m, execVcpop_m)
+INST_EXEC(vfirst_m, execVfirst_m)
+INST_EXEC(vmsbf_m, execVmsbf_m)
+INST_EXEC(vmsif_m, execVmsif_m)
+INST_EXEC(vmsof_m, execVmsof_m)
+INST_EXEC(viota_m, execViota_m)
+INST_EXEC(vid_v, execVid_v)
+INST_EXEC(vslideup_vx, execVslideup_vx)
+INST_EXEC(vslideup_vi, execVslideup_vi)
+INST_EXEC(vslide1up_vx, execVslide1up_vx)
+INST_EXEC(vslidedown_vx, execVslidedown_vx)
+INST_EXEC(vslidedown_vi, execVslidedown_vi)
+INST_EXEC(vslide1down_vx, execVslide1down_vx)
+INST_EXEC(vfslide1up_vf, execVfslide1up_vf)
+INST_EXEC(vfslide1down_vf, execVfslide1down_vf)
+INST_EXEC(vmul_vv, execVmul_vv)
+INST_EXEC(vmul_vx, execVmul_vx)
+INST_EXEC(vmulh_vv, execVmulh_vv)
+INST_EXEC(vmulh_vx, execVmulh_vx)
+INST_EXEC(vmulhu_vv, execVmulhu_vv)
+INST_EXEC(vmulhu_vx, execVmulhu_vx)
+INST_EXEC(vmulhsu_vv, execVmulhsu_vv)
+INST_EXEC(vmulhsu_vx, execVmulhsu_vx)
+INST_EXEC(vmadd_vv, execVmadd_vv)
+INST_EXEC(vmadd_vx, execVmadd_vx)
+INST_EXEC(vnmsub_vv, execVnmsub_vv)
+INST_EXEC(vnmsub_vx, execVnmsub_vx)
+INST_EXEC(vmacc_vv, execVmacc_vv)
+INST_EXEC(vmacc_vx, execVmacc_vx)
+INST_EXEC(vnmsac_vv, execVnmsac_vv)
+INST_EXEC(vnmsac_vx, execVnmsac_vx)
+INST_EXEC(vwmulu_vv, execVwmulu_vv)
+INST_EXEC(vwmulu_vx, execVwmulu_vx)
+INST_EXEC(vwmul_vv, execVwmul_vv)
+INST_EXEC(vwmul_vx, execVwmul_vx)
+INST_EXEC(vwmulsu_vv, execVwmulsu_vv)
+INST_EXEC(vwmulsu_vx, execVwmulsu_vx)
+INST_EXEC(vwmaccu_vv, execVwmaccu_vv)
+INST_EXEC(vwmaccu_vx, execVwmaccu_vx)
+INST_EXEC(vwmacc_vv, execVwmacc_vv)
+INST_EXEC(vwmacc_vx, execVwmacc_vx)
+INST_EXEC(vwmaccsu_vv, execVwmaccsu_vv)
+INST_EXEC(vwmaccsu_vx, execVwmaccsu_vx)
+INST_EXEC(vwmaccus_vx, execVwmaccus_vx)
+INST_EXEC(vdivu_vv, execVdivu_vv)
+INST_EXEC(vdivu_vx, execVdivu_vx)
+INST_EXEC(vdiv_vv, execVdiv_vv)
+INST_EXEC(vdiv_vx, execVdiv_vx)
+INST_EXEC(vremu_vv, execVremu_vv)
+INST_EXEC(vremu_vx, execVremu_vx)
+INST_EXEC(vrem_vv, execVrem_vv)
+INST_EXEC(vrem_vx, execVrem_vx)
+INST_EXEC(vsext_vf2, execVsext_vf2)
+INST_EXEC(vsext_vf4, execVsext_vf4)
+INST_EXEC(vsext_vf8, execVsext_vf8)
+INST_EXEC(vzext_vf2, execVzext_vf2)
+INST_EXEC(vzext_vf4, execVzext_vf4)
+INST_EXEC(vzext_vf8, execVzext_vf8)
+INST_EXEC(vadc_vvm, execVadc_vvm)
+INST_EXEC(vadc_vxm, execVadc_vxm)
+INST_EXEC(vadc_vim, execVadc_vim)
+INST_EXEC(vsbc_vvm, execVsbc_vvm)
+INST_EXEC(vsbc_vxm, execVsbc_vxm)
+INST_EXEC(vmadc_vvm, execVmadc_vvm)
+INST_EXEC(vmadc_vxm, execVmadc_vxm)
+INST_EXEC(vmadc_vim, execVmadc_vim)
+INST_EXEC(vmsbc_vvm, execVmsbc_vvm)
+INST_EXEC(vmsbc_vxm, execVmsbc_vxm)
+INST_EXEC(vmerge_vvm, execVmerge_vvm)
+INST_EXEC(vmerge_vxm, execVmerge_vxm)
+INST_EXEC(vmerge_vim, execVmerge_vim)
+INST_EXEC(vmv_x_s, execVmv_x_s)
+INST_EXEC(vmv_s_x, execVmv_s_x)
+INST_EXEC(vfmv_f_s, execVfmv_f_s)
+INST_EXEC(vfmv_s_f, execVfmv_s_f)
+INST_EXEC(vmv_v_v, execVmv_v_v)
+INST_EXEC(vmv_v_x, execVmv_v_x)
+INST_EXEC(vmv_v_i, execVmv_v_i)
+INST_EXEC(vmv1r_v, execVmv1r_v)
+INST_EXEC(vmv2r_v, execVmv2r_v)
+INST_EXEC(vmv4r_v, execVmv4r_v)
+INST_EXEC(vmv8r_v, execVmv8r_v)
+INST_EXEC(vsaddu_vv, execVsaddu_vv)
+INST_EXEC(vsaddu_vx, execVsaddu_vx)
+INST_EXEC(vsaddu_vi, execVsaddu_vi)
+INST_EXEC(vsadd_vv, execVsadd_vv)
+INST_EXEC(vsadd_vx, execVsadd_vx)
+INST_EXEC(vsadd_vi, execVsadd_vi)
+INST_EXEC(vssubu_vv, execVssubu_vv)
+INST_EXEC(vssubu_vx, execVssubu_vx)
+INST_EXEC(vssub_vv, execVssub_vv)
+INST_EXEC(vssub_vx, execVssub_vx)
+INST_EXEC(vaaddu_vv, execVaaddu_vv)
+INST_EXEC(vaaddu_vx, execVaaddu_vx)
+INST_EXEC(vaadd_vv, execVaadd_vv)
+INST_EXEC(vaadd_vx, execVaadd_vx)
+INST_EXEC(vasubu_vv, execVasubu_vv)
+INST_EXEC(vasubu_vx, execVasubu_vx)
+INST_EXEC(vasub_vv, execVasub_vv)
+INST_EXEC(vasub_vx, execVasub_vx)
+INST_EXEC(vsmul_vv, execVsmul_vv)
+INST_EXEC(vsmul_vx, execVsmul_vx)
+INST_EXEC(vssrl_vv, execVssrl_vv)
+INST_EXEC(vssrl_vx, execVssrl_vx)
+INST_EXEC(vssrl_vi, execVssrl_vi)
+INST_EXEC(vssra_vv, execVssra_vv)
+INST_EXEC(vssra_vx, execVssra_vx)
+INST_EXEC(vssra_vi, execVssra_vi)
+INST_EXEC(vnclipu_wv, execVnclipu_wv)
+INST_EXEC(vnclipu_wx, execVnclipu_wx)
+INST_EXEC(vnclipu_wi, execVnclipu_wi)
+INST_EXEC(vnclip_wv, execVnclip_wv)
+INST_EXEC(vnclip_wx, execVnclip_wx)
+INST_EXEC(vnclip_wi, execVnclip_wi)
+INST_EXEC(vle8_v, execVle8_v)
+INST_EXEC(vle16_v, execVle16_v)
+INST_EXEC(vle32_v, execVle32_v)
+INST_EXEC(vle64_v, execVle64_v)
+INST_EXEC(vle128_v, execVle128_v)
+INST_EXEC(vle256_v, execVle256_v)
+INST_EXEC(vle512_v, execVle512_v)
+INST_EXEC(vle1024_v, execVle1024_v)
+INST_EXEC(vse8_v, execVse8_v)
+INST_EXEC(vse16_v, execVse16_v)
+INST_EXEC(vse32_v, execVse32_v)
+INST_EXEC(vse64_v, execVse64_v)
+INST_EXEC(vse128_v, execVse128_v)
+INST_EXEC(vse256_v, execVse256_v)
+INST_EXEC(vse512_v, execVse512_v)
+INST_EXEC(vse1024_v, execVse1024_v)
+INST_EXEC(vlm_v, execVlm_v)
+INST_EXEC(vsm_v, execVsm_v)
+INST_EXEC(vlre8_v, execVlre8_v)
+INST_EXEC(vlre16_v, execVlre16_v)
+INST_EXEC(vlre32_v, execVlre32_v)
+INST_EXEC(vlre64_v, execVlre64_v)
+INST_EXEC(vlre128_v, execVlre128_v)
+INST_EXEC(vlre256_v, execVlre256_v)
+INST_EXEC(vlre512_v, execVlre512_v)
+INST_EXEC(vlre1024_v, execVlre1024_v)
+INST_EXEC(vs1r_v, execVs1r_v)
+INST_EXEC(vs2r_v, execVs2r_v)
+INST_EXEC(vs4r_v, execVs4r_v)
+INST_EXEC(vs8r_v, execVs8r_v)
+INST_EXEC(vle8ff_v, execVle8ff_v)
+INST_EXEC(vle16ff_v, execVle16ff_v)
+INST_EXEC(vle32ff_v, execVle32ff_v)
+INST_EXEC(vle64ff_v, execVle64ff_v)
+INST_EXEC(vle128ff_v, execVle128ff_v)
+INST_EXEC(vle256ff_v, execVle256ff_v)
+INST_EXEC(vle512ff_v, execVle512ff_v)
+INST_EXEC(vle1024ff_v, execVle1024ff_v)
+INST_EXEC(vlse8_v, execVlse8_v)
+INST_EXEC(vlse16_v, execVlse16_v)
+INST_EXEC(vlse32_v, execVlse32_v)
+INST_EXEC(vlse64_v, execVlse64_v)
+INST_EXEC(vlse128_v, execVlse128_v)
+INST_EXEC(vlse256_v, execVlse256_v)
+INST_EXEC(vlse512_v, execVlse512_v)
+INST_EXEC(vlse1024_v, execVlse1024_v)
+INST_EXEC(vsse8_v, execVsse8_v)
+INST_EXEC(vsse16_v, execVsse16_v)
+INST_EXEC(vsse32_v, execVsse32_v)
+INST_EXEC(vsse64_v, execVsse64_v)
+INST_EXEC(vsse128_v, execVsse128_v)
+INST_EXEC(vsse256_v, execVsse256_v)
+INST_EXEC(vsse512_v, execVsse512_v)
+INST_EXEC(vsse1024_v, execVsse1024_v)
+INST_EXEC(vloxei8_v, execVloxei8_v)
+INST_EXEC(vloxei16_v, execVloxei16_v)
+INST_EXEC(vloxei32_v, execVloxei32_v)
+INST_EXEC(vloxei64_v, execVloxei64_v)
+INST_EXEC(vloxei128_v, execVloxei128_v)
+INST_EXEC(vloxei256_v, execVloxei256_v)
+INST_EXEC(vloxei512_v, execVloxei512_v)
+INST_EXEC(vloxei1024_v, execVloxei1024_v)
+INST_EXEC(vluxei8_v, execVluxei8_v)
+INST_EXEC(vluxei16_v, execVluxei16_v)
+INST_EXEC(vluxei32_v, execVluxei32_v)
+INST_EXEC(vluxei64_v, execVluxei64_v)
+INST_EXEC(vluxei128_v, execVluxei128_v)
+INST_EXEC(vluxei256_v, execVluxei256_v)
+INST_EXEC(vluxei512_v, execVluxei512_v)
+INST_EXEC(vluxei1024_v, execVluxei1024_v)
+INST_EXEC(vsoxei8_v, execVsoxei8_v)
+INST_EXEC(vsoxei16_v, execVsoxei16_v)
+INST_EXEC(vsoxei32_v, execVsoxei32_v)
+INST_EXEC(vsoxei64_v, execVsoxei64_v)
+INST_EXEC(vsoxei128_v, execVsoxei128_v)
+INST_EXEC(vsoxei256_v, execVsoxei256_v)
+INST_EXEC(vsoxei512_v, execVsoxei512_v)
+INST_EXEC(vsoxei1024_v, execVsoxei1024_v)
+INST_EXEC(vsuxei8_v, execVsuxei8_v)
+INST_EXEC(vsuxei16_v, execVsuxei16_v)
+INST_EXEC(vsuxei32_v, execVsuxei32_v)
+INST_EXEC(vsuxei64_v, execVsuxei64_v)
+INST_EXEC(vsuxei128_v, execVsuxei128_v)
+INST_EXEC(vsuxei256_v, execVsuxei256_v)
+INST_EXEC(vsuxei512_v, execVsuxei512_v)
+INST_EXEC(vsuxei1024_v, execVsuxei1024_v)
+INST_EXEC(vlsege8_v, execVlsege8_v)
+INST_EXEC(vlsege16_v, execVlsege16_v)
+INST_EXEC(vlsege32_v, execVlsege32_v)
+INST_EXEC(vlsege64_v, execVlsege64_v)
+INST_EXEC(vlsege128_v, execVlsege128_v)
+INST_EXEC(vlsege256_v, execVlsege256_v)
+INST_EXEC(vlsege512_v, execVlsege512_v)
+INST_EXEC(vlsege1024_v, execVlsege1024_v)
+INST_EXEC(vssege8_v, execVssege8_v)
+INST_EXEC(vssege16_v, execVssege16_v)
+INST_EXEC(vssege32_v, execVssege32_v)
+INST_EXEC(vssege64_v, execVssege64_v)
+INST_EXEC(vssege128_v, execVssege128_v)
+INST_EXEC(vssege256_v, execVssege256_v)
+INST_EXEC(vssege512_v, execVssege512_v)
+INST_EXEC(vssege1024_v, execVssege1024_v)
+INST_EXEC(vlssege8_v, execVlssege8_v)
+INST_EXEC(vlssege16_v, execVlssege16_v)
+INST_EXEC(vlssege32_v, execVlssege32_v)
+INST_EXEC(vlssege64_v, execVlssege64_v)
+INST_EXEC(vlssege128_v, execVlssege128_v)
+INST_EXEC(vlssege256_v, execVlssege256_v)
+INST_EXEC(vlssege512_v, execVlssege512_v)
+INST_EXEC(vlssege1024_v, execVlssege1024_v)
+INST_EXEC(vsssege8_v, execVsssege8_v)
+INST_EXEC(vsssege16_v, execVsssege16_v)
+INST_EXEC(vsssege32_v, execVsssege32_v)
+INST_EXEC(vsssege64_v, execVsssege64_v)
+INST_EXEC(vsssege128_v, execVsssege128_v)
+INST_EXEC(vsssege256_v, execVsssege256_v)
+INST_EXEC(vsssege512_v, execVsssege512_v)
+INST_EXEC(vsssege1024_v, execVsssege1024_v)
+INST_EXEC(vluxsegei8_v, execVluxsegei8_v)
+INST_EXEC(vluxsegei16_v, execVluxsegei16_v)
+INST_EXEC(vluxsegei32_v, execVluxsegei32_v)
+INST_EXEC(vluxsegei64_v, execVluxsegei64_v)
+INST_EXEC(vluxsegei128_v, execVluxsegei128_v)
+INST_EXEC(vluxsegei256_v, execVluxsegei256_v)
+INST_EXEC(vluxsegei512_v, execVluxsegei512_v)
+INST_EXEC(vluxsegei1024_v, execVluxsegei1024_v)
+INST_EXEC(vsuxsegei8_v, execVsuxsegei8_v)
+INST_EXEC(vsuxsegei16_v, execVsuxsegei16_v)
+INST_EXEC(vsuxsegei32_v, execVsuxsegei32_v)
+INST_EXEC(vsuxsegei64_v, execVsuxsegei64_v)
+INST_EXEC(vsuxsegei128_v, execVsuxsegei128_v)
+INST_EXEC(vsuxsegei256_v, execVsuxsegei256_v)
+INST_EXEC(vsuxsegei512_v, execVsuxsegei512_v)
+INST_EXEC(vsuxsegei1024_v, execVsuxsegei1024_v)
+INST_EXEC(vloxsegei8_v, execVloxsegei8_v)
+INST_EXEC(vloxsegei16_v, execVloxsegei16_v)
+INST_EXEC(vloxsegei32_v, execVloxsegei32_v)
+INST_EXEC(vloxsegei64_v, execVloxsegei64_v)
+INST_EXEC(vloxsegei128_v, execVloxsegei128_v)
+INST_EXEC(vloxsegei256_v, execVloxsegei256_v)
+INST_EXEC(vloxsegei512_v, execVloxsegei512_v)
+INST_EXEC(vloxsegei1024_v, execVloxsegei1024_v)
+INST_EXEC(vsoxsegei8_v, execVsoxsegei8_v)
+INST_EXEC(vsoxsegei16_v, execVsoxsegei16_v)
+INST_EXEC(vsoxsegei32_v, execVsoxsegei32_v)
+INST_EXEC(vsoxsegei64_v, execVsoxsegei64_v)
+INST_EXEC(vsoxsegei128_v, execVsoxsegei128_v)
+INST_EXEC(vsoxsegei256_v, execVsoxsegei256_v)
+INST_EXEC(vsoxsegei512_v, execVsoxsegei512_v)
+INST_EXEC(vsoxsegei1024_v, execVsoxsegei1024_v)
+INST_EXEC(vlsege8ff_v, execVlsege8ff_v)
+INST_EXEC(vlsege16ff_v, execVlsege16ff_v)
+INST_EXEC(vlsege32ff_v, execVlsege32ff_v)
+INST_EXEC(vlsege64ff_v, execVlsege64ff_v)
+INST_EXEC(vlsege128ff_v, execVlsege128ff_v)
+INST_EXEC(vlsege256ff_v, execVlsege256ff_v)
+INST_EXEC(vlsege512ff_v, execVlsege512ff_v)
+INST_EXEC(vlsege1024ff_v, execVlsege1024ff_v)
+INST_EXEC(vfadd_vv, execVfadd_vv)
+INST_EXEC(vfadd_vf, execVfadd_vf)
+INST_EXEC(vfsub_vv, execVfsub_vv)
+INST_EXEC(vfsub_vf, execVfsub_vf)
+INST_EXEC(vfrsub_vf, execVfrsub_vf)
+INST_EXEC(vfwadd_vv, execVfwadd_vv)
+INST_EXEC(vfwadd_vf, execVfwadd_vf)
+INST_EXEC(vfwsub_vv, execVfwsub_vv)
+INST_EXEC(vfwsub_vf, execVfwsub_vf)
+INST_EXEC(vfwadd_wv, execVfwadd_wv)
+INST_EXEC(vfwadd_wf, execVfwadd_wf)
+INST_EXEC(vfwsub_wv, execVfwsub_wv)
+INST_EXEC(vfwsub_wf, execVfwsub_wf)
+INST_EXEC(vfmul_vv, execVfmul_vv)
+INST_EXEC(vfmul_vf, execVfmul_vf)
+INST_EXEC(vfdiv_vv, execVfdiv_vv)
+INST_EXEC(vfdiv_vf, execVfdiv_vf)
+INST_EXEC(vfrdiv_vf, execVfrdiv_vf)
+INST_EXEC(vfwmul_vv, execVfwmul_vv)
+INST_EXEC(vfwmul_vf, execVfwmul_vf)
+INST_EXEC(vfmadd_vv, execVfmadd_vv)
+INST_EXEC(vfmadd_vf, execVfmadd_vf)
+INST_EXEC(vfnmadd_vv, execVfnmadd_vv)
+INST_EXEC(vfnmadd_vf, execVfnmadd_vf)
+INST_EXEC(vfmsub_vv, execVfmsub_vv)
+INST_EXEC(vfmsub_vf, execVfmsub_vf)
+INST_EXEC(vfnmsub_vv, execVfnmsub_vv)
+INST_EXEC(vfnmsub_vf, execVfnmsub_vf)
+INST_EXEC(vfmacc_vv, execVfmacc_vv)
+INST_EXEC(vfmacc_vf, execVfmacc_vf)
+INST_EXEC(vfnmacc_vv, execVfnmacc_vv)
+INST_EXEC(vfnmacc_vf, execVfnmacc_vf)
+INST_EXEC(vfmsac_vv, execVfmsac_vv)
+INST_EXEC(vfmsac_vf, execVfmsac_vf)
+INST_EXEC(vfnmsac_vv, execVfnmsac_vv)
+INST_EXEC(vfnmsac_vf, execVfnmsac_vf)
+INST_EXEC(vfwmacc_vv, execVfwmacc_vv)
+INST_EXEC(vfwmacc_vf, execVfwmacc_vf)
+INST_EXEC(vfwnmacc_vv, execVfwnmacc_vv)
+INST_EXEC(vfwnmacc_vf, execVfwnmacc_vf)
+INST_EXEC(vfwmsac_vv, execVfwmsac_vv)
+INST_EXEC(vfwmsac_vf, execVfwmsac_vf)
+INST_EXEC(vfwnmsac_vv, execVfwnmsac_vv)
+INST_EXEC(vfwnmsac_vf, execVfwnmsac_vf)
+INST_EXEC(vfsqrt_v, execVfsqrt_v)
+INST_EXEC(vfmerge_vfm, execVfmerge_vfm)
+INST_EXEC(vfmv_v_f, execVfmv_v_f)
+INST_EXEC(vmfeq_vv, execVmfeq_vv)
+INST_EXEC(vmfeq_vf, execVmfeq_vf)
+INST_EXEC(vmfne_vv, execVmfne_vv)
+INST_EXEC(vmfne_vf, execVmfne_vf)
+INST_EXEC(vmflt_vv, execVmflt_vv)
+INST_EXEC(vmflt_vf, execVmflt_vf)
+INST_EXEC(vmfle_vv, execVmfle_vv)
+INST_EXEC(vmfle_vf, execVmfle_vf)
+INST_EXEC(vmfgt_vf, execVmfgt_vf)
+INST_EXEC(vmfge_vf, execVmfge_vf)
+INST_EXEC(vfclass_v, execVfclass_v)
+INST_EXEC(vfcvt_xu_f_v, execVfcvt_xu_f_v)
+INST_EXEC(vfcvt_x_f_v, execVfcvt_x_f_v)
+INST_EXEC(vfcvt_rtz_xu_f_v, execVfcvt_rtz_xu_f_v)
+INST_EXEC(vfcvt_rtz_x_f_v, execVfcvt_rtz_x_f_v)
+INST_EXEC(vfcvt_f_xu_v, execVfcvt_f_xu_v)
+INST_EXEC(vfcvt_f_x_v, execVfcvt_f_x_v)
+INST_EXEC(vfwcvt_xu_f_v, execVfwcvt_xu_f_v)
+INST_EXEC(vfwcvt_x_f_v, execVfwcvt_x_f_v)
+INST_EXEC(vfwcvt_rtz_xu_f_v, execVfwcvt_rtz_xu_f_v)
+INST_EXEC(vfwcvt_rtz_x_f_v, execVfwcvt_rtz_x_f_v)
+INST_EXEC(vfwcvt_f_xu_v, execVfwcvt_f_xu_v)
+INST_EXEC(vfwcvt_f_x_v, execVfwcvt_f_x_v)
+INST_EXEC(vfwcvt_f_f_v, execVfwcvt_f_f_v)
+INST_EXEC(vfncvt_xu_f_w, execVfncvt_xu_f_w)
+INST_EXEC(vfncvt_x_f_w, execVfncvt_x_f_w)
+INST_EXEC(vfncvt_rtz_xu_f_w, execVfncvt_rtz_xu_f_w)
+INST_EXEC(vfncvt_rtz_x_f_w, execVfncvt_rtz_x_f_w)
+INST_EXEC(vfncvt_f_xu_w, execVfncvt_f_xu_w)
+INST_EXEC(vfncvt_f_x_w, execVfncvt_f_x_w)
+INST_EXEC(vfncvt_f_f_w, execVfncvt_f_f_w)
+INST_EXEC(vfncvt_rod_f_f_w, execVfncvt_rod_f_f_w)
+INST_EXEC(vfredusum_vs, execVfredusum_vs)
+INST_EXEC(vfredosum_vs, execVfredosum_vs)
+INST_EXEC(vfredmin_vs, execVfredmin_vs)
+INST_EXEC(vfredmax_vs, execVfredmax_vs)
+INST_EXEC(vfwredusum_vs, execVfwredusum_vs)
+INST_EXEC(vfwredosum_vs, execVfwredosum_vs)
+INST_EXEC(vfrsqrt7_v, execVfrsqrt7_v)
+INST_EXEC(vfrec7_v, execVfrec7_v)
+INST_EXEC(vfmin_vv, execVfmin_vv)
+INST_EXEC(vfmin_vf, execVfmin_vf)
+INST_EXEC(vfmax_vv, execVfmax_vv)
+INST_EXEC(vfmax_vf, execVfmax_vf)
+INST_EXEC(vfsgnj_vv, execVfsgnj_vv)
+INST_EXEC(vfsgnj_vf, execVfsgnj_vf)
+INST_EXEC(vfsgnjn_vv, execVfsgnjn_vv)
+INST_EXEC(vfsgnjn_vf, execVfsgnjn_vf)
+INST_EXEC(vfsgnjx_vv, execVfsgnjx_vv)
+INST_EXEC(vfsgnjx_vf, execVfsgnjx_vf)
+INST_EXEC(vandn_vv, execVandn_vv)
+INST_EXEC(vandn_vx, execVandn_vx)
+INST_EXEC(vbrev_v, execVbrev_v)
+INST_EXEC(vbrev8_v, execVbrev8_v)
+INST_EXEC(vrev8_v, execVrev8_v)
+INST_EXEC(vclz_v, execVclz_v)
+INST_EXEC(vctz_v, execVctz_v)
+INST_EXEC(vcpop_v, execVcpop_v)
+INST_EXEC(vrol_vv, execVrol_vv)
+INST_EXEC(vrol_vx, execVrol_vx)
+INST_EXEC(vror_vv, execVror_vv)
+INST_EXEC(vror_vx, execVror_vx)
+INST_EXEC(vror_vi, execVror_vi)
+INST_EXEC(vwsll_vv, execVwsll_vv)
+INST_EXEC(vwsll_vx, execVwsll_vx)
+INST_EXEC(vwsll_vi, execVwsll_vi)
+INST_EXEC(vfncvtbf16_f_f_w, execVfncvtbf16_f_f_w)
+INST_EXEC(vfwcvtbf16_f_f_v, execVfwcvtbf16_f_f_v)
+INST_EXEC(vfwmaccbf16_vv, execVfwmaccbf16_vv)
+INST_EXEC(vfwmaccbf16_vf, execVfwmaccbf16_vf)
+INST_EXEC(vfncvtbf16_sat_f_f_w, execVfncvtbf16_sat_f_f_w)
+INST_EXEC(vfncvt_f_f_q, execVfncvt_f_f_q)
+INST_EXEC(vfncvt_sat_f_f_q, execVfncvt_sat_f_f_q)
+INST_EXEC(vclmul_vv, execVclmul_vv)
+INST_EXEC(vclmul_vx, execVclmul_vx)
+INST_EXEC(vclmulh_vv, execVclmulh_vv)
+INST_EXEC(vclmulh_vx, execVclmulh_vx)
+INST_EXEC(vghsh_vv, execVghsh_vv)
+INST_EXEC(vgmul_vv, execVgmul_vv)
+INST_EXEC(vaesdf_vv, execVaesdf_vv)
+INST_EXEC(vaesdf_vs, execVaesdf_vs)
+INST_EXEC(vaesef_vv, execVaesef_vv)
+INST_EXEC(vaesef_vs, execVaesef_vs)
+INST_EXEC(vaesem_vv, execVaesem_vv)
+INST_EXEC(vaesem_vs, execVaesem_vs)
+INST_EXEC(vaesdm_vv, execVaesdm_vv)
+INST_EXEC(vaesdm_vs, execVaesdm_vs)
+INST_EXEC(vaeskf1_vi, execVaeskf1_vi)
+INST_EXEC(vaeskf2_vi, execVaeskf2_vi)
+INST_EXEC(vaesz_vs, execVaesz_vs)
+INST_EXEC(vsha2ms_vv, execVsha2ms_vv)
+INST_EXEC(vsha2ch_vv, execVsha2ch_vv)
+INST_EXEC(vsha2cl_vv, execVsha2cl_vv)
+INST_EXEC(vsm4k_vi, execVsm4k_vi)
+INST_EXEC(vsm4r_vv, execVsm4r_vv)
+INST_EXEC(vsm4r_vs, execVsm4r_vs)
+INST_EXEC(vsm3me_vv, execVsm3me_vv)
+INST_EXEC(vsm3c_vi, execVsm3c_vi)
+INST_EXEC(aes32dsi, execAes32dsi)
+INST_EXEC(aes32dsmi, execAes32dsmi)
+INST_EXEC(aes32esi, execAes32esi)
+INST_EXEC(aes32esmi, execAes32esmi)
+INST_EXEC(aes64ds, execAes64ds)
+INST_EXEC(aes64dsm, execAes64dsm)
+INST_EXEC(aes64es, execAes64es)
+INST_EXEC(aes64esm, execAes64esm)
+INST_EXEC(aes64im, execAes64im)
+INST_EXEC(aes64ks1i, execAes64ks1i)
+INST_EXEC(aes64ks2, execAes64ks2)
+INST_EXEC(sha256sig0, execSha256sig0)
+INST_EXEC(sha256sig1, execSha256sig1)
+INST_EXEC(sha256sum0, execSha256sum0)
+INST_EXEC(sha256sum1, execSha256sum1)
+INST_EXEC(sha512sig0h, execSha512sig0h)
+INST_EXEC(sha512sig0l, execSha512sig0l)
+INST_EXEC(sha512sig1h, execSha512sig1h)
+INST_EXEC(sha512sig1l, execSha512sig1l)
+INST_EXEC(sha512sum0r, execSha512sum0r)
+INST_EXEC(sha512sum1r, execSha512sum1r)
+INST_EXEC(sha512sig0, execSha512sig0)
+INST_EXEC(sha512sig1, execSha512sig1)
+INST_EXEC(sha512sum0, execSha512sum0)
+INST_EXEC(sha512sum1, execSha512sum1)
+INST_EXEC(sm3p0, execSm3p0)
+INST_EXEC(sm3p1, execSm3p1)
+INST_EXEC(sm4ed, execSm4ed)
+INST_EXEC(sm4ks, execSm4ks)
+INST_EXEC(vqdot_vv, execVqdot_vv)
+INST_EXEC(vqdot_vx, execVqdot_vx)
+INST_EXEC(vqdotu_vv, execVqdotu_vv)
+INST_EXEC(vqdotu_vx, execVqdotu_vx)
+INST_EXEC(vqdotsu_vv, execVqdotsu_vv)
+INST_EXEC(vqdotsu_vx, execVqdotsu_vx)
+INST_EXEC(vqdotus_vx, execVqdotus_vx)
+INST_EXEC(vzip_vv, execVzip_vv)
+INST_EXEC(vunzipe_v, execVunzipe_v)
+INST_EXEC(vunzipo_v, execVunzipo_v)
+INST_EXEC(vpaire_vv, execVpaire_vv)
+INST_EXEC(vpairo_vv, execVpairo_vv)
+INST_EXEC(vabs_v, execVabs_v)
+INST_EXEC(vabd_vv, execVabd_vv)
+INST_EXEC(vabdu_vv, execVabdu_vv)
+INST_EXEC(vwabda_vv, execVwabda_vv)
+INST_EXEC(vwabdau_vv, execVwabdau_vv)
+INST_EXEC(sinval_vma, execSinval_vma)
+INST_EXEC(sfence_w_inval, execSfence_w_inval)
+INST_EXEC(sfence_inval_ir, execSfence_inval_ir)
+INST_EXEC(cbo_clean, execCbo_clean)
+INST_EXEC(cbo_flush, execCbo_flush)
+INST_EXEC(cbo_inval, execCbo_inval)
+INST_EXEC(cbo_zero, execCbo_zero)
+INST_EXEC(prefetch_i, execPrefetch_i)
+INST_EXEC(prefetch_r, execPrefetch_r)
+INST_EXEC(prefetch_w, execPrefetch_w)
+INST_EXEC(wrs_nto, execWrs_nto)
+INST_EXEC(wrs_sto, execWrs_sto)
+INST_EXEC(hfence_vvma, execHfence_vvma)
+INST_EXEC(hfence_gvma, execHfence_gvma)
+INST_EXEC(hlv_b, execHlv_b)
+INST_EXEC(hlv_bu, execHlv_bu)
+INST_EXEC(hlv_h, execHlv_h)
+INST_EXEC(hlv_hu, execHlv_hu)
+INST_EXEC(hlv_w, execHlv_w)
+INST_EXEC(hlvx_hu, execHlvx_hu)
+INST_EXEC(hlvx_wu, execHlvx_wu)
+INST_EXEC(hsv_b, execHsv_b)
+INST_EXEC(hsv_h, execHsv_h)
+INST_EXEC(hsv_w, execHsv_w)
+INST_EXEC(hlv_wu, execHlv_wu)
+INST_EXEC(hlv_d, execHlv_d)
+INST_EXEC(hsv_d, execHsv_d)
+INST_EXEC(hinval_vvma, execHinval_vvma)
+INST_EXEC(hinval_gvma, execHinval_gvma)
+INST_EXEC(czero_eqz, execCzero_eqz)
+INST_EXEC(czero_nez, execCzero_nez)
+INST_EXEC_ZC(c_lbu, isRvzcb, execLbu)
+INST_EXEC_ZC(c_lhu, isRvzcb, execLhu)
+INST_EXEC_ZC(c_lh, isRvzcb, execLh)
+INST_EXEC_ZC(c_sb, isRvzcb, execSb)
+INST_EXEC_ZC(c_sh, isRvzcb, execSh)
+INST_EXEC_ZC(c_zext_b, isRvzcb, execAndi)
+INST_EXEC_ZC(c_sext_b, isRvzcb, execSext_b)
+INST_EXEC_ZC(c_zext_h, isRvzcb, execC_zext_h)
+INST_EXEC_ZC(c_sext_h, isRvzcb, execSext_h)
+INST_EXEC_ZC(c_zext_w, isRvzcb, execAdd_uw)
+INST_EXEC_ZC(c_not, isRvzcb, execXori)
+INST_EXEC_ZC(c_mul, isRvzcb, execMul)
+
+// Zfa
+INST_EXEC(fcvtmod_w_d, execFcvtmod_w_d)
+INST_EXEC(fli_h, execFli_h)
+INST_EXEC(fli_s, execFli_s)
+INST_EXEC(fli_d, execFli_d)
+INST_EXEC(fleq_h, execFleq_h)
+INST_EXEC(fleq_s, execFleq_s)
+INST_EXEC(fleq_d, execFleq_d)
+INST_EXEC(fltq_h, execFltq_h)
+INST_EXEC(fltq_s, execFltq_s)
+INST_EXEC(fltq_d, execFltq_d)
+INST_EXEC(fmaxm_h, execFmaxm_h)
+INST_EXEC(fmaxm_s, execFmaxm_s)
+INST_EXEC(fmaxm_d, execFmaxm_d)
+INST_EXEC(fminm_h, execFminm_h)
+INST_EXEC(fminm_s, execFminm_s)
+INST_EXEC(fminm_d, execFminm_d)
+INST_EXEC(fmvh_x_d, execFmvh_x_d)
+INST_EXEC(fmvp_d_x, execFmvp_d_x)
+INST_EXEC(fround_h, execFround_h)
+INST_EXEC(fround_s, execFround_s)
+INST_EXEC(fround_d, execFround_d)
+INST_EXEC(froundnx_h, execFroundnx_h)
+INST_EXEC(froundnx_s, execFroundnx_s)
+INST_EXEC(froundnx_d, execFroundnx_d)
+INST_EXEC(amocas_w, execAmocas_w)
+INST_EXEC(amocas_d, execAmocas_d)
+INST_EXEC(amocas_q, execAmocas_q)
+INST_EXEC(mop_r, execMop_r)
+INST_EXEC(mop_rr, execMop_rr)
+INST_EXEC(c_mop, execCmop)
+INST_EXEC(ssamoswap_w, execSsamoswap_w)
+INST_EXEC(ssamoswap_d, execSsamoswap_d)
+INST_EXEC(mcspspush, execMcspspush)
+INST_EXEC(mcspspop, execMcspspop)
+INST_EXEC(scspspush, execScspspush)
+INST_EXEC(scspspop, execScspspop)
+INST_EXEC(mipopret, execMipopret)
+INST_EXEC(sipopret, execSipopret)
+INST_EXEC(vqwdotau_vv, execVqwdotau_vv)
+INST_EXEC(vqwdotas_vv, execVqwdotas_vv)
+INST_EXEC(vqwbdotau_vv, execVqwbdotau_vv)
+INST_EXEC(vqwbdotas_vv, execVqwbdotas_vv)
+INST_EXEC(vfbdota_vv, execVfbdota_vv)
+INST_EXEC(vfwdota_vv, execVfwdota_vv)
+INST_EXEC(vfqwdota_vv, execVfqwdota_vv)
+INST_EXEC(vfqwbdota_vv, execVfqwbdota_vv)
+INST_EXEC(vfwbdota_vv, execVfwbdota_vv)
+
+#undef INST_EXEC
+#undef INST_EXEC_ZC
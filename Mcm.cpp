@@ -17,13 +17,21 @@ Mcm<URV>::Mcm(unsigned hartCount, unsigned pageSize, unsigned lineSize)
   assert(lineSize_ == (1u << lineShift_));  // Must have a power of 2 line size.
   assert(pageSize_ == (1u << pageShift_));  // Must have a power of 2 page size.
 
-  sysMemOps_.reserve(200000);
+  // Reclaimed operations and instructions read as canceled operations and as old,
+  // retired, drained non-memory instructions.
+  MemoryOp reclaimedOp;
+  reclaimedOp.cancel();
+  sysMemOps_ = MemoryOpWindow(reclaimedOp);
+
+  McmInstr reclaimedInstr;
+  reclaimedInstr.retired_ = true;
+  reclaimedInstr.complete_ = true;
 
   hartData_.resize(hartCount);
 
   for (auto& hd : hartData_)
     {
-      hd.instrVec_.resize(200000);
+      hd.instrVec_ = McmInstrVec(reclaimedInstr);
       hd.regTime_.resize(totalRegCount_);
       hd.regProducer_.resize(totalRegCount_);
     }
@@ -194,56 +202,26 @@ Mcm<URV>::readOp_(Hart<URV>& hart, uint64_t time, uint64_t tag, uint64_t pa, uns
     op.failRead_ = true;
 
   if (sysMemOps_.empty() or sysMemOps_.back().time_ <= time)
-    {
-      instr->addMemOp(sysMemOps_.size());
-      sysMemOps_.push_back(op);
-    }
+    appendMemOp(*instr, op);
   else
     {
       // Sometimes the test-bench will unexpectedly send us a read-op with an out of order
       // time-stamp. We hack a repair.
 
-      // Find first existing op with time > current time.
-      auto iter = std::upper_bound(sysMemOps_.begin(), sysMemOps_.end(), time,
-                                   [](const uint64_t& t, const MemoryOp& mop) -> bool
-                                   { return t < mop.time_; });
-
-      // Insert new op before the found op.
-      assert(iter != sysMemOps_.end());
-      size_t ix = iter - sysMemOps_.begin();
-      sysMemOps_.insert(iter, op);
-
-      // Adjust indices of all the instructions referencing ops that are now after new op
-      // in sysMemOps_.
-
-      // One set of adjusted tags per hart.
-      std::vector< std::unordered_set<uint64_t> > adjustedTags(hartData_.size()); 
+      // The new op gets the next id and is placed in time order among the ids of the
+      // other ops which keep their ids.
+      uint64_t pos = insertLateMemOp(*instr, op);
+      MemoryOpIx ix = sysMemOps_.size() - 1;
 
       bool movedWrite = false;
-      for (size_t i = ix + 1; i < sysMemOps_.size(); ++i)
+      for (uint64_t i = pos + 1; i < opOrder_.size() and not movedWrite; ++i)
         {
-          auto& movedOp = sysMemOps_.at(i);
-          auto& instrVec = hartData_.at(movedOp.hartIx_).instrVec_;
-
-          auto& tagSet = adjustedTags.at(movedOp.hartIx_);
-          auto tag = movedOp.tag_;
-          if (tagSet.contains(tag))
+          const auto& movedOp = sysMemOps_.at(opOrder_.at(i));
+          if (movedOp.isCanceled())
             continue;
-          tagSet.insert(tag);
-
-          auto& instr = instrVec.at(tag);
-          for (auto& instrOpIx : instr.memOps_)
-            if (instrOpIx >= ix)
-              {
-                instrOpIx++;
-                movedWrite = movedWrite or instr.isStore_;
-              }
+          movedWrite = hartData_.at(movedOp.hartIx_).instrVec_.at(movedOp.tag_).isStore_;
         }
 
-      // Associate new op with instruction. This has to be done after the indices are
-      // adjusted otherwise we may get an "op already added" error.
-      instr->addMemOp(ix);
-
       std::cerr << "Warning: hart-id=" << hartIx << " tag=" << op.tag_
                 << " detected non-monotonic time read at time=" << time;
 
@@ -271,7 +249,7 @@ McmInstr*
 Mcm<URV>::findInstr(unsigned hartIx, uint32_t tag)
 {
   auto& vec = hartData_.at(hartIx).instrVec_;
-  if (tag < vec.size() and vec.at(tag).tag_ == tag)
+  if (tag >= vec.base() and tag < vec.size() and vec.at(tag).tag_ == tag)
     return &(vec.at(tag));
   return nullptr;
 }
@@ -286,9 +264,20 @@ Mcm<URV>::findOrAddInstr(unsigned hartIx, uint32_t tag)
     return ptr;
 
   auto& vec = hartData_.at(hartIx).instrVec_;
+  if (tag < vec.base())
+    {
+      cerr << "Error: MCM: hart-ix=" << hartIx << " tag=" << tag << " refers to an "
+           << "instruction that retired and was reclaimed\n";
+      staleInstr_ = McmInstr{};
+      staleInstr_.tag_ = tag;
+      staleInstr_.hartIx_ = hartIx;
+      staleInstr_.cancel();
+      return &staleInstr_;
+    }
+
   if (tag >= vec.size())
     {
-      if (tag > 500000000)
+      if (tag - vec.base() > maxTagSpan_)
 	{
 	  cerr << "Error: MCM: Instruction tag way too large: " << tag << '\n';
 	  cerr << "Error: MCM: Code expects dense consecutive tags starting at 0\n";
@@ -314,6 +303,142 @@ Mcm<URV>::findOrAddInstr(unsigned hartIx, uint32_t tag)
 }
 
 
+template <typename URV>
+void
+Mcm<URV>::appendMemOp(McmInstr& instr, const MemoryOp& op)
+{
+  MemoryOpIx ix = sysMemOps_.size();
+  instr.addMemOp(ix);
+  sysMemOps_.push_back(op);
+  opOrder_.push_back(ix);
+  hartData_.at(op.hartIx_).memOps_.push_back(ix);
+}
+
+
+template <typename URV>
+uint64_t
+Mcm<URV>::insertLateMemOp(McmInstr& instr, const MemoryOp& op)
+{
+  MemoryOpIx ix = sysMemOps_.size();
+  sysMemOps_.push_back(op);
+
+  // Insert the id after those of the ops with time <= time of op.
+  auto later = [this, &op](MemoryOpIx other) { return sysMemOps_.at(other).time_ > op.time_; };
+  auto insertInTimeOrder = [&later, ix](auto& ids) {
+    auto iter = std::find_if(ids.rbegin(), ids.rend(), [&later](MemoryOpIx other) {
+      return not later(other); });
+    return ids.insert(iter.base(), ix);
+  };
+
+  insertInTimeOrder(instr.memOps_);
+  insertInTimeOrder(hartData_.at(op.hartIx_).memOps_);
+
+  auto iter = insertInTimeOrder(opOrder_);
+  return iter - opOrder_.begin();
+}
+
+
+template <typename URV>
+uint64_t
+Mcm<URV>::orderPosition(MemoryOpIx ix) const
+{
+  // Without late ops the ids in opOrder_ are consecutive.
+  if (not opOrder_.empty() and ix >= opOrder_.front())
+    {
+      uint64_t pos = ix - opOrder_.front();
+      if (pos < opOrder_.size() and opOrder_.at(pos) == ix)
+        return pos;
+    }
+  auto iter = std::find(opOrder_.begin(), opOrder_.end(), ix);
+  return iter - opOrder_.begin();
+}
+
+
+template <typename URV>
+void
+Mcm<URV>::reclaimWindow()
+{
+  // Advance the oldest unfinished instruction of each hart.
+  for (auto& hd : hartData_)
+    {
+      const auto& vec = hd.instrVec_;
+      hd.liveTag_ = std::max(hd.liveTag_, vec.base());
+      while (hd.liveTag_ < vec.size() and isFinished(vec.at(hd.liveTag_)))
+	hd.liveTag_++;
+    }
+
+  auto isReclaimable = [this] (const MemoryOp& op) {
+    return op.tag_ + windowSlack_ < hartData_.at(op.hartIx_).liveTag_;
+  };
+
+  // Operations are reclaimable up to the first one belonging to a recent or
+  // unfinished instruction. Backward scans of the PPO rules stop before the earliest
+  // operation of the instruction being checked: reclaim only operations older than all
+  // the remaining ones (some bypass ops arrive out of time order) and older than any
+  // future operation.
+  uint64_t stop = sysMemOps_.base();
+  while (stop < sysMemOps_.size() and isReclaimable(sysMemOps_.at(stop)))
+    stop++;
+
+  bool hasCandidate = stop != sysMemOps_.base();
+  for (const auto& hd : hartData_)
+    hasCandidate = hasCandidate or hd.instrVec_.base() + windowSlack_ < hd.liveTag_;
+
+  uint64_t horizon = time_;
+  if (hasCandidate)
+    for (uint64_t ix = stop; ix < sysMemOps_.size(); ++ix)
+      horizon = std::min(horizon, sysMemOps_.at(ix).time_);
+
+  uint64_t reclaimed = 0;
+
+  while (hasCandidate and sysMemOps_.base() < stop and sysMemOps_.front().time_ < horizon)
+    {
+      sysMemOps_.pop_front();
+      reclaimed++;
+    }
+
+  // A late op keeps the ids of reclaimed ops queued behind it: those read as canceled.
+  while (not opOrder_.empty() and opOrder_.front() < sysMemOps_.base())
+    opOrder_.pop_front();
+
+  // Instructions are reclaimable once their operations are gone and they retired
+  // before the horizon (rule 4 and rule 11 compare retire times).
+  for (auto& hd : hartData_)
+    {
+      auto& vec = hd.instrVec_;
+      while (hasCandidate and not vec.empty() and vec.base() + windowSlack_ < hd.liveTag_)
+	{
+	  const auto& instr = vec.front();
+	  if (instr.retired_ and instr.retireTime_ >= horizon)
+	    break;
+	  if (std::ranges::any_of(instr.memOps_, [this] (MemoryOpIx ix) {
+		return ix >= sysMemOps_.base(); }))
+	    break;
+	  vec.pop_front();
+	  reclaimed++;
+	}
+
+      while (not hd.memOps_.empty() and hd.memOps_.front() < sysMemOps_.base())
+	hd.memOps_.pop_front();
+
+      auto& refMap = hd.vecRefMap_;
+      refMap.erase(refMap.begin(), refMap.lower_bound(vec.base()));
+
+      for (auto* marks : { &hd.fences_, &hd.cmos_ })
+	while (not marks->empty() and marks->front().tag_ < vec.base())
+	  marks->pop_front();
+    }
+
+  // Back off while an unfinished instruction (e.g. a store that never drains) pins the
+  // window: finding the horizon costs a pass over the window.
+  if (reclaimed)
+    reclaimPeriod_ = minReclaimPeriod_;
+  else
+    reclaimPeriod_ = std::min(2 * reclaimPeriod_, maxReclaimPeriod_);
+  nextReclaim_ = retireCount_ + reclaimPeriod_;
+}
+
+
 template <typename URV>
 void
 Mcm<URV>::setBranchMemTime(const Hart<URV>& hart, const McmInstr& instr)
@@ -1031,8 +1156,7 @@ Mcm<URV>::bypassOp(Hart<URV>& hart, uint64_t time, uint64_t tag, uint64_t pa,
   op.cache_ = cache;
 
   // Associate write op with instruction.
-  instr->addMemOp(sysMemOps_.size());
-  sysMemOps_.push_back(op);
+  appendMemOp(*instr, op);
 
   result = pokeHartMemory(hart, pa, rtlData, size, cache) and result;
   
@@ -1258,6 +1382,9 @@ Mcm<URV>::retire(Hart<URV>& hart, uint64_t time, uint64_t tag,
   if (not updateTime("Mcm::retire", time))
     return false;
 
+  if (++retireCount_ >= nextReclaim_)
+    reclaimWindow();
+
   McmInstr* instr = findOrAddInstr(hartIx, tag);
   if (instr->retired_)
     {
@@ -1286,6 +1413,15 @@ Mcm<URV>::retire(Hart<URV>& hart, uint64_t time, uint64_t tag,
   instr->retireTime_ = time;
   instr->di_ = di;
 
+  auto& hd = hartData_.at(hartIx);
+  for (auto* marks : { &hd.fences_, &hd.cmos_ })
+    for (auto iter = marks->rbegin(); iter != marks->rend() and iter->time_ > time; ++iter)
+      iter->time_ = time;   // Time went backward.
+  if (di.isFence())
+    hd.fences_.push_back({McmInstrIx(tag), time});
+  else if (di.extension() == RvExtension::Zicbom)
+    hd.cmos_.push_back({McmInstrIx(tag), time});
+
   bool ok = true;
   if (di.isLoad() or di.isAmo() or di.isVectorLoad())
     instr->isLoad_ = true;
@@ -1548,8 +1684,7 @@ Mcm<URV>::collectCoveredWrites(Hart<URV>& hart, uint64_t time, uint64_t rtlAddr,
     {
       op.time_ = time;
       McmInstr* instr = findOrAddInstr(hartIx, op.tag_);
-      instr->addMemOp(sysMemOps_.size());
-      sysMemOps_.push_back(op);
+      appendMemOp(*instr, op);
     }
 
   return ok;
@@ -1759,11 +1894,9 @@ Mcm<URV>::cancelNonRetired(Hart<URV>& hart, uint64_t tag)
   unsigned hartIx = hart.sysHartIndex();
   auto& vec = hartData_.at(hartIx).instrVec_;
 
-  if (vec.empty())
-    return;
-
-  if (tag >= vec.size())
-    tag = vec.size();
+  // Tags never seen below the given one are canceled as well.
+  if (tag >= vec.base() and tag - vec.base() <= maxTagSpan_)
+    vec.resize(tag);
 
   while (tag)
     {
@@ -2402,9 +2535,9 @@ Mcm<URV>::commitVecReadOpsStride0(Hart<URV>& hart, McmInstr& instr)
   if (refs.empty())
     {
       // No active elements. Remove read-ops marked canceled.
-      std::erase_if(ops, [this](MemoryOpIx ix) {
+      ops.erase(std::remove_if(ops.begin(), ops.end(), [this](MemoryOpIx ix) {
         return ix >= sysMemOps_.size() or sysMemOps_.at(ix).isCanceled();
-      });
+      }), ops.end());
       return true;
     }
 
@@ -2422,7 +2555,7 @@ Mcm<URV>::commitVecReadOpsStride0(Hart<URV>& hart, McmInstr& instr)
         assert(0);
     }
 
-  for (unsigned int opIx : std::ranges::reverse_view(ops))
+  for (MemoryOpIx opIx : std::ranges::reverse_view(ops))
     {
       auto& op = sysMemOps_.at(opIx);
       if (not op.isRead_)
@@ -2473,9 +2606,9 @@ Mcm<URV>::commitVecReadOpsStride0(Hart<URV>& hart, McmInstr& instr)
     }
 
   // Remove ops still marked canceled.
-  std::erase_if(ops, [this](MemoryOpIx ix) {
+  ops.erase(std::remove_if(ops.begin(), ops.end(), [this](MemoryOpIx ix) {
     return ix >= sysMemOps_.size() or sysMemOps_.at(ix).isCanceled();
-  });
+  }), ops.end());
 
   return instr.complete_ and matched;
 }
@@ -2501,7 +2634,7 @@ Mcm<URV>::commitVecReadOpsUnitStride(Hart<URV>& hart, McmInstr& instr)
 
   bool ok = true;
 
-  for (unsigned int opIx : std::ranges::reverse_view(ops))
+  for (MemoryOpIx opIx : std::ranges::reverse_view(ops))
     {
       auto& op = sysMemOps_.at(opIx);
       if (not op.isRead_)
@@ -2549,9 +2682,9 @@ Mcm<URV>::commitVecReadOpsUnitStride(Hart<URV>& hart, McmInstr& instr)
     }
 
   // Remove ops still marked canceled.
-  std::erase_if(ops, [this](MemoryOpIx ix) {
+  ops.erase(std::remove_if(ops.begin(), ops.end(), [this](MemoryOpIx ix) {
     return ix >= sysMemOps_.size() or sysMemOps_.at(ix).isCanceled();
-  });
+  }), ops.end());
 
   // Check that all reference addresses are covered by the read operations.
   instr.complete_ = true;
@@ -2639,7 +2772,7 @@ Mcm<URV>::commitVecReadOps(Hart<URV>& hart, McmInstr& instr)
 
   bool ok = true;
 
-  for (unsigned int opIx : std::ranges::reverse_view(ops))
+  for (MemoryOpIx opIx : std::ranges::reverse_view(ops))
     {
       auto& op = sysMemOps_.at(opIx);
       if (not op.isRead_)
@@ -2689,9 +2822,9 @@ Mcm<URV>::commitVecReadOps(Hart<URV>& hart, McmInstr& instr)
     }
 
   // Remove ops still marked canceled.
-  std::erase_if(ops, [this](MemoryOpIx ix) {
+  ops.erase(std::remove_if(ops.begin(), ops.end(), [this](MemoryOpIx ix) {
     return ix >= sysMemOps_.size() or sysMemOps_.at(ix).isCanceled();
-  });
+  }), ops.end());
 
   // Check that all reference addresses are covered by the read operations.
   instr.complete_ = true;
@@ -2760,9 +2893,9 @@ Mcm<URV>::commitReadOps(Hart<URV>& hart, McmInstr& instr)
     }
 
   // Remove canceled ops.
-  std::erase_if(ops, [this](MemoryOpIx ix) {
+  ops.erase(std::remove_if(ops.begin(), ops.end(), [this](MemoryOpIx ix) {
     return ix >= sysMemOps_.size() or sysMemOps_.at(ix).isCanceled();
-  });
+  }), ops.end());
 
   // Check read operations of instruction comparing RTL values to model (whisper) values.
   bool ok = true;
@@ -2907,7 +3040,7 @@ Mcm<URV>::getCurrentLoadValue(Hart<URV>& hart, uint64_t tag, uint64_t va, uint64
 	byteAddr = pa2 + byteIx - size1;
 
       bool byteCovered = false;
-      for (unsigned int & memOp : std::ranges::reverse_view(instr->memOps_))
+      for (MemoryOpIx memOp : std::ranges::reverse_view(instr->memOps_))
 	{
 	  const auto& op = sysMemOps_.at(memOp);
           if (isVector and not unitStride)
@@ -3007,7 +3140,7 @@ Mcm<URV>::vecStoreToReadForward(const McmInstr& store, MemoryOp& readOp, uint64_
 
       // Count write ops overlapping byte addr. Identify last overlapping write op.
       unsigned writeCount = 0;
-      unsigned lastWopIx = 0;
+      MemoryOpIx lastWopIx = 0;
       for (const auto wopIx : store.memOps_)
 	{
 	  const auto& wop = sysMemOps_.at(wopIx);
@@ -3181,8 +3314,9 @@ Mcm<URV>::collectForwardingStores(Hart<URV>& hart, const McmInstr& instr,
       if (not rop.isRead_)
 	continue;
 
-      for (const auto & wop : std::ranges::reverse_view(sysMemOps_))
+      for (auto wopIx : std::ranges::reverse_view(opOrder_))
 	{
+	  const auto& wop = sysMemOps_.at(wopIx);
 	  if (wop.time_ < rop.time_)
             {
               if (wop.bypass_)
@@ -3712,9 +3846,10 @@ Mcm<URV>::ppoRule1(Hart<URV>& hart, const McmInstr& instrB) const
   // Process all the memory operations that may have been reordered with respect to B. If
   // an instruction A, preceding B in program order, is missing a memory operation, we
   // will catch it when we process the un-drained stores below.
-  for (const auto & op : std::ranges::reverse_view(sysMemOps_))
+  for (auto opIx : std::ranges::reverse_view(hartData_.at(hartIx).memOps_))
     {
-      if (op.isCanceled()  or  op.hartIx_ != hartIx  or  op.tag_ >= instrB.tag_)
+      const auto& op = sysMemOps_.at(opIx);
+      if (op.isCanceled()  or  op.tag_ >= instrB.tag_)
 	continue;
 
       if (op.time_ < earlyB)
@@ -3761,11 +3896,10 @@ Mcm<URV>::ppoRule2(Hart<URV>& hart, const McmInstr& instrB) const
   unsigned hartIx = hart.sysHartIndex();
   const auto& instrVec = hartData_.at(hartIx).instrVec_;
 
-  for (auto iter = sysMemOps_.rbegin(); iter != sysMemOps_.rend(); ++iter)
+  for (auto opIx : std::ranges::reverse_view(hartData_.at(hartIx).memOps_))
     {
-      const auto& op = *iter;
-      if (op.isCanceled() or op.hartIx_ != hartIx or op.tag_ >= instrB.tag_
-          or not op.isRead_)
+      const auto& op = sysMemOps_.at(opIx);
+      if (op.isCanceled() or op.tag_ >= instrB.tag_ or not op.isRead_)
 	continue;
 
       if (op.time_ < earlyB)
@@ -3786,12 +3920,12 @@ Mcm<URV>::ppoRule2(Hart<URV>& hart, const McmInstr& instrB) const
 	       << hart.hartId() << " tag1=" << instrA.tag_ << " tag2=" << instrB.tag_ << '\n';
 	  return false;
 	}
-      uint64_t ix0 = instrB.memOps_.front();
-      uint64_t ix1 = instrA.memOps_.back();
+      uint64_t pos0 = orderPosition(instrB.memOps_.front());
+      uint64_t pos1 = orderPosition(instrA.memOps_.back());
 
-      for (uint64_t ix = ix0; ix <= ix1; ++ix)
+      for (uint64_t pos = pos0; pos <= pos1 and pos < opOrder_.size(); ++pos)
 	{
-	  const MemoryOp& remoteOp = sysMemOps_.at(ix);
+	  const MemoryOp& remoteOp = sysMemOps_.at(opOrder_.at(pos));
 	  if (remoteOp.isCanceled() or remoteOp.hartIx_ == hartIx or remoteOp.isRead_)
 	    continue;
 
@@ -3852,10 +3986,10 @@ Mcm<URV>::ppoRule3(Hart<URV>& hart, const McmInstr& instrB) const
   unsigned hartIx = hart.sysHartIndex();
   const auto& instrVec = hartData_.at(hartIx).instrVec_;
 
-  for (auto iter = sysMemOps_.rbegin(); iter != sysMemOps_.rend(); ++iter)
+  for (auto opIx : std::ranges::reverse_view(hartData_.at(hartIx).memOps_))
     {
-      const auto& op = *iter;
-      if (op.isCanceled() or op.hartIx_ != hartIx or op.tag_ >= instrB.tag_)
+      const auto& op = sysMemOps_.at(opIx);
+      if (op.isCanceled() or op.tag_ >= instrB.tag_)
 	continue;
 
       if (op.time_ < earlyB)
@@ -4169,27 +4303,27 @@ Mcm<URV>::ppoRule4(Hart<URV>& hart, const McmInstr& instrB) const
     }
 
 
-  // Collect all fence instructions that can affect B.
+  // Collect all fence instructions that can affect B: those retired at or after the
+  // earliest op of B.
   std::vector<McmInstrIx> fences;
-  for (McmInstrIx ix = instrB.tag_; ix > 0; --ix)
+  const auto& marks = hartData_.at(hartIx).fences_;
+  for (auto iter = marks.rbegin(); iter != marks.rend(); ++iter)
     {
-      McmInstrIx tag = ix - 1;
-      const auto& instr = instrVec.at(tag);
-      if (instr.isCanceled())
+      if (iter->tag_ >= instrB.tag_)
 	continue;
-      if (instr.retireTime_ < earlyB)
+      if (iter->time_ < earlyB)
 	break;
-      if (instr.di_.isFence())
-	fences.push_back(tag);
+      fences.push_back(iter->tag_);
     }
   if (fences.empty())
     return true;
 
   // Collect all memory ops out of order with respect to B.
   std::vector<const MemoryOp*> reordered;
-  for (const auto & op : std::ranges::reverse_view(sysMemOps_))
+  for (auto opIx : std::ranges::reverse_view(hartData_.at(hartIx).memOps_))
     {
-      if (op.canceled_ or op.hartIx_ != hartIx or op.tag_ >= instrB.tag_)
+      const auto& op = sysMemOps_.at(opIx);
+      if (op.canceled_ or op.tag_ >= instrB.tag_)
 	continue;
       if (op.time_ < earlyB)
 	break;
@@ -4282,17 +4416,17 @@ Mcm<URV>::ppoRule4(Hart<URV>& hart, const McmInstr& instrB) const
                         continue;
 
                       // Look for a store from another hart between predecessor and successor times.
-                      auto low = std::lower_bound(sysMemOps_.begin(), sysMemOps_.end(), succTime,
-                                                  [](const MemoryOp& op, const uint64_t& t) -> bool
-                                                  { return op.time_ < t; });
+                      auto low = std::lower_bound(opOrder_.begin(), opOrder_.end(), succTime,
+                                                  [this](MemoryOpIx ix, const uint64_t& t) -> bool
+                                                  { return sysMemOps_.at(ix).time_ < t; });
 
-                      auto high = std::upper_bound(low, sysMemOps_.end(), predTime,
-                                                   [](const uint64_t& t, const MemoryOp& op) -> bool
-                                                   { return t < op.time_; });
+                      auto high = std::upper_bound(low, opOrder_.end(), predTime,
+                                                   [this](const uint64_t& t, MemoryOpIx ix) -> bool
+                                                   { return t < sysMemOps_.at(ix).time_; });
 
                       for (auto iter = low; iter != high and not fail; ++iter)
                         {
-                          auto& op = *iter;
+                          auto& op = sysMemOps_.at(*iter);
                           if (op.hartIx_ == hartIx or isCbomOp(op) or op.isRead_ or
                               lineNum(op.pa_) != lineNum(addr))
                             continue;
@@ -4351,9 +4485,9 @@ Mcm<URV>::ppoRule5(Hart<URV>& hart, const McmInstr& instrA, const McmInstr& inst
 
   // B performs before A -- Allow if there is no write from another hart, overlapping line
   // of B, at time between times of A and B.
-  for (size_t ix = sysMemOps_.size(); ix != 0; ix--)
+  for (auto opIx : std::ranges::reverse_view(opOrder_))
     {
-      const auto& op = sysMemOps_.at(ix-1);
+      const auto& op = sysMemOps_.at(opIx);
       if (op.isCanceled() or op.time_ > timeA or op.isRead_ or op.hartIx_ == hartIx)
 	continue;
 
@@ -4431,9 +4565,10 @@ Mcm<URV>::ppoRule5(Hart<URV>& hart, const McmInstr& instrB) const
 
   auto earlyB = effectiveMinTime(hart, instrB);
 
-  for (const auto & op : std::ranges::reverse_view(sysMemOps_))
+  for (auto opIx : std::ranges::reverse_view(hartData_.at(hartIx).memOps_))
     {
-      if (op.isCanceled() or op.hartIx_ != hartIx or op.tag_ >= instrB.tag_)
+      const auto& op = sysMemOps_.at(opIx);
+      if (op.isCanceled() or op.tag_ >= instrB.tag_)
 	continue;
       if (op.time_ < earlyB)
 	break;
@@ -4530,9 +4665,10 @@ Mcm<URV>::ppoRule6(Hart<URV>& hart, const McmInstr& instrB) const
 
   auto earlyB = earliestOpTime(instrB);
 
-  for (const auto & op : std::ranges::reverse_view(sysMemOps_))
+  for (auto opIx : std::ranges::reverse_view(hartData_.at(hartIx).memOps_))
     {
-      if (op.isCanceled()  or  op.hartIx_ != hartIx  or  op.tag_ >= instrB.tag_)
+      const auto& op = sysMemOps_.at(opIx);
+      if (op.isCanceled()  or  op.tag_ >= instrB.tag_)
 	continue;
       if (op.time_ < earlyB)
 	break;
@@ -4620,9 +4756,9 @@ Mcm<URV>::ppoRule7(const McmInstr& instrA, const McmInstr& instrB) const
 
   unsigned hartIx = sysMemOps_.at(instrB.memOps_.at(0)).hartIx_;
 
-  for (size_t ix = sysMemOps_.size(); ix != 0; ix--)
+  for (auto opIx : std::ranges::reverse_view(opOrder_))
     {
-      const auto& op = sysMemOps_.at(ix-1);
+      const auto& op = sysMemOps_.at(opIx);
       if (op.isCanceled() or op.time_ > atime or op.isRead_ or op.hartIx_ == hartIx)
 	continue;
 
@@ -4671,9 +4807,10 @@ Mcm<URV>::ppoRule7(Hart<URV>& hart, const McmInstr& instrB) const
 
   auto earlyB = earliestOpTime(instrB);
 
-  for (const auto & op : std::ranges::reverse_view(sysMemOps_))
+  for (auto opIx : std::ranges::reverse_view(hartData_.at(hartIx).memOps_))
     {
-      if (op.isCanceled()  or  op.hartIx_ != hartIx  or  op.tag_ >= instrB.tag_)
+      const auto& op = sysMemOps_.at(opIx);
+      if (op.isCanceled()  or  op.tag_ >= instrB.tag_)
 	continue;
       if (op.time_ < earlyB)
 	break;
@@ -4725,9 +4862,10 @@ Mcm<URV>::ppoRule8(Hart<URV>& hart, const McmInstr& instrB) const
 
   auto earlyB = earliestOpTime(instrB);
 
-  for (const auto & op : std::ranges::reverse_view(sysMemOps_))
+  for (auto opIx : std::ranges::reverse_view(hartData_.at(hartIx).memOps_))
     {
-      if (op.isCanceled()  or  op.hartIx_ != hartIx  or  op.tag_ >= instrB.tag_)
+      const auto& op = sysMemOps_.at(opIx);
+      if (op.isCanceled()  or  op.tag_ >= instrB.tag_)
 	continue;
       if (op.time_ < earlyB)
 	break;
@@ -5027,9 +5165,10 @@ Mcm<URV>::getMinReadTagWithLargerTime(unsigned hartIx, const McmInstr& instr) co
 
   McmInstrIx minTag = instr.tag_;
 
-  for (const auto & op : std::ranges::reverse_view(sysMemOps_))
+  for (auto opIx : std::ranges::reverse_view(hartData_.at(hartIx).memOps_))
     {
-      if (op.canceled_ or op.hartIx_ != hartIx or not op.isRead_)
+      const auto& op = sysMemOps_.at(opIx);
+      if (op.canceled_ or not op.isRead_)
 	continue;
 
       if (op.time_ > eot)
@@ -5377,9 +5516,10 @@ Mcm<URV>::ioPpoChecks(Hart<URV>& hart, const McmInstr& instrB) const
 	continue; // No IO memory ops.
 
       // Identify IO ops reordered with respect to B.
-      for (const auto & op : std::ranges::reverse_view(sysMemOps_))
+      for (auto opIx : std::ranges::reverse_view(hartData_.at(hartIx).memOps_))
 	{
-	  if (op.isCanceled() or op.hartIx_ != hartIx or op.tag_ >= instrB.tag_ or not op.isIo_)
+	  const auto& op = sysMemOps_.at(opIx);
+	  if (op.isCanceled() or op.tag_ >= instrB.tag_ or not op.isIo_)
 	    continue;
 	  
 	  if (op.isRead_ != isRead)
@@ -5503,18 +5643,17 @@ Mcm<URV>::checkLoadVsPriorCmo(Hart<URV>& hart, const McmInstr& instrB) const
 
   auto earlyB = effectiveMinTime(hart, instrB);
 
-  for (auto ix = instrB.tag_; ix > 0; --ix)
+  // Visit the cbo.flush/clean/inval instructions retired at or after earlyB.
+  const auto& marks = hartData_.at(hartIx).cmos_;
+  for (auto iter = marks.rbegin(); iter != marks.rend(); ++iter)
     {
-      const auto& instrA = instrVec.at(ix-1);
-
-      if (instrA.isCanceled() or not instrA.isRetired())
+      if (iter->tag_ >= instrB.tag_)
 	continue;
 
-      if (earlyB > instrA.retireTime_)
+      if (earlyB > iter->time_)
 	break;
 
-      if (instrA.di_.extension() != RvExtension::Zicbom)
-        continue;  // Not cbo.flush/clean/inval
+      const auto& instrA = instrVec.at(iter->tag_);
 
       auto aTime = instrA.retireTime_;
       if (instrA.memOps_.size() == 1)   // CMO instrs have at most 1 bypass op
@@ -5560,9 +5699,9 @@ Mcm<URV>::checkSfenceInvalIr(Hart<URV>& hart, const McmInstr& instr) const
 
   auto invalTime = hartData_.at(hartIx).sinvalVmaTime_;
 
-  for (size_t ix = sysMemOps_.size(); ix > 0; --ix)
+  for (auto opIx : std::ranges::reverse_view(opOrder_))
     {
-      const auto& op = sysMemOps_.at(ix-1);
+      const auto& op = sysMemOps_.at(opIx);
       if (op.canceled_ or op.hartIx_ != hartIx)
 	continue;
       if (op.tag_ < instr.tag_)
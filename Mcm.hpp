@@ -2,12 +2,14 @@
 
 #include <vector>
 #include <array>
+#include <deque>
 #include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <set>
 #include <map>
 #include <unordered_set>
+#include <boost/container/small_vector.hpp>
 #include "DecodedInst.hpp"
 #include "Hart.hpp"
 
@@ -18,7 +20,7 @@ namespace WdRiscv
   class Hart;
 
   using McmInstrIx = uint32_t;
-  using MemoryOpIx = uint32_t;
+  using MemoryOpIx = uint64_t;
 
   struct MemoryOp
   {
@@ -111,8 +113,9 @@ namespace WdRiscv
 
   struct McmInstr
   {
-    // memOps contains indices into an array of MemoryOp items.
-    std::vector<MemoryOpIx> memOps_;
+    // Ids (indices in sysMemOps_) of the memory operations of this instruction in
+    // time order. Most instructions have one or two operations: keep those inline.
+    boost::container::small_vector<MemoryOpIx, 2> memOps_;
     uint64_t virtAddr_ = 0;   // Virtual data address for ld/st instructions.
     uint64_t physAddr_ = 0;   // Physical data address for ld/st instruction.
     uint64_t physAddr2_ = 0;  // Additional data address for page crossing stores.
@@ -207,6 +210,110 @@ namespace WdRiscv
   };
 
 
+  /// Sliding window over a sequence of items addressed by an ever increasing index
+  /// (instruction tag or memory operation index). Items are appended at the end and
+  /// reclaimed from the front so that memory use is bounded by the number of items in
+  /// flight instead of by the length of the run. Indices are absolute: they do not
+  /// change when the front of the window is reclaimed. Accessing a reclaimed index
+  /// yields a placeholder item.
+  template <typename T>
+  class McmWindow
+  {
+  public:
+
+    using Items = std::deque<T>;
+    using iterator = typename Items::iterator;
+    using const_iterator = typename Items::const_iterator;
+    using reverse_iterator = typename Items::reverse_iterator;
+    using const_reverse_iterator = typename Items::const_reverse_iterator;
+
+    /// Constructor. The given item is returned by at() for reclaimed indices.
+    explicit McmWindow(const T& reclaimed = T{})
+      : reclaimed_(reclaimed)
+    { }
+
+    /// Return the index of the first item in the window. Items with smaller indices
+    /// have been reclaimed.
+    uint64_t base() const
+    { return base_; }
+
+    /// Return the index of the next appended item (one plus the index of the last
+    /// item).
+    uint64_t size() const
+    { return base_ + items_.size(); }
+
+    /// Return true if the window holds no item.
+    bool empty() const
+    { return items_.empty(); }
+
+    /// Return the item at the given index or the placeholder if the index was
+    /// reclaimed. The placeholder must not be modified.
+    T& at(uint64_t ix)
+    { return ix < base_ ? reclaimed_ : items_.at(ix - base_); }
+
+    const T& at(uint64_t ix) const
+    { return ix < base_ ? reclaimed_ : items_.at(ix - base_); }
+
+    T& front()              { return items_.front(); }
+    const T& front() const  { return items_.front(); }
+    T& back()               { return items_.back(); }
+    const T& back() const   { return items_.back(); }
+
+    /// Append given item. Its index is the size() before the call.
+    void push_back(const T& item)
+    { items_.push_back(item); }
+
+    /// Grow the window with default items so that size() becomes n. No-op if size()
+    /// is already n or larger.
+    void resize(uint64_t n)
+    {
+      if (n > size())
+        items_.resize(n - base_);
+    }
+
+    /// Reclaim the first item of the window.
+    void pop_front()
+    {
+      items_.pop_front();
+      ++base_;
+    }
+
+    iterator begin()                        { return items_.begin(); }
+    iterator end()                          { return items_.end(); }
+    const_iterator begin() const            { return items_.begin(); }
+    const_iterator end() const              { return items_.end(); }
+    reverse_iterator rbegin()               { return items_.rbegin(); }
+    reverse_iterator rend()                 { return items_.rend(); }
+    const_reverse_iterator rbegin() const   { return items_.rbegin(); }
+    const_reverse_iterator rend() const     { return items_.rend(); }
+
+  private:
+
+    Items items_;
+    uint64_t base_ = 0;
+    T reclaimed_;
+  };
+
+
+  /// Memory consistency model checker: checks the PPO rules against the memory
+  /// operations reported by the test-bench (see the Mcm commands of Server). All the
+  /// methods run on the thread of the server loop.
+  ///
+  /// Checking the harts on worker threads needs a change of the test-bench protocol:
+  /// - The result of the PPO checks of an instruction is in the reply to its step
+  ///   command (and to the mbwrite/bypass command completing a retired store), so
+  ///   the server must finish the checks before it reads the next command.
+  /// - A check reads the operations of all the harts up to the time of the checked
+  ///   instruction, and the test-bench may still send a read with an earlier time
+  ///   (see insertLateMemOp), so the operation log is never final.
+  /// Proposed change: a new McmSync(T) command by which the test-bench promises that
+  /// no operation with a time smaller than T will follow for any hart. Step, mbwrite
+  /// and bypass no longer report PPO failures; their checks are queued on the hart
+  /// and run by a worker once T passes their time, and the reply to the next McmSync
+  /// lists the failures (hart, tag, rule). The operations older than T are then
+  /// read-only and shared by the workers without locks while the server thread
+  /// appends newer ones. Read data checks, merge buffers and forwarding stay on the
+  /// server thread: their results are needed in the reply to the command.
   template <typename URV>
   class Mcm
   {
@@ -849,6 +956,32 @@ namespace WdRiscv
 
     McmInstr* findOrAddInstr(unsigned hartIx, McmInstrIx tag);
 
+    /// Append the given operation to sysMemOps_ and to the operations of the given
+    /// instruction and of its hart.
+    void appendMemOp(McmInstr& instr, const MemoryOp& op);
+
+    /// Append the given operation, whose time is earlier than that of the last
+    /// operation, to sysMemOps_ and insert its id in time order in opOrder_ and in the
+    /// operations of the given instruction and of its hart. Return the position of
+    /// the new operation in opOrder_.
+    uint64_t insertLateMemOp(McmInstr& instr, const MemoryOp& op);
+
+    /// Return the position in opOrder_ of the operation with the given id.
+    uint64_t orderPosition(MemoryOpIx ix) const;
+
+    /// Return true if given instruction is canceled or is retired and, if a store,
+    /// drained. Such an instruction no longer changes state.
+    static bool isFinished(const McmInstr& instr)
+    { return instr.canceled_ or (instr.retired_ and (instr.complete_ or not instr.isStore_)); }
+
+    /// Reclaim the front of the instruction and memory operation windows: instructions
+    /// that are finished, that precede the oldest unfinished instruction of their hart
+    /// by more than windowSlack_ tags, and whose memory operations and retire times
+    /// are older than those of every unfinished instruction. Such items can no longer
+    /// be reached by a PPO rule: the rules scan backward in time and stop before the
+    /// earliest operation of the checked instruction.
+    void reclaimWindow();
+
     /// Helper to cancelInstruction.
     void cancelInstr(Hart<URV>& hart, McmInstr& instr);
 
@@ -929,7 +1062,8 @@ namespace WdRiscv
     const unsigned csRegOffset_ = 96;
     const unsigned totalRegCount_ = csRegOffset_ + 4096; // 4096: max csr count.
 
-    using McmInstrVec = std::vector<McmInstr>;
+    using McmInstrVec = McmWindow<McmInstr>;
+    using MemoryOpWindow = McmWindow<MemoryOp>;
 
     using RegTimeVec = std::vector<uint64_t>;    // Map reg index to time.
     using RegProducerVec = std::vector<McmInstrIx>;   // Map reg index to instr tag.
@@ -1051,11 +1185,56 @@ namespace WdRiscv
       McmInstrIx currentInstrTag_ = 0;
       uint64_t sinvalVmaTime_ = 0;
       uint64_t sinvalVmaTag_ = 0;
+
+      // Tag of oldest unfinished instruction: all smaller tags are finished.
+      uint64_t liveTag_ = 0;
+
+      // Indices used by the PPO rule checks so that their backward scans visit only
+      // the candidates of a rule instead of every operation or instruction.
+
+      // Ids of the memory operations of this hart in time order. Backward scans of
+      // the operations of a hart use this to skip those of the other harts.
+      std::deque<MemoryOpIx> memOps_;
+
+      // Retired fences and retired cbo.clean/flush/inval instructions in program
+      // order. The time of an entry is the smallest retire time of the entry and all
+      // the instructions retired after it: a backward scan of the retired
+      // instructions that stops at the first retire time smaller than some time T
+      // visits exactly the entries with time not smaller than T.
+      struct RetiredMark
+      {
+	McmInstrIx tag_ = 0;
+	uint64_t time_ = 0;
+      };
+      std::deque<RetiredMark> fences_;
+      std::deque<RetiredMark> cmos_;
     };
 
     std::vector<HartData> hartData_;    // One entry per hart.
 
-    MemoryOpVec sysMemOps_;             // Memory ops of all harts ordered by time.
+    // Memory ops of all harts addressed by a stable id (arrival order). The
+    // test-bench occasionally sends a read op with an earlier time than that of the
+    // last op: it gets the next id and its id is inserted in opOrder_ so that the ids
+    // of the other ops never change.
+    MemoryOpWindow sysMemOps_;
+    std::deque<MemoryOpIx> opOrder_;    // Ids of sysMemOps_ in time order.
+
+    // Finished instructions kept per hart behind the oldest unfinished one: late
+    // operations for recently retired instructions still find them.
+    static constexpr uint64_t windowSlack_ = 4096;
+
+    // Number of retired instructions between window reclaims.
+    static constexpr uint64_t minReclaimPeriod_ = 1024;
+    static constexpr uint64_t maxReclaimPeriod_ = uint64_t(1) << 20;
+    uint64_t reclaimPeriod_ = minReclaimPeriod_;
+    uint64_t nextReclaim_ = minReclaimPeriod_;
+    uint64_t retireCount_ = 0;
+
+    // Largest supported distance between an instruction tag and the window base.
+    static constexpr uint64_t maxTagSpan_ = 500000000;
+
+    // Stand-in returned by findOrAddInstr for a tag that was already reclaimed.
+    McmInstr staleInstr_;
 
     uint64_t time_ = 0;
 
@@ -19,6 +19,8 @@
 #include <cmath>
 #include <cstdlib>
 #include <bit>
+#include <algorithm>
+#include <cstring>
 #include <boost/algorithm/string.hpp>
 #include <sys/mman.h>
 #include <sys/types.h>
@@ -31,6 +33,7 @@
 #include <lz4frame.h>
 #endif
 #include "Memory.hpp"
+#include "SnapshotChunks.hpp"
 #include "wideint.hpp"
 #include "util.hpp"
 #include <cstdio>
@@ -39,6 +42,9 @@
 using namespace WdRiscv;
 
 
+thread_local Memory::StoreBuffer* Memory::threadStoreBuf_ = nullptr;
+
+
 inline bool
 isPowerOf2(uint64_t x)
 {
@@ -71,6 +77,16 @@ Memory::Memory(uint64_t size, uint64_t pageSize)
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
   data_ = reinterpret_cast<uint8_t*>(mem);
 
+  // Pages are committed on first write. Back them with transparent huge
+  // pages where possible to reduce host TLB pressure. This is advisory:
+  // failure is not an error.
+#ifdef MADV_HUGEPAGE
+  if (size_ >= (uint64_t(1) << touchShift_))
+    madvise(mem, size_, MADV_HUGEPAGE);
+#endif
+
+  touched_ = std::vector<std::atomic<uint8_t>>((size_ + (uint64_t(1) << touchShift_) - 1) >> touchShift_);
+
 #endif
 
 }
@@ -78,6 +94,8 @@ Memory::Memory(uint64_t size, uint64_t pageSize)
 
 Memory::~Memory()
 {
+  clearDirtyPages();
+
   if (data_)
     {
       munmap(data_, size_);
@@ -92,6 +110,121 @@ Memory::~Memory()
 }
 
 
+bool
+Memory::getTouchedBlocks(std::vector<std::pair<uint64_t, uint64_t>>& blocks) const
+{
+  blocks.clear();
+
+#ifdef MEM_CALLBACKS
+
+  return false;
+
+#else
+
+  uint64_t regionSize = uint64_t(1) << touchShift_;
+  for (uint64_t ix = 0; ix < touched_.size(); ++ix)
+    {
+      if (not touched_[ix].load(std::memory_order_relaxed))
+        continue;
+      uint64_t addr = ix << touchShift_;
+      uint64_t size = std::min(regionSize, size_ - addr);
+      if (not blocks.empty() and blocks.back().first + blocks.back().second == addr)
+        blocks.back().second += size;
+      else
+        blocks.emplace_back(addr, size);
+    }
+  return true;
+
+#endif
+}
+
+
+void
+Memory::enableDirtyTracking(bool flag)
+{
+  clearDirtyPages();
+  dirtyTracking_ = flag;
+  dirtyShift_ = std::max(21u, pageShift_);
+  uint64_t regions = flag ? ((size_ - 1) >> dirtyShift_) + 1 : 0;
+  dirty_ = std::vector<std::atomic<std::atomic<uint64_t>*>>(regions);
+}
+
+
+std::atomic<uint64_t>*
+Memory::addDirtyRegion(uint64_t region)
+{
+  // Harts running in separate threads may race to add the same region:
+  // keep the first bitmap.
+  uint64_t words = ((uint64_t(1) << (dirtyShift_ - pageShift_)) + 63) / 64;
+  auto* bits = new std::atomic<uint64_t>[words]{};
+  std::atomic<uint64_t>* prev = nullptr;
+  if (dirty_[region].compare_exchange_strong(prev, bits, std::memory_order_acq_rel))
+    return bits;
+  delete[] bits;
+  return prev;
+}
+
+
+void
+Memory::clearDirtyPages()
+{
+  for (auto& region : dirty_)
+    delete[] region.exchange(nullptr, std::memory_order_relaxed);
+}
+
+
+void
+Memory::getDirtyBlocks(std::vector<std::pair<uint64_t, uint64_t>>& blocks) const
+{
+  blocks.clear();
+
+  uint64_t words = ((uint64_t(1) << (dirtyShift_ - pageShift_)) + 63) / 64;
+  for (uint64_t region = 0; region < dirty_.size(); ++region)
+    {
+      const auto* bits = dirty_[region].load(std::memory_order_acquire);
+      if (not bits)
+        continue;
+      for (uint64_t ix = 0; ix < words; ++ix)
+        {
+          uint64_t word = bits[ix].load(std::memory_order_relaxed);
+          while (word)
+            {
+              unsigned bit = std::countr_zero(word);
+              word &= word - 1;
+              uint64_t addr = (region << dirtyShift_) + (((ix * 64) + bit) << pageShift_);
+              if (not blocks.empty() and blocks.back().first + blocks.back().second == addr)
+                blocks.back().second += pageSize_;
+              else
+                blocks.emplace_back(addr, pageSize_);
+            }
+        }
+    }
+}
+
+
+void
+Memory::commitStoreBuffers()
+{
+  DirectAccess direct;
+
+  for (auto& buffer : storeBufs_)
+    {
+      for (const auto& [word, entry] : buffer)
+        {
+          const auto& [data, mask] = entry;
+          uint64_t addr = word << 3;
+          if (mask == 0xff)
+            poke(addr, data);
+          else
+            for (unsigned byte = 0; byte < 8; ++byte)
+              if ((mask >> byte) & 1)
+                poke(addr + byte, uint8_t(data >> (8*byte)));
+        }
+      buffer.clear();
+    }
+}
+
+
 bool
 Memory::loadHexFile(const std::string& fileName)
 {
@@ -1015,6 +1148,103 @@ Memory::saveSnapshot_gzip(const std::string& filename,
   return success;
 }
 
+bool
+Memory::saveSnapshot_chunked(const std::string& filename,
+                             const std::vector<std::pair<uint64_t,uint64_t>>& usedBlocks) const
+{
+  std::cerr << "Info: saveSnapshot starts..\n";
+
+  for (const auto& blk : usedBlocks)
+    if (blk.first >= size_ or blk.second > size_ or size_ - blk.second < blk.first or
+        (blk.first & 3) != 0 or (blk.second & 3) != 0)
+      {
+        std::cerr << "Error: Memory::saveSnapshot: Block at (0x" << std::hex << blk.first
+                  << std::dec << ") is misaligned or extends beyond memory bound\n";
+        return false;
+      }
+
+  // Called concurrently: peek does not modify memory.
+  auto readFunc = [this] (uint64_t addr, std::span<uint8_t> data) {
+#ifdef MEM_CALLBACKS
+    for (size_t i = 0; i < data.size(); i += 4, addr += 4)
+      {
+        uint32_t x = 0;
+        peek(addr, x);
+        memcpy(&data[i], &x, sizeof(x));
+      }
+#else
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    memcpy(data.data(), data_ + addr, data.size());
+#endif
+  };
+
+  bool success = SnapshotChunks::save(filename, usedBlocks, readFunc);
+  std::cerr << "Info: saveSnapshot finished\n";
+  return success;
+}
+
+
+bool
+Memory::loadSnapshot_chunked(const std::string& filename)
+{
+  std::cerr << "Info: loadSnapshot starts..\n";
+
+  SnapshotChunks file;
+  if (not file.open(filename))
+    return false;
+
+  std::vector<uint8_t> page(pageSize_);
+
+  // Write a chunk page by page. Whole pages of regular memory are
+  // written in one shot. Other pages are written a word at a time
+  // skipping unchanged words to maintain sparsity.
+  auto writeFunc = [this, &page] (uint64_t addr, std::span<const uint8_t> data) {
+    if (addr >= size_ or data.size() > size_ - addr or (addr & 3) != 0 or (data.size() & 3) != 0)
+      {
+        std::cerr << "Error: Memory::loadSnapshot: Chunk at (0x" << std::hex << addr
+                  << std::dec << ") is misaligned or extends beyond memory bound\n";
+        return false;
+      }
+
+    size_t offset = 0;
+    while (offset < data.size())
+      {
+        size_t size = std::min(data.size() - offset, size_t(pageSize_ - (addr & (pageSize_ - 1))));
+        auto bytes = data.subspan(offset, size);
+
+        bool zero = std::all_of(bytes.begin(), bytes.end(), [] (uint8_t b) { return b == 0; });
+        if (not zero and size == pageSize_ and
+            not pmaMgr_.overlapsMemMappedRegs(addr, addr + size - 1))
+          {
+            std::copy(bytes.begin(), bytes.end(), page.begin());
+            if (not initializePage(addr, page))
+              return false;
+          }
+        else
+          {
+            for (size_t i = 0; i < size; i += 4)
+              {
+                uint32_t prev = 0, curr = 0;
+                peek(addr + i, prev);
+                memcpy(&curr, &bytes[i], sizeof(curr));
+                if (curr != prev)
+                  poke(addr + i, curr);
+              }
+          }
+        addr += size;
+        offset += size;
+      }
+    return true;
+  };
+
+  bool success = file.restore(writeFunc);
+  if (not success)
+    std::cerr << "Error: Memory::loadSnapshot failed - read from " << filename << " failed\n";
+  std::cerr << "Info: loadSnapshot finished\n";
+  return success;
+}
+
+
 #if LZ4_COMPRESS
 bool compress_lz4(FILE* out, const uint8_t* buffer, size_t mem_block_size) {
   // Check for the file pointer 
@@ -1679,6 +1909,8 @@ Memory::initializeByte(uint64_t addr, uint8_t value)
         return false;
     }
 
+  bumpGen(addr);
+
   // We initialize both the memory-mapped-register and the external
   // memory to match/simplify the test-bench.
   if (writeCallback_)
@@ -1694,6 +1926,89 @@ Memory::initializeByte(uint64_t addr, uint8_t value)
 }
 
 
+bool
+Memory::peekBlock(uint64_t pa, std::span<uint8_t> data)
+{
+  if (data.size() > size_ or pa > size_ - data.size())
+    return false;
+
+  size_t done = 0;
+  while (done < data.size())
+    {
+      uint64_t addr = pa + done;
+      size_t count = std::min(data.size() - done, size_t(pageSize_ - (addr & (pageSize_ - 1))));
+      const uint8_t* host = isPlainRange(addr, count) ? hostAddress(addr) : nullptr;
+      if (host)
+        memcpy(&data[done], host, count);
+      else
+        for (size_t i = 0; i < count; )
+          {
+            uint64_t a = addr + i;
+            bool mmr = pmaMgr_.isMemMappedReg(a);
+            if ((a & 3) == 0 and count - i >= 4)
+              {
+                uint32_t word = 0;
+                if (not (mmr ? pmaMgr_.readRegister(a, word) : peek(a, word)))
+                  return false;
+                memcpy(&data[done + i], &word, sizeof(word));
+                i += sizeof(word);
+              }
+            else
+              {
+                if (not (mmr ? pmaMgr_.readRegister(a, data[done + i]) : peek(a, data[done + i])))
+                  return false;
+                ++i;
+              }
+          }
+      done += count;
+    }
+  return true;
+}
+
+
+bool
+Memory::pokeBlock(uint64_t pa, std::span<const uint8_t> data)
+{
+  if (data.size() > size_ or pa > size_ - data.size())
+    return false;
+
+  size_t done = 0;
+  while (done < data.size())
+    {
+      uint64_t addr = pa + done;
+      size_t count = std::min(data.size() - done, size_t(pageSize_ - (addr & (pageSize_ - 1))));
+      uint8_t* host = isPlainRange(addr, count) ? hostAddress(addr) : nullptr;
+      if (host)
+        {
+          memcpy(host, &data[done], count);
+          notifyWrite(addr, count);
+        }
+      else
+        for (size_t i = 0; i < count; )
+          {
+            uint64_t a = addr + i;
+            bool mmr = pmaMgr_.isMemMappedReg(a);
+            if ((a & 3) == 0 and count - i >= 4)
+              {
+                uint32_t word = 0;
+                memcpy(&word, &data[done + i], sizeof(word));
+                if (not (mmr ? pmaMgr_.writeRegister(a, word) : poke(a, word)))
+                  return false;
+                i += sizeof(word);
+              }
+            else
+              {
+                if (not (mmr ? pmaMgr_.writeRegister(a, data[done + i]) : poke(a, data[done + i])))
+                  return false;
+                ++i;
+              }
+          }
+      done += count;
+    }
+  return true;
+}
+
+
 bool
 Memory::initializePage(uint64_t addr, const std::span<uint8_t> buffer)
 {
@@ -1707,6 +2022,8 @@ Memory::initializePage(uint64_t addr, const std::span<uint8_t> buffer)
 
   assert(buffer.size() >= pageSize_);
 
+  bumpGen(addr);
+
 #ifndef MEM_CALLBACKS
 
   // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
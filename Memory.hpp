@@ -15,6 +15,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -75,7 +76,7 @@ namespace WdRiscv
     /// Define number of hardware threads for LR/SC. FIX: put this in
     /// constructor.
     void setHartCount(unsigned count)
-    { reservations_.resize(count); }
+    { reservations_.resize(count); storeBufs_.resize(count); }
 
     /// Return memory size in bytes.
     uint64_t size() const
@@ -106,6 +107,8 @@ namespace WdRiscv
       value = *(reinterpret_cast<const T*>(data_ + address));
 #endif
 
+      if (bufferStores_) [[unlikely]]
+        overlayStores(address, value);
       return true;
     }
 
@@ -128,6 +131,8 @@ namespace WdRiscv
       value = *(reinterpret_cast<const T*>(data_ + address));
 #endif
 
+      if (bufferStores_) [[unlikely]]
+        overlayStores(address, value);
       return true;
     }
 
@@ -143,10 +148,55 @@ namespace WdRiscv
       return poke(pa, value);
     }
 
-    /// Register an observer called after every committed RAM write with
-    /// (context, address, size). Used to keep the page-walk PTE cache coherent.
-    void setWriteObserver(void (*fn)(void*, uint64_t, unsigned), void* ctx)
-    { writeObserver_ = fn; writeObserverCtx_ = ctx; }
+    /// Return the write generation of the page containing the given
+    /// address. The generation changes on every RAM write to the page
+    /// which allows a cache of decoded instructions to validate an
+    /// entry without re-reading memory. Distinct pages may share a
+    /// generation counter (spurious invalidation but never a stale hit).
+    /// Generations are 64-bit: a counter that wrapped around could make
+    /// a stale entry look valid again.
+    uint64_t pageGeneration(uint64_t addr) const
+    { return pageGen_[(addr >> pageShift_) & pageGenMask_].load(std::memory_order_relaxed); }
+
+    /// Return the table of page write generations: the generation of
+    /// the page at address a is at index ((a >> pageShift) & mask) where
+    /// mask is the table size minus 1. This allows the page-walk PTE
+    /// cache of every hart to validate its entries against writes made
+    /// by any hart (see VirtMem::setPageGenerations).
+    std::span<const std::atomic<uint64_t>> pageGenerations() const
+    { return pageGen_; }
+
+    /// Fill the given vector with the address/size of the written (or
+    /// loaded) areas of memory, in ascending address order, with 2 MiB
+    /// granularity (the last area is clipped to the memory size).
+    /// Return false if memory is held outside of this class (see
+    /// MEM_CALLBACKS) in which case no tracking is done.
+    bool getTouchedBlocks(std::vector<std::pair<uint64_t, uint64_t>>& blocks) const;
+
+    /// Enable/disable tracking of the pages written since the last call
+    /// to clearDirtyPages (see getDirtyBlocks). Tracking uses one bitmap
+    /// per 2 MiB region allocated on the first write to the region.
+    /// Enabling clears it.
+    void enableDirtyTracking(bool flag);
+
+    /// Fill the given vector with the address/size of the pages written
+    /// since tracking was enabled or since the last clearDirtyPages, in
+    /// ascending address order, merging adjacent pages. Regions not
+    /// written are skipped without scanning.
+    void getDirtyBlocks(std::vector<std::pair<uint64_t, uint64_t>>& blocks) const;
+
+    /// Mark all pages as clean releasing the region bitmaps. Must not be
+    /// called while harts run.
+    void clearDirtyPages();
+
+    /// Advance the write generation of the page(s) overlapping the
+    /// given address range.
+    void bumpPageGeneration(uint64_t addr, unsigned size)
+    {
+      uint64_t last = (addr + size - 1) >> pageShift_;
+      for (uint64_t page = addr >> pageShift_; page <= last; ++page)
+        bumpGen(page << pageShift_);
+    }
 
     /// Perfrom read from IO devices. Return true if we hit in any IO
     /// device and false otherwise.
@@ -176,6 +226,16 @@ namespace WdRiscv
                                  });
     }
 
+    /// Return true if any IO device overlaps the address range [addr0, addr1].
+    bool hasIoInRange(uint64_t addr0, uint64_t addr1) const
+    {
+      return std::ranges::any_of(ioDevs_,
+                                 [addr0, addr1](const auto& dev) {
+                                   return (dev->size() != 0 and dev->address() <= addr1 and
+                                           addr0 <= dev->address() + (dev->size() - 1));
+                                 });
+    }
+
     /// Similar to read but avoid accessing io devices.
     template <typename T>
     bool peek(uint64_t address, T& value) const
@@ -193,6 +253,8 @@ namespace WdRiscv
       value = *(reinterpret_cast<const T*>(data_ + address));
 #endif
 
+      if (bufferStores_) [[unlikely]]
+        overlayStores(address, value);
       return true;
     }
 
@@ -280,21 +342,67 @@ namespace WdRiscv
 				  const std::string& target);
 
     /// Define read memory callback. This (along with defineWriteMemoryCallback) allows
-    /// the caller to bypass the memory model with their own.
+    /// the caller to bypass the memory model with their own. This drops the host
+    /// address callback: it would point to the replaced memory.
     void defineReadMemoryCallback(
          std::function<bool(uint64_t, unsigned, uint64_t&)> callback )
-    { readCallback_ = std::move(callback); }
+    {
+      readCallback_ = std::move(callback);
+      hostAddressCallback_ = nullptr;
+    }
 
     /// Define write memory callback. This (along with defineReadMemoryCallback) allows
-    /// the caller to bypass the memory model with their own.
+    /// the caller to bypass the memory model with their own. This drops the host
+    /// address callback: it would point to the replaced memory.
     void defineWriteMemoryCallback(std::function<bool(uint64_t, unsigned, uint64_t)> callback)
-    { writeCallback_ = std::move(callback); }
+    {
+      writeCallback_ = std::move(callback);
+      hostAddressCallback_ = nullptr;
+    }
+
+    /// Mark the read/write callbacks as external: the memory they model may
+    /// change without going through this object, so the page write
+    /// generations do not track it.
+    void markExternalCallbacks()
+    { externalCallbacks_ = true; }
+
+    /// Return true if the read/write callbacks are external. See
+    /// markExternalCallbacks.
+    bool hasExternalCallbacks() const
+    { return externalCallbacks_; }
 
     /// Define page initialization callback. This is used to speed-up memory insitialization
     /// for the sparse-memory mode..
     void defineInitPageCallback(std::function<bool(uint64_t, const std::span<uint8_t>)> callback)
     { initPageCallback_ = std::move(callback); }
 
+    /// Define host address callback. This allows the simulator to
+    /// access memory directly when memory is held outside of this class
+    /// (see hostAddress). It must be defined after the read/write
+    /// callbacks and must address the memory they access.
+    void defineHostAddressCallback(std::function<uint8_t*(uint64_t)> callback)
+    { hostAddressCallback_ = std::move(callback); }
+
+    /// Return the host-machine address of the byte at the given physical
+    /// address or nullptr if that address is out of bounds or not
+    /// directly accessible. The returned address is valid for accesses
+    /// within the same 4 KiB block (which must not include memory
+    /// mapped registers). Writes through it bypass page generations (see
+    /// notifyWrite). Return nullptr while stores are buffered (see
+    /// bufferStores): accesses through host addresses would bypass the
+    /// buffers.
+    uint8_t* hostAddress(uint64_t pa)
+    {
+      if (pa >= size_ or bufferStores_)
+        return nullptr;
+#ifdef MEM_CALLBACKS
+      return hostAddressCallback_ ? hostAddressCallback_(pa) : nullptr;
+#else
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      return data_ + pa;
+#endif
+    }
+
     /// Enable tracing of memory data lines referenced by current run. A memory data line
     /// is typically 64-bytes long and corresponds to a cachable line.
     void enableDataLineTrace(const std::string& path)
@@ -323,6 +431,17 @@ namespace WdRiscv
     bool loadSnapshot_gzip(const std::string& filename,
                            const std::vector<std::pair<uint64_t,uint64_t>>& used_blocks);
 
+    /// Take a snapshot of the given memory blocks into a chunked file
+    /// (see SnapshotChunks) compressing chunks in parallel. Return true
+    /// on success or false on failure.
+    bool saveSnapshot_chunked(const std::string& filename,
+                              const std::vector<std::pair<uint64_t,uint64_t>>& used_blocks) const;
+
+    /// Load the simulated memory from a chunked snapshot file
+    /// decompressing chunks in parallel. Return true on success or
+    /// false on failure.
+    bool loadSnapshot_chunked(const std::string& filename);
+
 #if LZ4_COMPRESS
     // Take a snapshot of the entire simulated memory into binary using lz4 compression.
     // Returns true on success or false on failure.
@@ -368,6 +487,10 @@ namespace WdRiscv
     uint64_t pageSize() const
     { return pageSize_; }
 
+    /// Return the base-2 logarithm of the page size.
+    unsigned pageShift() const
+    { return pageShift_; }
+
     /// Return the number of the page containing the given address.
     uint64_t getPageIx(uint64_t addr) const
     { return addr >> pageShift_; }
@@ -383,6 +506,13 @@ namespace WdRiscv
       if (pa + sizeof(T) > size_)
         return false;
 
+      if (bufferStores_ and threadStoreBuf_) [[unlikely]]
+        {
+          bufferStore(pa, value);
+          notifyWrite(pa, sizeof(T));
+          return true;
+        }
+
 #ifdef MEM_CALLBACKS
       uint64_t val = value;
       if (not writeCallback_(pa, sizeof(T), val))
@@ -392,14 +522,159 @@ namespace WdRiscv
       *(reinterpret_cast<T*>(data_ + pa)) = value;
 #endif
 
-      // Notify observers (e.g. the page-walk PTE cache) of a committed RAM write
-      // so they can invalidate any cached copy of the written location.
-      if (writeObserver_)
-        writeObserver_(writeObserverCtx_, pa, sizeof(T));
-
+      notifyWrite(pa, sizeof(T));
       return true;
     }
 
+    /// Copy the memory bytes at the given address into the given buffer
+    /// a page at a time avoiding io devices (same as peeking each
+    /// byte). A page overlapping an io device or a memory mapped
+    /// register is copied a word at a time, reading the registers.
+    /// Return true on success and false if the range is out of bounds.
+    bool peekBlock(uint64_t pa, std::span<uint8_t> data);
+
+    /// Copy the given bytes to memory at the given address a page at a
+    /// time avoiding io devices (same as poking each byte). A page
+    /// overlapping an io device or a memory mapped register is copied a
+    /// word at a time, writing the registers. Return true on success and
+    /// false if the range is out of bounds.
+    bool pokeBlock(uint64_t pa, std::span<const uint8_t> data);
+
+    /// Return true if the given range holds neither io device nor
+    /// memory mapped register: it may be copied through host memory.
+    bool isPlainRange(uint64_t pa, uint64_t size) const
+    {
+      uint64_t last = pa + size - 1;
+      return not hasIoInRange(pa, last) and not pmaMgr_.overlapsMemMappedRegs(pa, last);
+    }
+
+    /// Advance the page write generations of a committed RAM write so
+    /// that caches (decoded instructions, page-walk PTEs) invalidate any
+    /// copy of the written location. Must be called after writing
+    /// through a host address (see hostAddress).
+    void notifyWrite(uint64_t pa, unsigned size)
+    {
+      bumpPageGeneration(pa, size);
+    }
+
+    /// Atomically replace the item of type T at the given address by
+    /// desired if it equals expected. Return true if replaced. Otherwise
+    /// set expected to the value found and return false. An IO device
+    /// location is written unconditionally. A misaligned or not directly
+    /// accessible location is compared/written under the line lock(s)
+    /// which is atomic only with respect to other users of this method.
+    template <typename T>
+    bool compareExchange(uint64_t pa, T& expected, T desired)
+    {
+      uint64_t last = pa + sizeof(T) - 1;
+      if (hasIoInRange(pa, last))
+        return write(pa, desired);
+
+      if (bufferStores_ and threadStoreBuf_) [[unlikely]]
+        {
+          // Compare with and write to the view of the calling thread.
+          T value{};
+          if (not peek(pa, value))
+            return false;
+          if (value != expected)
+            {
+              expected = value;
+              return false;
+            }
+          return poke(pa, desired);
+        }
+
+      uint8_t* host = (pa & (sizeof(T) - 1)) == 0 ? hostAddress(pa) : nullptr;
+      if (host)
+        {
+          // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+          std::atomic_ref<T> item(*reinterpret_cast<T*>(host));
+          if (not item.compare_exchange_strong(expected, desired))
+            return false;
+          notifyWrite(pa, sizeof(T));
+          return true;
+        }
+
+      auto locks = lockLines(pa, last);
+      T value{};
+      if (not read(pa, value) or value != expected)
+        {
+          expected = value;
+          return false;
+        }
+      return poke(pa, desired);
+    }
+
+    /// Lock the striped locks of the lines containing the two given
+    /// addresses (a single lock if both map to the same one) in a fixed
+    /// order to avoid deadlock. Return the held locks.
+    std::pair<std::unique_lock<SpinLock>, std::unique_lock<SpinLock>>
+    lockLines(uint64_t addr1, uint64_t addr2)
+    {
+      uint64_t ix1 = (addr1 >> resLineShift_) & lineLockMask_;
+      uint64_t ix2 = (addr2 >> resLineShift_) & lineLockMask_;
+      if (ix1 > ix2)
+        std::swap(ix1, ix2);
+      std::unique_lock<SpinLock> first(lineLocks_.at(ix1).lock_);
+      if (ix1 == ix2)
+        return { std::move(first), std::unique_lock<SpinLock>() };
+      return { std::move(first), std::unique_lock<SpinLock>(lineLocks_.at(ix2).lock_) };
+    }
+
+    /// Mark this memory as being accessed by harts running in separate
+    /// threads. In that mode plain stores do not lock, and atomic
+    /// instructions commit with compareExchange (see Hart::memWrite).
+    void setConcurrent(bool flag)
+    { concurrent_ = flag; }
+
+    /// Return true if harts access this memory from separate threads.
+    bool isConcurrent() const
+    { return concurrent_; }
+
+    /// Stores held by the store buffer of a hart (see bufferStores): the
+    /// bytes of each written double word, indexed by address / 8, and the
+    /// mask of the bytes written.
+    using StoreBuffer = std::unordered_map<uint64_t, std::pair<uint64_t, uint8_t>>;
+
+    /// When flag is true, the stores of a thread that selected the store
+    /// buffer of a hart (see selectStoreBuffer) are held in that buffer
+    /// instead of written to memory, and the loads of that thread see
+    /// the memory updated by the buffered stores. Stores to IO devices
+    /// are not buffered. The buffers are written to memory by
+    /// commitStoreBuffers. This makes the memory seen by harts running
+    /// in separate threads independent of the timing of the threads.
+    void bufferStores(bool flag)
+    { bufferStores_ = flag; }
+
+    /// Direct the loads and stores of the calling thread to the store
+    /// buffer of the hart with the given index. See bufferStores.
+    void selectStoreBuffer(unsigned sysHartIx)
+    { threadStoreBuf_ = &storeBufs_.at(sysHartIx); }
+
+    /// Write the buffered stores to memory in hart index order (a hart
+    /// overrides the bytes written by harts of lower index) and empty
+    /// the buffers. Must not be called while harts run.
+    void commitStoreBuffers();
+
+    /// While an object of this class exists, the loads and stores of the
+    /// calling thread access memory directly even if it selected a store
+    /// buffer.
+    class DirectAccess
+    {
+    public:
+      DirectAccess() : saved_(threadStoreBuf_)
+      { threadStoreBuf_ = nullptr; }
+
+      ~DirectAccess()
+      { threadStoreBuf_ = saved_; }
+
+      DirectAccess(const DirectAccess&) = delete;
+      DirectAccess& operator=(const DirectAccess&) = delete;
+
+    private:
+      StoreBuffer* saved_;
+    };
+
     /// Return true if given address is page aligned.
     bool isPageAligned(uint64_t addr) const
     { return ((addr >> pageShift_) << pageShift_) == addr; }
@@ -417,6 +692,56 @@ namespace WdRiscv
     /// must be >= pageSize_.
     bool initializePage(uint64_t addr, std::span<uint8_t> buffer);
 
+    /// Advance the write generation of the page containing the given
+    /// address. The release ordering makes the write visible to a
+    /// reader that observes the new generation. Harts running in
+    /// separate threads increment atomically: a lost increment could
+    /// leave a cached PTE filled between two racing writes valid.
+    void bumpGen(uint64_t addr)
+    {
+      auto& gen = pageGen_[(addr >> pageShift_) & pageGenMask_];
+      if (concurrent_)
+        gen.fetch_add(1, std::memory_order_release);
+      else
+        gen.store(gen.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+#ifndef MEM_CALLBACKS
+      markTouched(addr);
+#endif
+      if (dirtyTracking_)
+        markDirty(addr);
+    }
+
+    /// Record that the page containing the given address was written
+    /// since the last clearDirtyPages.
+    void markDirty(uint64_t addr)
+    {
+      uint64_t region = addr >> dirtyShift_;
+      if (region >= dirty_.size())
+        return;
+      auto* bits = dirty_[region].load(std::memory_order_acquire);
+      if (not bits) [[unlikely]]
+        bits = addDirtyRegion(region);
+      uint64_t page = (addr & ((uint64_t(1) << dirtyShift_) - 1)) >> pageShift_;
+      auto& word = bits[page / 64];
+      uint64_t bit = uint64_t(1) << (page % 64);
+      if ((word.load(std::memory_order_relaxed) & bit) == 0)
+        word.fetch_or(bit, std::memory_order_relaxed);
+    }
+
+    /// Return the bitmap of the given dirty-tracking region allocating
+    /// it if needed.
+    std::atomic<uint64_t>* addDirtyRegion(uint64_t region);
+
+#ifndef MEM_CALLBACKS
+    /// Record that the region containing the given address was written.
+    void markTouched(uint64_t addr)
+    {
+      uint64_t ix = addr >> touchShift_;
+      if (ix < touched_.size() and not touched_[ix].load(std::memory_order_relaxed))
+        touched_[ix].store(1, std::memory_order_relaxed);
+    }
+#endif
+
     /// Reset (to zero) all memory mapped registers.
     void resetMemoryMappedRegisters();
 
@@ -446,33 +771,56 @@ namespace WdRiscv
       return pmaMgr_.writeRegister(addr, value);
     }
 
-    /// Track LR instructin resrvations.
+    /// Track LR instructin resrvations. The fields are atomic: harts
+    /// running in separate threads invalidate each other's reservations.
     struct Reservation
     {
-      uint64_t addr_ = 0;
-      unsigned size_ = 0;
-      bool valid_ = false;
-      CancelLrCause cause_ = CancelLrCause::NONE;
+      Reservation() = default;
+
+      Reservation(const Reservation& other)
+      { *this = other; }
+
+      Reservation& operator=(const Reservation& other)
+      {
+        addr_.store(other.addr_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        size_.store(other.size_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        valid_.store(other.valid_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        cause_.store(other.cause_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+      }
+
+      /// Return true if the range of this reservation (valid or not)
+      /// overlaps the given range.
+      bool overlaps(uint64_t addr, unsigned size) const
+      {
+        uint64_t resAddr = addr_.load(std::memory_order_relaxed);
+        unsigned resSize = size_.load(std::memory_order_relaxed);
+        return ((addr >= resAddr and (addr - resAddr) < resSize) or
+                (addr < resAddr and (resAddr - addr) < size));
+      }
+
+      /// Mark this reservation invalid recording the given cause.
+      void invalidate(CancelLrCause cause)
+      {
+        valid_.store(false, std::memory_order_relaxed);
+        cause_.store(cause, std::memory_order_relaxed);
+      }
+
+      std::atomic<uint64_t> addr_ = 0;
+      std::atomic<unsigned> size_ = 0;
+      std::atomic<bool> valid_ = false;
+      std::atomic<CancelLrCause> cause_ = CancelLrCause::NONE;
     };
 
     /// Invalidate LR reservations matching address of poked/written
     /// bytes and belonging to harts other than the given hart-id. The
     /// memory tracks one reservation per hart indexed by local hart
-    /// ids.
+    /// ids. The reservation line table makes this a single load per
+    /// line when no other hart holds a reservation near the bytes.
     void invalidateOtherHartLr(unsigned sysHartIx, uint64_t addr,
                                unsigned storeSize)
     {
-      for (uint64_t i = 0; i < reservations_.size(); ++i)
-        {
-          if (i == sysHartIx) continue;
-          auto& res = reservations_[i];
-          if ((addr >= res.addr_ and (addr - res.addr_) < res.size_) or
-              (addr < res.addr_ and (res.addr_ - addr) < storeSize))
-	    {
-	      res.valid_ = false;
-	      res.cause_ = CancelLrCause::STORE;
-	    }
-        }
+      invalidateLrInRange(addr, storeSize, sysHartIx);
     }
 
     /// Invalidate LR reservations in ALL harts (including the calling hart)
@@ -482,34 +830,33 @@ namespace WdRiscv
     /// observed between LR and SC" (Zalrsc spec, sec:lrsc).
     void invalidateAllHartsLr(uint64_t addr, unsigned storeSize)
     {
-      for (auto& res : reservations_)
-        {
-          if ((addr >= res.addr_ and (addr - res.addr_) < res.size_) or
-              (addr < res.addr_ and (res.addr_ - addr) < storeSize))
-            {
-              res.valid_ = false;
-              res.cause_ = CancelLrCause::STORE;
-            }
-        }
+      invalidateLrInRange(addr, storeSize, ~0u);
     }
 
 
     /// Invalidate LR reservation corresponding to the given hart.
     void invalidateLr(unsigned sysHartIx, CancelLrCause cause)
     {
-      auto& res = reservations_.at(sysHartIx);
-      res.valid_ = false;
-      res.cause_ = cause;
+      reservations_.at(sysHartIx).invalidate(cause);
     }
 
     /// Make a LR reservation for the given hart.
     void makeLr(unsigned sysHartIx, uint64_t addr, unsigned size)
     {
       auto& res = reservations_.at(sysHartIx);
-      res.addr_ = addr;
-      res.size_ = size;
-      res.valid_ = true;
-      res.cause_ = CancelLrCause::NONE;
+      res.addr_.store(addr, std::memory_order_relaxed);
+      res.size_.store(size, std::memory_order_relaxed);
+      res.cause_.store(CancelLrCause::NONE, std::memory_order_relaxed);
+      res.valid_.store(true, std::memory_order_relaxed);
+
+      uint64_t bit = resHartBit(sysHartIx);
+      uint64_t lastLine = (addr + size - 1) >> resLineShift_;
+      for (uint64_t line = addr >> resLineShift_; line <= lastLine; ++line)
+        {
+          auto& harts = resLines_.at(line & resLineMask_);
+          if ((harts.load(std::memory_order_relaxed) & bit) == 0)
+            harts.fetch_or(bit, std::memory_order_relaxed);
+        }
     }
 
     /// Return true if given hart has a reservation (made by a load-reserve instruction)
@@ -518,28 +865,30 @@ namespace WdRiscv
     bool getLr(unsigned hartIx, uint64_t& addr, unsigned& size) const
     {
       const auto& res = reservations_.at(hartIx);
-      if (res.valid_)
+      bool valid = res.valid_.load(std::memory_order_relaxed);
+      if (valid)
         {
-          addr = res.addr_;
-          size = res.size_;
+          addr = res.addr_.load(std::memory_order_relaxed);
+          size = res.size_.load(std::memory_order_relaxed);
         }
-      return res.valid_;
+      return valid;
     }
 
     /// returns true if the given hart has a valid LR reservation
     bool hasLr(unsigned sysHartIx) const
     {
       const auto& res = reservations_.at(sysHartIx);
-      return res.valid_;
+      return res.valid_.load(std::memory_order_relaxed);
     }
 
     /// Return true if given hart has a valid LR reservation and if it
     /// contains the range defined by the given address and size.
     bool hasLr(unsigned sysHartIx, uint64_t addr, unsigned size) const
     {
-      const auto& res = reservations_.at(sysHartIx);
-      return (res.valid_ and res.addr_ <= addr and
-	      addr + size <= res.addr_ + res.size_);
+      uint64_t resAddr = 0;
+      unsigned resSize = 0;
+      return (getLr(sysHartIx, resAddr, resSize) and resAddr <= addr and
+	      addr + size <= resAddr + resSize);
     }
 
     /// Return the cause for the reservation cancleation in the given
@@ -550,7 +899,9 @@ namespace WdRiscv
       if (sysHartIx >= reservations_.size())
 	return CancelLrCause::NONE;
       const auto& res = reservations_.at(sysHartIx);
-      return res.valid_ ? CancelLrCause::NONE : res.cause_;
+      if (res.valid_.load(std::memory_order_relaxed))
+        return CancelLrCause::NONE;
+      return res.cause_.load(std::memory_order_relaxed);
     }
 
     /// Load contents of given ELF segment into memory.
@@ -612,6 +963,63 @@ namespace WdRiscv
     unsigned regionMask_  = 0xf;                // This should depend on mem size.
 
     std::shared_mutex amoMutex_;
+    std::mutex ioMutex_;  // Serializes concurrent device/MMR stores.
+
+    // Striped locks keyed by 64-byte line for the accesses that cannot
+    // use a single host atomic. See lockLines.
+    struct alignas(64) LineLock
+    {
+      SpinLock lock_;
+    };
+    static constexpr uint64_t lineLockMask_ = 0x3ff;
+    std::vector<LineLock> lineLocks_ = std::vector<LineLock>(lineLockMask_ + 1);
+    bool concurrent_ = false;  // True if harts run in separate threads.
+
+    bool bufferStores_ = false;             // See bufferStores.
+    std::vector<StoreBuffer> storeBufs_;    // Store buffer of each hart.
+    static thread_local StoreBuffer* threadStoreBuf_;  // Selected by calling thread.
+
+    /// Write the given value to the store buffer selected by the calling
+    /// thread.
+    template <typename T>
+    void bufferStore(uint64_t addr, T value)
+    {
+      for (unsigned i = 0; i < sizeof(T); ++i, ++addr)
+        {
+          auto& [data, mask] = (*threadStoreBuf_)[addr >> 3];
+          unsigned shift = 8 * (addr & 7);
+          data = (data & ~(uint64_t(0xff) << shift)) | (uint64_t(uint8_t(value >> (8*i))) << shift);
+          mask |= uint8_t(1 << (addr & 7));
+        }
+    }
+
+    /// Replace the bytes of the given value, read from memory at the given
+    /// address, by those written to the same address in the store buffer
+    /// selected by the calling thread.
+    template <typename T>
+    void overlayStores(uint64_t addr, T& value) const
+    {
+      const StoreBuffer* buffer = threadStoreBuf_;
+      if (not buffer or buffer->empty())
+        return;
+      uint64_t val = value;
+      for (uint64_t word = addr >> 3; word <= (addr + sizeof(T) - 1) >> 3; ++word)
+        {
+          auto iter = buffer->find(word);
+          if (iter == buffer->end())
+            continue;
+          const auto& [data, mask] = iter->second;
+          for (unsigned byte = 0; byte < 8; ++byte)
+            {
+              uint64_t byteAddr = (word << 3) + byte;
+              if (((mask >> byte) & 1) == 0 or byteAddr < addr or byteAddr >= addr + sizeof(T))
+                continue;
+              unsigned shift = 8 * (byteAddr - addr);
+              val = (val & ~(uint64_t(0xff) << shift)) | (((data >> (8*byte)) & 0xff) << shift);
+            }
+        }
+      value = T(val);
+    }
 
     bool checkUnmappedElf_ = true;
 
@@ -619,8 +1027,65 @@ namespace WdRiscv
     std::unordered_map<std::string, ElfSymbol, util::string_hash, std::equal_to<>> sections_;
     std::unordered_map<uint64_t, std::string> addrToSymName_;
 
+    /// Return the bit of the given hart in a reservation line mask.
+    /// Harts beyond 62 share the last bit.
+    static uint64_t resHartBit(unsigned sysHartIx)
+    { return uint64_t(1) << std::min(sysHartIx, 63u); }
+
+    /// Invalidate the LR reservations overlapping the given range
+    /// except that of the hart with the given index. Only the harts
+    /// marked in the reservation line table entries of the range are
+    /// examined; a hart whose reservation no longer maps to such an
+    /// entry is unmarked. A mark lost to a racing makeLr only makes a
+    /// later invalidation miss, which SC tolerates in concurrent mode
+    /// (see Hart::memWrite).
+    void invalidateLrInRange(uint64_t addr, unsigned size, unsigned skipIx)
+    {
+      uint64_t skipBit = skipIx < 63 ? resHartBit(skipIx) : 0;
+      uint64_t lastLine = (addr + size - 1) >> resLineShift_;
+      for (uint64_t line = addr >> resLineShift_; line <= lastLine; ++line)
+        {
+          auto& slot = resLines_.at(line & resLineMask_);
+          uint64_t harts = slot.load(std::memory_order_relaxed);
+          if ((harts & ~skipBit) == 0) [[likely]]
+            continue;
+
+          for (unsigned ix = 0; ix < reservations_.size(); ++ix)
+            {
+              uint64_t bit = resHartBit(ix);
+              if (ix == skipIx or (harts & bit) == 0)
+                continue;
+              auto& res = reservations_[ix];
+              if (res.overlaps(addr, size))
+                res.invalidate(CancelLrCause::STORE);
+              else if (ix < 63 and not resMapsToSlot(res, line & resLineMask_))
+                slot.fetch_and(~bit, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Return true if any line of the given reservation maps to the
+    /// given reservation line table entry.
+    bool resMapsToSlot(const Reservation& res, uint64_t slotIx) const
+    {
+      uint64_t addr = res.addr_.load(std::memory_order_relaxed);
+      unsigned size = res.size_.load(std::memory_order_relaxed);
+      uint64_t lastLine = (addr + std::max(size, 1u) - 1) >> resLineShift_;
+      for (uint64_t line = addr >> resLineShift_; line <= lastLine; ++line)
+        if ((line & resLineMask_) == slotIx)
+          return true;
+      return false;
+    }
+
     std::vector<Reservation> reservations_;
 
+    // Reservation line table: per (hashed) 64-byte line, a mask of the
+    // harts that may hold an LR reservation on that line. See
+    // invalidateLrInRange.
+    static constexpr unsigned resLineShift_ = 6;
+    static constexpr uint64_t resLineMask_ = 0xfff;
+    std::vector<std::atomic<uint64_t>> resLines_ = std::vector<std::atomic<uint64_t>>(resLineMask_ + 1);
+
     PmaManager pmaMgr_;
 
     // Support for line address traces
@@ -636,8 +1101,26 @@ namespace WdRiscv
     std::vector<std::shared_ptr<IoDevice>> ioDevs_;
 
     /// Callback for read: bool func(uint64_t addr, unsigned size, uint64_t& val);
-    void (*writeObserver_)(void*, uint64_t, unsigned) = nullptr;  // PTE-cache coherence.
-    void* writeObserverCtx_ = nullptr;
+    // Per-page (hashed) write generations. See pageGeneration.
+    static constexpr uint64_t pageGenMask_ = 0xffff;
+    std::vector<std::atomic<uint64_t>> pageGen_ = std::vector<std::atomic<uint64_t>>(pageGenMask_ + 1);
+
+    // Dirty page tracker: one bit per page, set on write while
+    // dirtyTracking_ is true. Used for incremental snapshots. Entry i
+    // points to the bitmap of the pages of the 2 MiB (or page if
+    // larger) region i, null if no page of the region was written.
+    bool dirtyTracking_ = false;
+    unsigned dirtyShift_ = 21;
+    std::vector<std::atomic<std::atomic<uint64_t>*>> dirty_;
+
+#ifndef MEM_CALLBACKS
+    // Touched-region tracker: one flag per 2 MiB region of the flat
+    // memory, set on the first write (or load) to the region. Regions
+    // never written are demand-zero and need not be visited.
+    static constexpr unsigned touchShift_ = 21;
+    std::vector<std::atomic<uint8_t>> touched_;
+#endif
+
     std::function<bool(uint64_t, unsigned, uint64_t&)> readCallback_ = nullptr;
 
     /// Callback for write: bool func(uint64_t addr, unsigned size, uint64_t val);
@@ -646,6 +1129,11 @@ namespace WdRiscv
     /// Callback to initialize a page of memory.
     std::function<bool(uint64_t, const std::span<uint8_t>)> initPageCallback_ = nullptr;
 
+    bool externalCallbacks_ = false;  // See markExternalCallbacks.
+
+    /// Callback to obtain the host address of a target address.
+    std::function<uint8_t*(uint64_t)> hostAddressCallback_ = nullptr;
+
     /// Load a file into the given vector. Throw an exception if file cannot be opened.
     static void loadFile(const std::string& filename, std::vector<uint8_t>& data);
   };
@@ -61,6 +61,8 @@ PerfApi<URV>::PerfApi(SystemType& system)
 
   hartPacketMaps_.resize(n);
   hartStoreMaps_.resize(n);
+  for (unsigned i = 0; i < n; ++i)
+    hartPacketPools_.push_back(std::make_shared<PacketPool>());
   hartLastRetired_.resize(n, initHartLastRetired);
   hartRegProducers_.resize(n);
   hartSpecLrs_.resize(n);
@@ -206,7 +208,7 @@ PerfApi<URV>::fetch(unsigned hartIx, uint64_t time, uint64_t tag, uint64_t vpc,
   uint64_t gpc = 0; // Guest physical pc.
   cause = hart->fetchInstNoTrap(vpc, ppc, ppc2, gpc, opcode);  // hart is now raw pointer
 
-  auto packet = std::make_shared<InstrPac>(tag, vpc, ppc, ppc2);
+  auto packet = hartPacketPools_[hartIx]->make(tag, vpc, ppc, ppc2);
   assert(packet);
   packet->fetched_ = true;
   packet->opcode_= opcode;
@@ -504,12 +506,8 @@ PerfApi<URV>::execute(unsigned hartIx, InstrPac& packet)
   if (not hart.peekCsr(CSRN::MSTATUS, prevMstatus))
     assert(0 && "Error: Assertion failed");
 
-  // Save hart register values corresponding to packet operands in prevVal.
-  std::array<OpVal, 9> prevVal;
-  bool saveOk = saveHartValues(hart, packet, prevVal);
-
   // Install packet operand values (some obtained from previous in-flight instructions)
-  // into the hart registers.
+  // into the hart registers logging the values they replace in undoLog_.
   bool setOk = setHartValues(hart, packet);
 
   assert(hartLastRetired_[hartIx] == initHartLastRetired or packet.tag_ > hartLastRetired_[hartIx]);
@@ -566,8 +564,8 @@ PerfApi<URV>::execute(unsigned hartIx, InstrPac& packet)
   // retires and reveals the architectural post-write value.
   //
   // Skip CSRs that are explicit operands of the current instruction — setHartValues
-  // / restoreHartValues already manage those via the operand-rename path, and
-  // forwarding-poke/restore here would race with restoreHartValues.
+  // / undoHartValues already manage those via the operand-rename path, and
+  // forwarding-poke/restore here would race with undoHartValues.
   struct CsrFwdSave { unsigned csrNum; URV prev; bool ok; };
   std::vector<CsrFwdSave> csrFwdSaves;
   {
@@ -654,7 +652,7 @@ PerfApi<URV>::execute(unsigned hartIx, InstrPac& packet)
     packet.trapCause_ = hart.lastTrapCause();
 
   // If save fails or set fails, there must be a trap.
-  if (not saveOk or not setOk)
+  if (not setOk)
     {
       if (not trap)
         cerr << "PerfApi::execute: save/set operands failed for instruction tag " << packet.tag_ << '\n';
@@ -667,7 +665,7 @@ PerfApi<URV>::execute(unsigned hartIx, InstrPac& packet)
   recordExecutionResults(hart, packet);
 
   // CSR-write speculative outcome capture. Snapshot rd and the new CSR value while
-  // the hart is still in the post-singleStep state (before restoreHartValues wipes
+  // the hart is still in the post-singleStep state (before undoHartValues wipes
   // the CSR back to its pre-execute value). peekCsr gives the post-execute CSR
   // value; rd already lives in destValues_. Done unconditionally for every
   // non-trapping CSR op; retire() reconciles it for writes, the model decides
@@ -729,8 +727,8 @@ PerfApi<URV>::execute(unsigned hartIx, InstrPac& packet)
       hart.setPrivilegeMode(hart.lastPrivMode());
     }
 
-  // Restore hart registers that we changed before single step.
-  restoreHartValues(hart, packet, prevVal);
+  // Restore hart registers that we or the instruction changed.
+  undoHartValues(hart, packet);
 
   URV mstatus = 0;
   if (not hart.peekCsr(CSRN::MSTATUS, mstatus))
@@ -1915,6 +1913,98 @@ InstrPac::branchTargetFromDecode() const
 }
 
 
+void
+InstrPac::recycle(uint64_t tag, uint64_t iva, uint64_t ipa, uint64_t ipa2)
+{
+  tag_ = tag;
+  iva_ = iva;
+  ipa_ = ipa;
+  ipa2_ = ipa2;
+  nextIva_ = 0;
+
+  predicted_ = false;
+  prTaken_ = false;
+  taken_ = false;
+  mispredicted_ = false;
+  shouldFlush_ = false;
+
+  fetched_ = false;
+  decoded_ = false;
+  executed_ = false;
+  retired_ = false;
+  drained_ = false;
+  trap_ = false;
+  interrupt_ = false;
+  virtMode_ = false;
+  deviceAccess_ = false;
+
+  opcode_ = 0;
+
+  dva_ = 0;
+  dpa_ = 0;
+  dpa2_ = 0;
+  dsize_ = 0;
+  stData_ = 0;
+  flushVa_ = 0;
+  execTime_ = 0;
+  prTarget_ = 0;
+
+  di_ = WdRiscv::DecodedInst();
+
+  trapCause_ = 0;
+  operandCount_ = 0;
+  changedCsrCount_ = 0;
+  privMode_ = WdRiscv::PrivilegeMode::Machine;
+
+  // Clear the vector values in place to keep their buffers.
+  auto clearVal = [] (OpVal& val) {
+    val.scalar = 0;
+    val.vec.clear();
+  };
+
+  auto clearOperand = [&clearVal] (Operand& op) {
+    op.type = OperandType::IntReg;
+    op.mode = OperandMode::None;
+    op.number = 0;
+    op.lmul = 0;
+    clearVal(op.value);
+    clearVal(op.prevValue);
+  };
+
+  for (auto& op : operands_)
+    clearOperand(op);
+  for (auto& op : changedCsrs_)
+    clearOperand(op);
+  for (auto& producer : opProducers_)
+    producer.clear();
+  for (auto& [regIx, val] : destValues_)
+    {
+      regIx = 0;
+      clearVal(val);
+    }
+
+  savedLrAddr_ = 0;
+  savedLrSize_ = 0;
+  hadPriorLr_ = false;
+
+  scExecuted_ = false;
+  scExecSuccess_ = false;
+  scStoreVal_ = 0;
+  scPa1_ = 0;
+  scPa2_ = 0;
+  scSize_ = 0;
+
+  csrExecuted_ = false;
+  csrNum_ = 0;
+  csrExecRd_ = 0;
+  csrExecNewVal_ = 0;
+
+  stDataMap_.clear();
+  vecAddrs_.clear();
+  fetchWalks_.clear();
+  dataWalks_.clear();
+}
+
 template <typename URV>
 uint64_t
 InstrPac::executedDestVal(const WdRiscv::Hart<URV>& hart, unsigned size, unsigned elemIx, unsigned field) const
@@ -1966,7 +2056,7 @@ size_t InstrPac::getPacketSize() const
 
   totalSize += sizeof(*this); // Get the size of the object itself
 
-  // stDataMap_: unordered_map<uint64_t, uint8_t>
+  // stDataMap_: FlatMap<uint64_t, uint8_t>
   totalSize += stDataMap_.size() * (sizeof(uint64_t) + sizeof(uint8_t));  // key-value pairs
 
   // vecAddrs_: vector<VaPaSkip> where VaPaSkip = tuple<uint64_t, uint64_t, bool>
@@ -1988,69 +2078,6 @@ size_t InstrPac::getPacketSize() const
 }
 
 
-template <typename URV>
-bool
-PerfApi<URV>::saveHartValues(HartType& hart, const InstrPac& packet,
-                        std::array<OpVal, 9>& prevVal)
-{
-  using OM = WdRiscv::OperandMode;
-  using OT = WdRiscv::OperandType;
-
-  bool ok = true;
-  const unsigned opCount = packet.operandCount_;
-
-  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
-  for (unsigned i = 0; i < opCount; ++i)
-    {
-      const auto& op = packet.operands_[i];
-      auto mode = op.mode;
-      if (mode == OM::None)
-        continue;
-
-      auto type = op.type;
-      uint32_t number = op.number;
-
-      switch (type)
-        {
-        case OT::IntReg:
-          {
-            URV tmp{};
-            if (not hart.peekIntReg(number, tmp))
-              assert(0 && "Error: Assertion failed");
-            prevVal[i].scalar = tmp;
-          }
-          break;
-
-        case OT::FpReg:
-          ok = hart.peekFpReg(number, prevVal[i].scalar) and ok;
-          break;
-
-        case OT::CsReg:
-          {
-            URV tmp{};
-            ok = hart.peekCsr(CSRN(number), tmp) and ok;
-            prevVal[i].scalar = tmp;
-          }
-          break;
-
-        case OT::VecReg:
-          ok = peekVecRegGroup(hart, number, op.lmul, prevVal[i]) and ok;
-          break;
-
-        case OT::Imm:
-          break;
-
-        default:
-          assert(0 && "Error: Assertion failed");
-          break;
-        }
-    }
-  // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
-
-  return ok;
-}
-
-
 template <typename URV>
 void
 PerfApi<URV>::saveImsicTopei(HartType& hart, CSRN csrn, unsigned& id, unsigned& guest)
@@ -2117,27 +2144,20 @@ PerfApi<URV>::restoreImsicTopei(HartType& hart, CSRN csrn, unsigned id, unsigned
 
 template <typename URV>
 void
-PerfApi<URV>::restoreHartValues(HartType& hart, const InstrPac& packet,
-                           const std::array<OpVal, 9>& prevVal)
+PerfApi<URV>::undoHartValues(HartType& hart, const InstrPac& packet)
 {
-  using OM = WdRiscv::OperandMode;
   using OT = WdRiscv::OperandType;
 
-  const unsigned opCount = packet.operandCount_;
-
-  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
-  for (unsigned i = 0; i < opCount; ++i)
+  // Most recent entry first so that the oldest value of a register logged more than
+  // once ends up in the hart.
+  for (unsigned i = undoCount_; i > 0; --i)
     {
-      const auto& op = packet.operands_[i];
-      auto mode = op.mode;
-      auto type = op.type;
-      uint32_t number = op.number;
-      uint64_t prev = prevVal[i].scalar;
-      const std::vector<uint8_t>& vec = prevVal[i].vec;
-      if (mode == OM::None)
-        continue;
+      const auto& entry = undoLog_.at(i - 1);
+      uint32_t number = entry.number;
+      uint64_t prev = entry.prev.scalar;
+      const std::vector<uint8_t>& vec = entry.prev.vec;
 
-      switch (type)
+      switch (entry.type)
         {
         case OT::IntReg:
           if (not hart.pokeIntReg(number, URV(prev)))
@@ -2175,7 +2195,8 @@ PerfApi<URV>::restoreHartValues(HartType& hart, const InstrPac& packet,
           break;
         }
     }
-  // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+
+  undoCount_ = 0;
 }
 
 
@@ -2183,19 +2204,55 @@ template <typename URV>
 bool
 PerfApi<URV>::setHartValues(HartType& hart, const InstrPac& packet)
 {
+  using OM = WdRiscv::OperandMode;
+  using OT = WdRiscv::OperandType;
+
   bool ok = true;
   const unsigned opCount = packet.operandCount_;
+  undoCount_ = 0;
 
   // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
   for (unsigned i = 0; i < opCount; ++i)
     {
       const auto& op = packet.operands_[i];
-      if (op.mode == WdRiscv::OperandMode::None)
+      auto type = op.type;
+      if (op.mode == OM::None or type == OT::Imm)
         continue;
 
-      auto type = op.type;
       uint32_t regNum = op.number;
-      ok = pokeRegister(hart, type, regNum, op.value) and ok;
+
+      // A register already holding the packet value need not be poked. It need not be
+      // logged either unless the instruction writes it. CSRs are always poked: some
+      // have poke side effects.
+      bool same = false;
+      if (type == OT::IntReg)
+        {
+          URV val{};
+          same = hart.peekIntReg(regNum, val) and val == URV(op.value.scalar);
+        }
+      else if (type == OT::FpReg)
+        {
+          uint64_t val = 0;
+          same = hart.peekFpReg(regNum, val) and val == op.value.scalar;
+        }
+      else if (type == OT::VecReg)
+        same = sameVecRegGroup(hart, regNum, op.value);
+
+      if (same and op.mode == OM::Read)
+        continue;
+
+      auto& entry = undoLog_.at(undoCount_++);
+      entry.type = type;
+      entry.number = regNum;
+      entry.prev.scalar = 0;
+      entry.prev.vec.clear();
+      if (type == OT::VecReg)
+        ok = peekVecRegGroup(hart, regNum, op.lmul, entry.prev) and ok;
+      else
+        ok = peekRegister(hart, type, regNum, entry.prev) and ok;
+
+      if (not same)
+        ok = pokeRegister(hart, type, regNum, op.value) and ok;
     }
   // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
 
@@ -2203,6 +2260,27 @@ PerfApi<URV>::setHartValues(HartType& hart, const InstrPac& packet)
 }
 
 
+template <typename URV>
+bool
+PerfApi<URV>::sameVecRegGroup(const HartType& hart, unsigned regNum, const OpVal& value)
+{
+  size_t bytesPerReg = hart.vecRegs().bytesPerRegister();
+  const auto& vec = value.vec;
+  if (vec.empty() or bytesPerReg == 0 or vec.size() % bytesPerReg != 0)
+    return false;
+
+  for (size_t i = 0; i < vec.size() / bytesPerReg; ++i)
+    {
+      auto data = hart.vecRegBytes(regNum + i);
+      if (data.size() != bytesPerReg or
+          not std::equal(data.begin(), data.end(), vec.begin() + ptrdiff_t(i*bytesPerReg)))
+        return false;
+    }
+
+  return true;
+}
+
+
 template <typename URV>
 bool
 PerfApi<URV>::peekRegister(HartType& hart, WdRiscv::OperandType type, unsigned regNum,
@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <deque>
+#include <memory>
 #include <vector>
 #include "System.hpp"
 #include "Hart.hpp"
@@ -30,6 +32,7 @@ namespace TT_PERF         // Tenstorrent Whisper Performance Model API
   // This API uses a clear separation between ownership and non-owning access:
   //
   // OWNERSHIP (shared_ptr<InstrPac>):
+  //   - PacketPool: allocates packets and recycles them once their last owner releases them
   //   - FastPacketMap: owns all instruction packets
   //   - Instruction::mPacPtr: model takes shared ownership to extend packet lifetime
   //   - OpProducer/RegProducers: dependency chains require shared ownership
@@ -316,6 +319,86 @@ namespace TT_PERF         // Tenstorrent Whisper Performance Model API
     size_t activeCount_ = 0;    // Count of non-null entries
   };
 
+  /// Map kept as a vector of key/value pairs sorted by key. Suited to small maps with
+  /// keys inserted mostly in increasing order: lookups are binary searches and a
+  /// cleared map keeps its storage for reuse.
+  template <typename K, typename V>
+  class FlatMap
+  {
+  public:
+
+    using value_type = std::pair<K, V>;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    /// Return a reference to the value of the given key inserting a default value if
+    /// key is not present.
+    V& operator[](const K& key)
+    {
+      auto it = lower_bound(key);
+      if (it == items_.end() or it->first != key)
+        it = items_.emplace(it, key, V{});
+      return it->second;
+    }
+
+    /// Return an iterator to the first item with a key not less than the given key.
+    iterator lower_bound(const K& key)
+    { return std::ranges::lower_bound(items_, key, {}, &value_type::first); }
+
+    const_iterator lower_bound(const K& key) const
+    { return std::ranges::lower_bound(items_, key, {}, &value_type::first); }
+
+    /// Return an iterator to the item with the given key or end() if no such item.
+    iterator find(const K& key)
+    {
+      auto it = lower_bound(key);
+      return (it != items_.end() and it->first == key) ? it : items_.end();
+    }
+
+    const_iterator find(const K& key) const
+    {
+      auto it = lower_bound(key);
+      return (it != items_.end() and it->first == key) ? it : items_.end();
+    }
+
+    /// Remove the item with the given key. Return the number of removed items.
+    size_t erase(const K& key)
+    {
+      auto it = find(key);
+      if (it == items_.end())
+        return 0;
+      items_.erase(it);
+      return 1;
+    }
+
+    /// Remove the items in the given range.
+    iterator erase(const_iterator first, const_iterator last)
+    { return items_.erase(first, last); }
+
+    iterator begin()              { return items_.begin(); }
+    iterator end()                { return items_.end(); }
+    const_iterator begin() const  { return items_.begin(); }
+    const_iterator end() const    { return items_.end(); }
+
+    auto rbegin()        { return items_.rbegin(); }
+    auto rend()          { return items_.rend(); }
+    auto rbegin() const  { return items_.rbegin(); }
+    auto rend() const    { return items_.rend(); }
+
+    size_t size() const
+    { return items_.size(); }
+
+    bool empty() const
+    { return items_.empty(); }
+
+    void clear()
+    { items_.clear(); }
+
+  private:
+
+    std::vector<value_type> items_;
+  };
+
   using ExceptionCause = WdRiscv::ExceptionCause;
   using OperandType = WdRiscv::OperandType;
   using OperandMode = WdRiscv::OperandMode;
@@ -359,6 +442,8 @@ namespace TT_PERF         // Tenstorrent Whisper Performance Model API
     template <typename URV>
     friend class PerfApi;
 
+    friend class PacketPool;
+
     /// Constructor: iva/ipa are the instruction virtual/physical addresses.  For
     /// instruction crossing page boundary, ipa2 is the physical address of the other
     /// page. I not crossing page boundary ipa2 is same as ipa.
@@ -656,6 +741,11 @@ namespace TT_PERF         // Tenstorrent Whisper Performance Model API
 
   protected:
 
+    /// Reinitialize this packet, as if newly constructed with the given tag and
+    /// addresses, keeping the storage of its containers: scalar fields are reset and
+    /// containers are cleared in place.
+    void recycle(uint64_t tag, uint64_t iva, uint64_t ipa, uint64_t ipa2);
+
     /// Return the value of the destination register of the instruction of this packet
     /// which must be the instruction currently being retired. The instruction must be
     /// executed. The element index and field are used for vector instructions. If
@@ -767,7 +857,7 @@ namespace TT_PERF         // Tenstorrent Whisper Performance Model API
     // Large containers placed at the end
 
     // Used for committing vector store and for forwarding.
-    std::unordered_map<uint64_t, uint8_t> stDataMap_;
+    FlatMap<uint64_t, uint8_t> stDataMap_;
 
     // Vector of va/pa/masked of vector load/store instruction. The bool (skip) is set
     // if the element is skipped (masked-off or tail-element).
@@ -779,6 +869,115 @@ namespace TT_PERF         // Tenstorrent Whisper Performance Model API
   };
 
 
+  /// Per-hart pool of instruction packets. A packet released by its last owner returns
+  /// to the pool and is reused, with the storage of its containers, by a later fetch.
+  /// The shared_ptr control blocks are recycled too: once the pool holds as many
+  /// packets as are in flight, the lifecycle of a packet (fetch to retire or drain)
+  /// does no heap allocation. Not thread safe: the packets of a hart must be released
+  /// by the thread driving that hart.
+  class PacketPool : public std::enable_shared_from_this<PacketPool>
+  {
+  public:
+
+    PacketPool() = default;
+
+    ~PacketPool()
+    {
+      while (not packets_.empty())
+        {
+          delete packets_.back();
+          packets_.pop_back();
+        }
+      for (auto* block : blocks_)
+        ::operator delete(block);
+    }
+
+    PacketPool(const PacketPool&) = delete;
+    PacketPool& operator=(const PacketPool&) = delete;
+
+    /// Return a packet with the given tag and addresses (see InstrPac constructor).
+    /// Pool must be owned by a shared_ptr.
+    std::shared_ptr<InstrPac> make(uint64_t tag, uint64_t iva, uint64_t ipa, uint64_t ipa2)
+    {
+      InstrPac* packet = nullptr;
+      if (packets_.empty())
+        packet = new InstrPac(tag, iva, ipa, ipa2);
+      else
+        {
+          packet = packets_.back();
+          packets_.pop_back();
+          packet->recycle(tag, iva, ipa, ipa2);
+        }
+      return { packet, Recycler{this}, BlockAllocator<InstrPac>{shared_from_this()} };
+    }
+
+  private:
+
+    /// Deleter of pooled packets: drop the references to the producers of the packet
+    /// and return it to the pool.
+    struct Recycler
+    {
+      PacketPool* pool = nullptr;
+
+      void operator()(InstrPac* packet) const
+      {
+        for (auto& producer : packet->opProducers_)
+          producer.clear();
+        pool->packets_.push_back(packet);
+      }
+    };
+
+    /// Allocator of shared_ptr control blocks. It references the pool: the pool
+    /// outlives the packets still owned by the performance model.
+    template <typename T>
+    struct BlockAllocator
+    {
+      using value_type = T;
+
+      explicit BlockAllocator(std::shared_ptr<PacketPool> pool)
+        : pool_(std::move(pool))
+      { }
+
+      template <typename U>
+      BlockAllocator(const BlockAllocator<U>& other)
+        : pool_(other.pool_)
+      { }
+
+      T* allocate(size_t n)
+      {
+        auto& blocks = pool_->blocks_;
+        if (n * sizeof(T) == pool_->blockSize_ and not blocks.empty())
+          {
+            void* block = blocks.back();
+            blocks.pop_back();
+            return static_cast<T*>(block);
+          }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+      }
+
+      void deallocate(T* block, size_t n)
+      {
+        if (pool_->blockSize_ == 0)
+          pool_->blockSize_ = n * sizeof(T);
+        if (n * sizeof(T) == pool_->blockSize_)
+          pool_->blocks_.push_back(block);
+        else
+          ::operator delete(block);
+      }
+
+      template <typename U>
+      bool operator==(const BlockAllocator<U>& other) const
+      { return pool_ == other.pool_; }
+
+      std::shared_ptr<PacketPool> pool_;
+    };
+
+    std::vector<InstrPac*> packets_;   // Released packets.
+    std::vector<void*> blocks_;        // Released control blocks.
+    size_t blockSize_ = 0;             // Size of a control block.
+  };
+
+
   template <typename URV>
   class PerfApi
   {
@@ -1070,21 +1269,21 @@ namespace TT_PERF         // Tenstorrent Whisper Performance Model API
       return false;
     }
 
-    /// Save hart register values corresponding to packet operands in prevVal.  Return
-    /// true on success. Return false if any of the required hart registers cannot be
-    /// read.
-    static bool saveHartValues(HartType& hart, const InstrPac& packet,
-                               std::array<OpVal, 9>& prevVal);
-
     /// Install packet operand values (some obtained from previous in-flight instructions)
-    /// into the hart registers. Return true on success. Return false if any of the
-    /// required hart registers cannot be written.
-    static bool setHartValues(HartType& hart, const InstrPac& packet);
+    /// into the hart registers. Int/fp/vector registers already holding the packet value
+    /// are left untouched. Record in undoLog_ the previous value of every register poked
+    /// here and of every register the instruction may write so that the execution can be
+    /// rolled back in proportion to the number of changed registers. Return true on
+    /// success. Return false if any of the required hart registers cannot be read or
+    /// written.
+    bool setHartValues(HartType& hart, const InstrPac& packet);
+
+    /// Restore the hart registers recorded in undoLog_, most recent entry first, and
+    /// empty the log.
+    void undoHartValues(HartType& hart, const InstrPac& packet);
 
-    /// Restore the hart registers corresponding to the packet operands to the values in
-    /// the prevVal array.
-    static void restoreHartValues(HartType& hart, const InstrPac& packet,
-                                  const std::array<OpVal, 9>& prevVal);
+    /// Return true if the vector register group starting at regNum holds the given value.
+    static bool sameVecRegGroup(const HartType& hart, unsigned regNum, const OpVal& value);
 
     /// Helper to execute. Restore IMSIC top interrupt if csrn is one of M/S/VS TOPEI.
     static void restoreImsicTopei(HartType& hart, WdRiscv::CsrNumber csrn, unsigned id, unsigned guest);
@@ -1112,7 +1311,7 @@ namespace TT_PERF         // Tenstorrent Whisper Performance Model API
   private:
 
     /// Map an instruction tag to corresponding packet (for store forwarding).
-    using StoreMap = std::map<uint64_t, std::shared_ptr<InstrPac>>;
+    using StoreMap = FlatMap<uint64_t, std::shared_ptr<InstrPac>>;
 
     /// Map a global register index to the in-flight instruction producing that
     /// register. This is register renaming.
@@ -1136,15 +1335,26 @@ namespace TT_PERF         // Tenstorrent Whisper Performance Model API
       uint64_t newVal = 0;
     };
 
+    /// Hart register changed by a speculative execution and its value before the change.
+    struct UndoEntry
+    {
+      OperandType type = OperandType::IntReg;
+      unsigned number = 0;
+      OpVal prev;
+    };
+
     SystemType& system_;
     std::shared_ptr<InstrPac> prevFetch_;
 
     /// Per-hart map of in flight instruction packets. Uses FastPacketMap for O(1) access.
     std::vector<FastPacketMap> hartPacketMaps_;
 
-    /// Per-hart map of in flight executed store packets (uses std::map for lower_bound support).
+    /// Per-hart map of in flight executed store packets (sorted by tag for lower_bound support).
     std::vector<StoreMap> hartStoreMaps_;
 
+    /// Per-hart pool of instruction packets.
+    std::vector<std::shared_ptr<PacketPool>> hartPacketPools_;
+
     /// Per-hart index tag the last retired instruction.
     std::vector<uint64_t> hartLastRetired_;
 
@@ -1163,6 +1373,11 @@ namespace TT_PERF         // Tenstorrent Whisper Performance Model API
     /// retire of the CSR write and on flush. Mirror of hartSpecLrs_.
     std::vector<std::vector<SpecCsrEntry>> hartSpecCsrs_;
 
+    /// Undo log of the hart registers changed by the execute in progress. Entries are
+    /// reused across executions to keep their vector storage.
+    std::array<UndoEntry, InstrPac::maxOpCount> undoLog_;
+    unsigned undoCount_ = 0;
+
     /// Cached raw Hart pointers.
     std::vector<HartType*> hartRawPtrs_;
 
@@ -19,6 +19,7 @@
 #include <vector>
 #include <array>
 #include <algorithm>
+#include <bit>
 #include <unordered_map>
 #include <iostream>
 #include <string>
@@ -748,6 +749,27 @@ namespace WdRiscv
       return false;
     }
 
+    /// Return true if every word in the address range [addr0, addr1] has
+    /// the same PMA and none is a memory mapped register.
+    bool isUniform(uint64_t addr0, uint64_t addr1) const
+    {
+      for (const auto& region : regions_)
+        {
+          if (not region.valid_)
+            continue;
+          if (region.addrMask_ != ~uint64_t(0))
+            return false;  // Masked region: don't bother.
+          if (region.overlaps(addr0, addr1))
+            return (region.overlaps(addr0) and region.overlaps(addr1) and
+                    not region.pma_.hasMemMappedReg());
+        }
+      return addr1 < memSize_;
+    }
+
+    /// Return a number that changes whenever the regions change.
+    uint64_t generation() const
+    { return pmaGen_; }
+
     /// Used for tracing to determine if an address matches multiple PMAs.
     bool matchMultiplePma(uint64_t addr) const
     {
@@ -860,6 +882,43 @@ namespace WdRiscv
       return mmRegs_->overlaps(start, end);
     }
 
+    /// Return true if all the addresses of the given range [start,end]
+    /// have the attributes of start: no region boundary falls within the
+    /// range and no region of the range has memory mapped registers.
+    /// Conservative: may return false for a uniform range.
+    bool isUniformRange(uint64_t start, uint64_t end) const
+    {
+      if (start > end)
+        return false;
+      if (start < memSize_ and end >= memSize_)
+        return false;
+
+      // Addresses of the range only differ in the bits of lowBits.
+      uint64_t diff = start ^ end;
+      uint64_t lowBits = diff ? (std::bit_floor(diff) - 1) | std::bit_floor(diff) : 0;
+
+      for (const auto& region : regions_)
+        {
+          if (not region.valid_)
+            continue;
+          if (region.addrMask_ != ~uint64_t(0))
+            {
+              if (region.addrMask_ & lowBits)
+                return false;
+              if (region.pma_.hasMemMappedReg() and regionMatches(region, start))
+                return false;
+              continue;
+            }
+          if (not region.overlaps(start, end))
+            continue;
+          if (region.pma_.hasMemMappedReg())
+            return false;
+          if (region.firstAddr_ > start or region.lastAddr_ < end)
+            return false;
+        }
+      return true;
+    }
+
     const std::vector<PmaTrace>& getPmaTrace() const
     { return pmaTrace_; }
 
@@ -869,6 +928,10 @@ namespace WdRiscv
     void enableTrace(bool flag)
     { trace_ = flag; }
 
+    /// Return true if access tracing is enabled.
+    bool isTraceEnabled() const
+    { return trace_; }
+
     /// This is to differentiate fetch from ld/st accesses.
     void setAccReason(AccessReason reason)
     { reason_ = reason; }
@@ -196,6 +196,16 @@ namespace WdRiscv
       return res;
     }
 
+    /// Return true if every word in the address range [addr0, addr1] is
+    /// governed by the same PMP entry (or by no entry).
+    bool isUniform(uint64_t addr0, uint64_t addr1) const
+    {
+      for (const auto& region : regions_)
+        if (region.addr0_ <= addr1 and addr0 <= region.addr1_)
+          return region.contains(addr0) and region.contains(addr1);
+      return true;
+    }
+
     /// Used for tracing to determine if an address matches multiple PMPs.
     bool matchMultiplePmp(uint64_t addr) const
     {
@@ -347,6 +357,10 @@ namespace WdRiscv
     void enableTrace(bool flag)
     { trace_ = flag; }
 
+    /// Return true if access tracing is enabled.
+    bool isTraceEnabled() const
+    { return trace_; }
+
     /// This is to differentiate fetch from ld/st accesses.
     void setAccReason(AccessReason reason)
     { reason_ = reason; }
@@ -722,6 +722,10 @@ Session<URV>::applyCmdLineArgs(const Args& args, Hart<URV>& hart,
   // Set the compression and decompression types for the system
   system.setCompressionType(args.compressionType);
   system.setDecompressionType(args.decompressionType);
+  if (args.incrementalSnap)
+    system.enableIncrementalSnapshots(true);
+  if (args.lazySnapLoad)
+    system.enableLazySnapshotLoad(true);
 
   if (clib)  // Linux or Newlib enabled.
     sanitizeStackPointer(hart, args.verbose);
@@ -1001,6 +1005,18 @@ Session<URV>::applyCmdLineArgs(const Args& args, Hart<URV>& hart,
 	hart.setTlbSize(size);
     }
 
+  if (args.tlbWays)
+    {
+      size_t ways = *args.tlbWays;
+      if (ways == 0 or (ways & (ways-1)) != 0)
+	{
+	  std::cerr << "Error: TLB ways must be a non-zero power of 2\n";
+	  errors++;
+	}
+      else
+	hart.setTlbWays(ways);
+    }
+
   if (args.nmiVec)
     hart.defineNmiPc(*args.nmiVec);
 
@@ -1296,6 +1312,9 @@ Session<URV>::run(const Args& args)
       return runInteractive(ofs);
     }
 
+  if (args.quantum)
+    system.setQuantum(*args.quantum);
+
   if (not args.snapshotPeriods.empty())
     return system.snapshotRun(traceFiles_, args.snapshotPeriods,
                               args.snapshotPeriods.size() > 1 or args.aperiodicSnp);
@@ -1322,7 +1341,7 @@ Session<URV>::run(const Args& args)
   gettimeofday(&t1, nullptr);
 
   // Report retired isntructions for deterministic runs.
-  if (not args.deterministic.empty())
+  if (not args.deterministic.empty() or args.quantum)
     {
       uint64_t count = 0;
       for (unsigned i = 0; i < system.hartCount(); ++i)
@@ -0,0 +1,359 @@
+// Copyright 2025 Tenstorrent Corporation or its affiliates.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+#include "SnapshotChunks.hpp"
+#include "util.hpp"
+
+
+using namespace WdRiscv;
+
+
+namespace
+{
+  /// Call produce(i, buffer) for each i in [0, count) on the given
+  /// number of worker threads and consume(i, buffer) on the calling
+  /// thread in increasing order of i. The workers run ahead of the
+  /// calling thread by at most 4 items per worker: memory use is bounded.
+  /// Return false if any call returned false (the remaining items are
+  /// skipped).
+  template <typename P, typename C>
+  bool
+  orderedPipeline(size_t count, unsigned threads, const P& produce, const C& consume)
+  {
+    const size_t window = size_t(threads) * 4;
+    std::vector<std::vector<uint8_t>> buffers(window);
+    std::vector<char> ready(window, false);
+    std::mutex mutex;
+    std::condition_variable producedCv, consumedCv;
+    size_t next = 0;  // Next item to produce.
+    size_t done = 0;  // Number of items consumed.
+    bool ok = true;
+
+    auto worker = [&]() {
+      while (true)
+        {
+          size_t i = 0;
+          {
+            std::unique_lock lock(mutex);
+            consumedCv.wait(lock, [&] { return not ok or next >= count or next < done + window; });
+            if (not ok or next >= count)
+              return;
+            i = next++;
+          }
+          bool good = produce(i, buffers.at(i % window));
+          {
+            std::lock_guard lock(mutex);
+            ready.at(i % window) = true;
+            ok = ok and good;
+          }
+          producedCv.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    for (unsigned t = 0; t < threads; ++t)
+      pool.emplace_back(worker);
+
+    for (size_t i = 0; i < count; ++i)
+      {
+        {
+          std::unique_lock lock(mutex);
+          producedCv.wait(lock, [&] { return not ok or ready.at(i % window); });
+          if (not ok)
+            break;
+        }
+        bool good = consume(i, buffers.at(i % window));
+        {
+          std::lock_guard lock(mutex);
+          ready.at(i % window) = false;
+          ++done;
+          ok = ok and good;
+        }
+        consumedCv.notify_all();
+      }
+
+    for (auto& thread : pool)
+      thread.join();
+
+    return ok;
+  }
+
+
+  /// Read exactly size bytes at the given offset of the given file.
+  bool
+  preadAll(int fd, void* buffer, size_t size, uint64_t offset)
+  {
+    auto* dst = static_cast<uint8_t*>(buffer);
+    while (size)
+      {
+        ssize_t n = pread(fd, dst, size, off_t(offset));
+        if (n <= 0)
+          return false;
+        dst += n;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        size -= n;
+        offset += n;
+      }
+    return true;
+  }
+}
+
+
+SnapshotChunks::~SnapshotChunks()
+{
+  if (fd_ >= 0)
+    close(fd_);
+}
+
+
+unsigned
+SnapshotChunks::threadCount(unsigned requested)
+{
+  if (requested)
+    return requested;
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+
+bool
+SnapshotChunks::save(const std::string& path,
+                     const std::vector<std::pair<uint64_t, uint64_t>>& blocks,
+                     const ReadFunc& readFunc, unsigned threads)
+{
+  std::vector<Chunk> chunks;
+  for (const auto& [addr, size] : blocks)
+    for (uint64_t offset = 0; offset < size; offset += chunkSize_)
+      chunks.push_back(Chunk{addr + offset, std::min(chunkSize_, size - offset), 0, 0});
+
+  util::file::SharedFile out = util::file::make_shared_file(fopen(path.c_str(), "wb"));
+  if (not out)
+    {
+      std::cerr << "Error: SnapshotChunks::save failed - cannot open " << path
+                << " for write\n";
+      return false;
+    }
+
+  // Header and a placeholder index rewritten once offsets are known.
+  uint64_t count = chunks.size();
+  if (fwrite(magic_, sizeof(magic_), 1, out.get()) != 1 or
+      fwrite(&count, sizeof(count), 1, out.get()) != 1 or
+      (count and fwrite(chunks.data(), sizeof(Chunk), count, out.get()) != count))
+    {
+      std::cerr << "Error: SnapshotChunks::save failed - write into " << path << '\n';
+      return false;
+    }
+  uint64_t offset = sizeof(magic_) + sizeof(count) + count * sizeof(Chunk);
+
+  // Compress chunks on worker threads and append them in order from this
+  // thread as they complete.
+  auto compressChunk = [&chunks, &readFunc] (size_t i, std::vector<uint8_t>& dst) {
+    const auto& chunk = chunks.at(i);
+    std::vector<uint8_t> raw(chunk.size);
+    readFunc(chunk.addr, raw);
+    uLongf len = compressBound(chunk.size);
+    dst.resize(len);
+    if (compress2(dst.data(), &len, raw.data(), chunk.size, 1) != Z_OK)
+      {
+        std::cerr << "Error: SnapshotChunks::save failed - compression error\n";
+        return false;
+      }
+    dst.resize(len);
+    return true;
+  };
+
+  auto writeChunk = [&chunks, &offset, &out, &path] (size_t i, const std::vector<uint8_t>& data) {
+    auto& chunk = chunks.at(i);
+    chunk.offset = offset;
+    chunk.compSize = data.size();
+    if (fwrite(data.data(), 1, data.size(), out.get()) != data.size())
+      {
+        std::cerr << "Error: SnapshotChunks::save failed - write into " << path << '\n';
+        return false;
+      }
+    offset += data.size();
+    return true;
+  };
+
+  if (not orderedPipeline(chunks.size(), threadCount(threads), compressChunk, writeChunk))
+    return false;
+
+  if (fseeko(out.get(), sizeof(magic_) + sizeof(count), SEEK_SET) != 0 or
+      (count and fwrite(chunks.data(), sizeof(Chunk), count, out.get()) != count))
+    {
+      std::cerr << "Error: SnapshotChunks::save failed - write into " << path << '\n';
+      return false;
+    }
+
+  return true;
+}
+
+
+bool
+SnapshotChunks::isChunkedFile(const std::string& path)
+{
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  char magic[sizeof(magic_)] = {};
+  bool ok = preadAll(fd, magic, sizeof(magic), 0) and memcmp(magic, magic_, sizeof(magic)) == 0;
+  close(fd);
+  return ok;
+}
+
+
+bool
+SnapshotChunks::open(const std::string& path)
+{
+  if (fd_ >= 0)
+    close(fd_);
+  chunks_.clear();
+  cachedIx_ = -1;
+  path_ = path;
+
+  fd_ = ::open(path.c_str(), O_RDONLY);
+  if (fd_ < 0)
+    {
+      std::cerr << "Error: SnapshotChunks::open failed - cannot open " << path << " for read\n";
+      return false;
+    }
+
+  struct stat st{};
+  if (fstat(fd_, &st) != 0)
+    return false;
+  auto fileSize = uint64_t(st.st_size);
+
+  char magic[sizeof(magic_)] = {};
+  uint64_t count = 0;
+  if (not preadAll(fd_, magic, sizeof(magic), 0) or memcmp(magic, magic_, sizeof(magic)) != 0 or
+      not preadAll(fd_, &count, sizeof(count), sizeof(magic)) or
+      count > fileSize / sizeof(Chunk))
+    {
+      std::cerr << "Error: SnapshotChunks::open failed - " << path
+                << " is not a chunked snapshot file\n";
+      return false;
+    }
+
+  chunks_.resize(count);
+  if (count and not preadAll(fd_, chunks_.data(), count * sizeof(Chunk), sizeof(magic) + sizeof(count)))
+    {
+      std::cerr << "Error: SnapshotChunks::open failed - cannot read index of " << path << '\n';
+      return false;
+    }
+
+  for (size_t i = 0; i < chunks_.size(); ++i)
+    {
+      const auto& chunk = chunks_.at(i);
+      bool sorted = i == 0 or chunks_.at(i - 1).addr + chunks_.at(i - 1).size <= chunk.addr;
+      if (not sorted or chunk.size > chunkSize_ or chunk.offset > fileSize or
+          chunk.compSize > fileSize - chunk.offset)
+        {
+          std::cerr << "Error: SnapshotChunks::open failed - corrupt index in " << path << '\n';
+          return false;
+        }
+    }
+
+  return true;
+}
+
+
+ptrdiff_t
+SnapshotChunks::findChunk(uint64_t addr) const
+{
+  auto it = std::upper_bound(chunks_.begin(), chunks_.end(), addr,
+                             [] (uint64_t a, const Chunk& c) { return a < c.addr; });
+  if (it == chunks_.begin())
+    return -1;
+  --it;
+  if (addr - it->addr >= it->size)
+    return -1;
+  return it - chunks_.begin();
+}
+
+
+bool
+SnapshotChunks::readChunk(size_t ix, std::vector<uint8_t>& data) const
+{
+  const auto& chunk = chunks_.at(ix);
+  std::vector<uint8_t> comp(chunk.compSize);
+  if (not preadAll(fd_, comp.data(), comp.size(), chunk.offset))
+    {
+      std::cerr << "Error: SnapshotChunks::readChunk failed - cannot read " << path_ << '\n';
+      return false;
+    }
+
+  data.resize(chunk.size);
+  uLongf len = chunk.size;
+  if (uncompress(data.data(), &len, comp.data(), comp.size()) != Z_OK or len != chunk.size)
+    {
+      std::cerr << "Error: SnapshotChunks::readChunk failed - corrupt chunk at 0x"
+                << std::hex << chunk.addr << std::dec << " in " << path_ << '\n';
+      return false;
+    }
+  return true;
+}
+
+
+bool
+SnapshotChunks::copyRange(uint64_t addr, std::span<uint8_t> data)
+{
+  uint64_t end = addr + data.size();
+
+  // First chunk ending after addr: chunks are sorted and disjoint.
+  auto it = std::upper_bound(chunks_.begin(), chunks_.end(), addr,
+                             [] (uint64_t a, const Chunk& c) { return a < c.addr + c.size; });
+
+  for ( ; it != chunks_.end() and it->addr < end; ++it)
+    {
+      ptrdiff_t ix = it - chunks_.begin();
+      if (ix != cachedIx_)
+        {
+          cachedIx_ = -1;
+          if (not readChunk(ix, cache_))
+            return false;
+          cachedIx_ = ix;
+        }
+
+      uint64_t lo = std::max(addr, it->addr);
+      uint64_t hi = std::min(end, it->addr + it->size);
+      memcpy(&data[lo - addr], &cache_.at(lo - it->addr), hi - lo);
+    }
+
+  return true;
+}
+
+
+bool
+SnapshotChunks::restore(const WriteFunc& writeFunc, unsigned threads) const
+{
+  // Decompress chunks on worker threads and write them in address order
+  // from this thread as they complete.
+  auto decompress = [this] (size_t i, std::vector<uint8_t>& data) {
+    return readChunk(i, data);
+  };
+  auto write = [this, &writeFunc] (size_t i, const std::vector<uint8_t>& data) {
+    return writeFunc(chunks_.at(i).addr, data);
+  };
+  return orderedPipeline(chunks_.size(), threadCount(threads), decompress, write);
+}
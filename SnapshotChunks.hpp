@@ -0,0 +1,123 @@
+// Copyright 2025 Tenstorrent Corporation or its affiliates.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace WdRiscv
+{
+
+  /// Chunked snapshot memory container. The used memory blocks are cut
+  /// into chunks of at most chunkSize_ bytes, each compressed (zlib)
+  /// independently so that chunks can be compressed and decompressed
+  /// in parallel and any chunk can be read on its own. File layout:
+  ///
+  ///   magic (8 bytes), chunk count (8 bytes),
+  ///   index: per chunk address, size, file offset, compressed size (8 bytes each),
+  ///   compressed chunk data.
+  ///
+  /// Integers are in host byte order. The index is sorted by address.
+  class SnapshotChunks
+  {
+  public:
+
+    /// Index entry of a chunk.
+    struct Chunk
+    {
+      uint64_t addr = 0;       // Memory address of first byte.
+      uint64_t size = 0;       // Uncompressed size in bytes.
+      uint64_t offset = 0;     // Offset of compressed data in file.
+      uint64_t compSize = 0;   // Compressed size in bytes.
+    };
+
+    /// Callback reading the memory bytes at the given address into the
+    /// given buffer (filling its whole size).
+    using ReadFunc = std::function<void(uint64_t addr, std::span<uint8_t> data)>;
+
+    /// Callback writing the given bytes to memory at the given address.
+    using WriteFunc = std::function<bool(uint64_t addr, std::span<const uint8_t> data)>;
+
+    SnapshotChunks() = default;
+
+    ~SnapshotChunks();
+
+    SnapshotChunks(const SnapshotChunks&) = delete;
+    SnapshotChunks& operator=(const SnapshotChunks&) = delete;
+
+    /// Save the given memory blocks (address/size pairs in ascending
+    /// address order) to the given file using the given number of
+    /// threads (0 for the host thread count). Read memory using
+    /// readFunc which is called concurrently from several threads.
+    /// Return true on success.
+    static bool save(const std::string& path,
+                     const std::vector<std::pair<uint64_t, uint64_t>>& blocks,
+                     const ReadFunc& readFunc, unsigned threads = 0);
+
+    /// Open the given file and read its index. Return true on success.
+    bool open(const std::string& path);
+
+    /// Restore all the chunks of the opened file using the given number
+    /// of threads (0 for the host thread count). Chunks are decompressed
+    /// concurrently and written, in address order, from the calling
+    /// thread using writeFunc. Return true on success.
+    bool restore(const WriteFunc& writeFunc, unsigned threads = 0) const;
+
+    /// Decompress the chunk with the given index into the given buffer.
+    /// Thread safe. Return true on success.
+    bool readChunk(size_t ix, std::vector<uint8_t>& data) const;
+
+    /// Copy the bytes of the opened file overlapping the given address
+    /// range into the corresponding bytes of data leaving the other bytes
+    /// unchanged. The last decompressed chunk is cached: not thread
+    /// safe. Return true on success.
+    bool copyRange(uint64_t addr, std::span<uint8_t> data);
+
+    /// Return the index of the chunk containing the given address or -1
+    /// if no such chunk.
+    ptrdiff_t findChunk(uint64_t addr) const;
+
+    /// Return the chunk index of the opened file.
+    const std::vector<Chunk>& chunks() const
+    { return chunks_; }
+
+    /// Return true if the given file is a chunked snapshot container.
+    static bool isChunkedFile(const std::string& path);
+
+    /// Return the number of threads to use for the given request (0 for
+    /// the host thread count).
+    static unsigned threadCount(unsigned requested);
+
+    static constexpr uint64_t chunkSize_ = uint64_t(256) * 1024;
+
+  private:
+
+    static constexpr char magic_[8] = { 'W', 'H', 'S', 'N', 'A', 'P', 'C', '1' };
+
+    int fd_ = -1;
+    std::string path_;
+    std::vector<Chunk> chunks_;
+
+    ptrdiff_t cachedIx_ = -1;          // Index of chunk in cache_.
+    std::vector<uint8_t> cache_;       // Last chunk decompressed by copyRange.
+  };
+
+}
@@ -17,6 +17,9 @@
 #include <cstdio>
 #include <algorithm>
 #include <cassert>
+#include <new>
+#include <sstream>
+#include <stdexcept>
 #include "SparseMem.hpp"
 #include "util.hpp"
 
@@ -27,6 +30,109 @@ using namespace WdRiscv;
 SparseMem::~SparseMem() = default;
 
 
+uint8_t*
+SparseMem::allocatePage()
+{
+  if (slabUsed_ == slabPages_)
+    {
+      // Large zeroed allocations are lazily committed by the host.
+      // NOLINTNEXTLINE(cppcoreguidelines-no-malloc)
+      auto* slab = static_cast<uint8_t*>(calloc(slabPages_, pageSize_));
+      if (not slab)
+        throw std::bad_alloc();
+      slabs_.emplace_back(slab);
+      slabUsed_ = 0;
+    }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  return slabs_.back().get() + pageSize_ * slabUsed_++;
+}
+
+
+uint8_t*
+SparseMem::createPage(uint64_t pageNum)
+{
+  std::lock_guard<std::mutex> lock(allocLock_);
+
+  // Another thread may have created part of the path since the lookup:
+  // redo it under the lock.
+  Node* node = &root_;
+  for (unsigned level = levels_ - 1; level > 0; --level)
+    {
+      auto& slot = node->slots[slotIndex(pageNum, level)];
+      void* next = slot.load(std::memory_order_acquire);
+      if (not next)
+        {
+          nodes_.push_back(std::make_unique<Node>());
+          next = nodes_.back().get();
+          slot.store(next, std::memory_order_release);
+        }
+      node = static_cast<Node*>(next);
+    }
+
+  auto& slot = node->slots[slotIndex(pageNum, 0)];
+  void* page = slot.load(std::memory_order_acquire);
+  if (not page)
+    {
+      auto* data = allocatePage();
+      if (pageFill_ and not pageFill_(pageNum * pageSize_, std::span<uint8_t>(data, pageSize_)))
+        throwFillError(pageNum * pageSize_);
+      page = data;
+      slot.store(page, std::memory_order_release);
+    }
+  return static_cast<uint8_t*>(page);
+}
+
+
+void
+SparseMem::throwFillError(uint64_t addr)
+{
+  std::ostringstream oss;
+  oss << "Failed to initialize memory page at 0x" << std::hex << addr;
+  throw std::runtime_error(oss.str());
+}
+
+
+void
+SparseMem::setPageFill(PageFill fill)
+{
+  std::vector<std::pair<uint64_t, uint64_t>> blocks;
+  getUsedBlocks(blocks);
+
+  std::lock_guard<std::mutex> lock(allocLock_);
+  pageFill_ = std::move(fill);
+  if (not pageFill_)
+    return;
+
+  for (const auto& [addr, size] : blocks)
+    for (uint64_t offset = 0; offset < size; offset += pageSize_)
+      {
+        uint64_t pageAddr = addr + offset;
+        uint8_t* page = hostAddress(pageAddr);  // Existing page: no creation.
+        if (not pageFill_(pageAddr, std::span<uint8_t>(page, pageSize_)))
+          throwFillError(pageAddr);
+      }
+}
+
+
+template <typename F>
+void
+SparseMem::forEachPage(const Node& node, unsigned level, uint64_t prefix, F& func) const
+{
+  for (size_t i = 0; i < nodeSize_; ++i)
+    {
+      void* next = node.slots[i].load(std::memory_order_acquire);
+      if (not next)
+        continue;
+      uint64_t pageNum = (prefix << levelBits_) | i;
+      if (level == 0)
+        func(pageNum, static_cast<const uint8_t*>(next));
+      else
+        forEachPage(*static_cast<const Node*>(next), level - 1, pageNum, func);
+    }
+}
+
+
 bool
 SparseMem::read(uint64_t addr, unsigned size, uint64_t& value)
 {
@@ -137,33 +243,36 @@ SparseMem::writeHexFile(const std::string& path) const
 
   bool ok = true;
 
-  for (const auto& kv : pageMap_)
-    {
-      uint64_t addr = kv.first * pageSize_;             // Page address
-      const std::vector<uint8_t>& data = kv.second;     // Page data
-      unsigned offset = 0;
-      if (fprintf(out.get(), "@%0" PRIx64 "\n", addr) < 0)
-        {
+  auto writePage = [this, &out, &ok] (uint64_t pageNum, const uint8_t* data) {
+    if (not ok)
+      return;
+    uint64_t addr = pageNum * pageSize_;             // Page address
+    if (fprintf(out.get(), "@%0" PRIx64 "\n", addr) < 0)
+      {
+        ok = false;
+        return;
+      }
+
+    std::span<const uint8_t> page(data, pageSize_);
+    size_t offset = 0;
+    size_t remain = pageSize_;
+    while (remain and ok)
+      {
+        size_t chunk = std::min(remain, size_t(16));
+        const char* sep = "";
+        for (size_t i = 0; i < chunk; ++i, ++offset)
+          {
+            if (fprintf(out.get(), "%s%02x", sep, page[offset]) < 0)
+              ok = false;
+            sep = " ";
+          }
+        if (fprintf(out.get(), "\n") < 0)
           ok = false;
-          break;
-        }
+        remain -= chunk;
+      }
+  };
 
-      size_t remain = pageSize_;
-      while (remain and ok)
-        {
-          size_t chunk = std::min(remain, size_t(16));
-          const char* sep = "";
-          for (size_t i = 0; i < chunk; ++i, ++offset)
-            {
-              if (fprintf(out.get(), "%s%02x", sep, data.at(offset)) < 0)
-                ok = false;
-              sep = " ";
-            }
-          if (fprintf(out.get(), "\n") < 0)
-            ok = false;
-          remain -= chunk;
-        }
-    }
+  forEachPage(root_, levels_ - 1, 0, writePage);
 
   return ok;
 }
@@ -173,34 +282,17 @@ void
 SparseMem::getUsedBlocks(std::vector<std::pair<uint64_t, uint64_t>>& vec) const
 {
   vec.clear();
-  vec.reserve(pageMap_.size());
 
-  using Pair = std::pair<uint64_t, uint64_t>;
-
-  for (const auto& kv : pageMap_)
-    vec.emplace_back(kv.first*pageSize_, pageSize_);
-
-  std::sort(vec.begin(), vec.end(), [] (const Pair& a, const Pair& b) {
-    return a.first < b.first;
-  });
-
-  // Merge adjacent pages into blocks.
-  size_t blockIx = 0;  // Index of block being expanded
-  for (size_t i = 1; i < vec.size(); ++i)
-    {
-      auto& block = vec.at(blockIx);
-      if (block.first + block.second == vec.at(i).first)
-	{
-	  block.second += vec.at(i).second;
-	  vec.at(i).second = 0;  // Mark for deletion.
-	}
-      else
-	blockIx = i;
-    }
+  // Pages are visited in ascending order: merge adjacent pages into blocks.
+  auto addPage = [this, &vec] (uint64_t pageNum, const uint8_t*) {
+    uint64_t addr = pageNum * pageSize_;
+    if (not vec.empty() and vec.back().first + vec.back().second == addr)
+      vec.back().second += pageSize_;
+    else
+      vec.emplace_back(addr, pageSize_);
+  };
 
-  // Delete merged pages.
-  auto newEnd = std::remove_if(vec.begin(), vec.end(), [](const Pair& x) { return x.second == 0; });
-  vec.resize(newEnd - vec.begin());
+  forEachPage(root_, levels_ - 1, 0, addPage);
 }
 
 
@@ -212,7 +304,7 @@ SparseMem::initializePage(uint64_t addr, const std::span<uint8_t> buffer)
 
   assert(buffer.size() >= pageSize_);
 
-  std::vector<uint8_t>& page = findOrCreatePage(getPageRank(addr));
-  memcpy(page.data(), buffer.data(), pageSize_);
+  uint8_t* page = findOrCreatePage(getPageRank(addr));
+  memcpy(page, buffer.data(), pageSize_);
   return true;
 }
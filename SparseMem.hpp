@@ -14,15 +14,17 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <cassert>
+#include <functional>
 #include <memory>
 #include <vector>
 #include <span>
-#include <unordered_map>
 #include <mutex>
-#include "Lock.hpp"
 
 
 namespace WdRiscv
@@ -34,7 +36,7 @@ namespace WdRiscv
   {
   public:
 
-    SparseMem() : pageMapCache_(cacheSize_) {}
+    SparseMem() = default;
 
     ~SparseMem();
 
@@ -62,6 +64,31 @@ namespace WdRiscv
     /// size must be greater than or equal to the page size.
     bool initializePage(uint64_t addr, std::span<uint8_t> buffer);
 
+    /// Callback writing the initial contents of the page at the given
+    /// address over the current contents of that page (all zeros for a
+    /// page being created). Return false if the contents cannot be
+    /// produced.
+    using PageFill = std::function<bool(uint64_t addr, std::span<uint8_t> page)>;
+
+    /// Define a callback initializing each page on its first access:
+    /// used to restore memory lazily. The callback is applied at once to
+    /// the pages already allocated. Calls are serialized (made with the
+    /// allocation lock held) and the page is only visible to other
+    /// threads once the callback returns. A failing callback throws
+    /// std::runtime_error: the page would otherwise be silently wrong.
+    void setPageFill(PageFill fill);
+
+    /// Return the host-machine address of the byte at the given
+    /// target-machine address creating (and zeroing) its page if it was
+    /// never accessed. The returned address is valid for accesses within
+    /// the same page for the lifetime of this object.
+    uint8_t* hostAddress(uint64_t addr)
+    {
+      uint8_t* page = findOrCreatePage(getPageRank(addr));
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      return page + (addr & pageMask_);
+    }
+
   protected:
 
     /// Read from given target-machine address an item of type U
@@ -72,10 +99,11 @@ namespace WdRiscv
     read(uint64_t addr, uint64_t& value)
     {
       uint64_t pageRank = getPageRank(addr);
-      std::vector<uint8_t>& page = findOrCreatePage(pageRank);
+      uint8_t* page = findOrCreatePage(pageRank);
       unsigned offset = addr & pageMask_;
+      // Host atomic of the item width: harts may run in separate threads.
       // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic, cppcoreguidelines-pro-type-reinterpret-cast)
-      value = *( reinterpret_cast<U*>(page.data() + offset) );
+      value = std::atomic_ref<U>(*reinterpret_cast<U*>(page + offset)).load(std::memory_order_relaxed);
       return true;
     }
 
@@ -88,10 +116,10 @@ namespace WdRiscv
     write(uint64_t addr, uint64_t value)
     {
       uint64_t pageRank = getPageRank(addr);
-      std::vector<uint8_t>& page = findOrCreatePage(pageRank);
+      uint8_t* page = findOrCreatePage(pageRank);
       unsigned offset = addr & pageMask_;
       // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic, cppcoreguidelines-pro-type-reinterpret-cast)
-      *( reinterpret_cast<U*>(page.data() + offset) ) = value;
+      std::atomic_ref<U>(*reinterpret_cast<U*>(page + offset)).store(U(value), std::memory_order_relaxed);
       return true;
     }
 
@@ -102,84 +130,80 @@ namespace WdRiscv
 
     /// Return host-machine address of the target-machine page with
     /// the given page number creating such a page (and zeroing it) if
-    /// it has never been accessed before.
-    inline std::vector<uint8_t>& findOrCreatePage(uint64_t pageNum)
+    /// it has never been accessed before. Lookup of an existing page is
+    /// wait-free: it only loads the directory entries on its path.
+    inline uint8_t* findOrCreatePage(uint64_t pageNum)
     {
-      PageMapCache::entry_t& entry = pageMapCache_.get_entry(pageNum);
-
-      std::vector<uint8_t>* p = entry.compare(pageNum);
-      if (p != nullptr) {
-        return *p;
-      }
-
-      mapSpinLock_.lock();
-      auto end = pageMap_.end();
-      auto iter = pageMap_.find(pageNum);
-      if (iter != end) {
-        p = &iter->second;
-      } else {
-        p = &createPage(pageNum);;
-      }
-      mapSpinLock_.unlock();
-
-      entry.update(pageNum, *p);
-
-      return *p;
+      const Node* node = &root_;
+      for (unsigned level = levels_ - 1; level > 0; --level)
+        {
+          void* next = node->slots[slotIndex(pageNum, level)].load(std::memory_order_acquire);
+          if (not next)
+            return createPage(pageNum);
+          node = static_cast<const Node*>(next);
+        }
+
+      void* page = node->slots[slotIndex(pageNum, 0)].load(std::memory_order_acquire);
+      if (not page)
+        return createPage(pageNum);
+      return static_cast<uint8_t*>(page);
     }
 
   private:
 
-    class PageMapCache {
-        public:
-          struct entry_t {
-              SpinLock lock;
-              uint64_t pageNum = 0;
-              std::vector<uint8_t>* page = nullptr;
-
-              inline std::vector<uint8_t>* compare(uint64_t pageNum) {
-                  std::vector<uint8_t>* p = nullptr;
-                  std::lock_guard<SpinLock> lock(this->lock);
-                  if (page and pageNum == this->pageNum) {
-                      p = page;
-                  }
-                  return p;
-              }
-              inline void update(uint64_t pageNum, std::vector<uint8_t>& page) {
-                  std::lock_guard<SpinLock> lock(this->lock);
-                  this->pageNum = pageNum;
-                  this->page = &page;
-              }
-          };
-
-          PageMapCache(uint64_t n) : mask_(n - 1) {
-              assert((n & (n - 1)) == 0 && "Cache size must be a power of 2");
-              cache_.resize(n);
-          }
-
-          inline struct entry_t& get_entry(uint64_t pageNum) {
-              return cache_[pageNum & mask_];   // Index is masked: always in range.
-          }
-
-        private:
-
-          uint64_t mask_;
-          std::vector<entry_t> cache_;
+    // Page directory: a radix tree indexed by page number. Each level
+    // consumes levelBits_ bits of the page number. Entries of the last
+    // level point to pages, entries of the other levels to nodes of the
+    // next level. Entries are published with release stores once the
+    // node/page they point to is zeroed, and are never changed again.
+    static constexpr unsigned levelBits_ = 13;
+    static constexpr unsigned levels_ = 4;     // 4*13 bits cover a 52-bit page number.
+    static constexpr size_t nodeSize_ = size_t(1) << levelBits_;
+
+    struct Node
+    {
+      std::array<std::atomic<void*>, nodeSize_> slots{};
     };
 
-    std::vector<uint8_t>& createPage(uint64_t pageNum)
+    /// Return the index within a node at the given level (0 is the last
+    /// level) of the entry on the path to the given page.
+    static size_t slotIndex(uint64_t pageNum, unsigned level)
+    { return (pageNum >> (level * levelBits_)) & (nodeSize_ - 1); }
+
+    /// Slow path of findOrCreatePage: create the missing nodes and page
+    /// under the allocation lock.
+    uint8_t* createPage(uint64_t pageNum);
+
+    /// Carve a zeroed page from the current slab, allocating a new slab
+    /// if needed. Must be called with allocLock_ held.
+    uint8_t* allocatePage();
+
+    /// Throw the error of a failed page fill (see setPageFill) of the
+    /// page at the given address.
+    [[noreturn]] static void throwFillError(uint64_t addr);
+
+    /// Call func(pageNum, pageData) for each allocated page in ascending
+    /// page number order.
+    template <typename F>
+    void forEachPage(const Node& node, unsigned level, uint64_t prefix, F& func) const;
+
+    struct FreeDeleter
     {
-	  auto iter = pageMap_.try_emplace(pageNum, pageSize_, 0).first;
-      auto& page = iter->second;
-      return page;
-    }
+      void operator()(uint8_t* p) const
+      { free(p); }  // NOLINT(cppcoreguidelines-no-malloc)
+    };
+
+    static constexpr size_t slabPages_ = 256;  // Pages per slab (1 MB).
 
     size_t pageSize_ = UINT64_C(4)*1024;
     unsigned pageShift_ = 12;
     unsigned pageMask_ = 0xfff;
-    size_t cacheSize_ = 16384;
 
-    std::unordered_map<uint64_t, std::vector<uint8_t>> pageMap_;  // Map address to page
-    SpinLock mapSpinLock_;
-    PageMapCache pageMapCache_;
+    Node root_;
+    std::mutex allocLock_;                                   // Serialize creation.
+    PageFill pageFill_;                                      // Initial page contents.
+    std::vector<std::unique_ptr<Node>> nodes_;               // Non-root nodes.
+    std::vector<std::unique_ptr<uint8_t, FreeDeleter>> slabs_;
+    size_t slabUsed_ = slabPages_;                           // Pages used in last slab.
   };
 }
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <fstream>
@@ -63,14 +64,23 @@ static bool
 copyRvString(Hart<URV>& hart, uint64_t rvAddr,
              T& dest)
 {
-  for (size_t i = 0; i < std::size(dest); ++i)
+  // Copy a page at a time stopping at the page holding the terminating null.
+  constexpr size_t pageSize = 4096;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  std::span<uint8_t> bytes(reinterpret_cast<uint8_t*>(std::data(dest)), std::size(dest));
+
+  size_t offset = 0;
+  while (offset < bytes.size())
     {
-      uint8_t byte = 0;
-      if (not hart.peekMemory(rvAddr + i, byte, true))
-        return false;
-      dest.at(i) = byte;
-      if (byte == 0)
+      uint64_t addr = rvAddr + offset;
+      size_t size = std::min(bytes.size() - offset, pageSize - (addr & (pageSize - 1)));
+      auto chunk = bytes.subspan(offset, size);
+      uint64_t copied = hart.copyFromGuest(addr, chunk, true);
+      if (std::find(chunk.begin(), chunk.begin() + copied, 0) != chunk.begin() + copied)
         return true;
+      if (copied != size)
+        return false;
+      offset += size;
     }
   return false;
 }
@@ -87,14 +97,13 @@ static uint64_t
 readHartMemory(Hart<URV>& hart, uint64_t readAddr, T&& dest, std::optional<std::size_t> size = std::nullopt)
 {
   std::span<std::byte> destBytes = std::as_writable_bytes(std::span(std::forward<T>(dest)));
+  uint64_t count = size.value_or(destBytes.size());
 
-  for (uint64_t i = 0; i < size.value_or(destBytes.size()); ++i)
-    {
-      uint8_t byte = 0;
-      if (not hart.peekMemory(readAddr + i, byte, true))
-        return i;
-      destBytes[i] = static_cast<std::byte>(byte);
-    }
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  std::span<uint8_t> bytes(reinterpret_cast<uint8_t*>(destBytes.data()), count);
+  uint64_t copied = hart.copyFromGuest(readAddr, bytes, true);
+  if (copied != count)
+    return copied;
 
   return size.value_or(dest.size());
 }
@@ -114,14 +123,11 @@ static uint64_t
 writeHartMemory(Hart<URV>& hart, T&& data, uint64_t writeAddr, std::optional<std::size_t> size = std::nullopt)
 {
   std::span<const std::byte> dataBytes = std::as_bytes(std::span(std::forward<T>(data)));
+  uint64_t count = size.value_or(dataBytes.size());
 
-  for (uint64_t i = 0; i < size.value_or(dataBytes.size()); ++i)
-    {
-      auto byte = static_cast<uint8_t>(dataBytes[i]);
-      if (not hart.pokeMemory(writeAddr + i, byte, true))
-        return i;
-    }
-  return size.value_or(dataBytes.size());
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  std::span<const uint8_t> bytes(reinterpret_cast<const uint8_t*>(dataBytes.data()), count);
+  return hart.copyToGuest(writeAddr, bytes, true);
 }
 
 template <typename URV, typename T>
@@ -132,113 +138,79 @@ writeHartMemory(Hart<URV>& hart, const T& data, uint64_t writeAddr)
 }
 
 
-// Copy x86 stat buffer to riscv kernel_stat buffer.
-template <typename URV>
-static size_t
-copyStatBufferToRiscv(Hart<URV>& hart, const struct stat& buff,
-                      uint64_t rvBuff, bool& writeOk)
+/// Little-endian image of a target structure built field by field and
+/// written to target memory with a single bulk copy.
+class GuestStruct
 {
-  writeOk = false;
-  uint64_t addr = rvBuff;
-
-  if (not hart.pokeMemory(addr, uint64_t(buff.st_dev), true))
-    return addr - rvBuff;
-  addr += 8;
+public:
 
-  if (not hart.pokeMemory(addr, uint64_t(buff.st_ino), true))
-    return addr - rvBuff;
-  addr += 8;
+  /// Append the given field.
+  template <typename T>
+  void put(T value)
+  {
+    for (unsigned i = 0; i < sizeof(T); ++i)
+      bytes_.push_back(uint8_t(uint64_t(value) >> (i*8)));
+  }
 
-  if (not hart.pokeMemory(addr, uint32_t(buff.st_mode), true))
-    return addr - rvBuff;
-  addr += 4;
+  /// Append the given number of zero (padding) bytes.
+  void pad(size_t count)
+  { bytes_.insert(bytes_.end(), count, 0); }
 
-  if (not hart.pokeMemory(addr, uint32_t(buff.st_nlink), true))
-    return addr - rvBuff;
-  addr += 4;
+  /// Write the structure to target memory at the given address. Return
+  /// the number of bytes written.
+  template <typename URV>
+  size_t write(Hart<URV>& hart, uint64_t addr) const
+  { return hart.copyToGuest(addr, bytes_, true); }
 
-  if (not hart.pokeMemory(addr, uint32_t(buff.st_uid), true))
-    return addr - rvBuff;
-  addr += 4;
+  size_t size() const
+  { return bytes_.size(); }
 
-  if (not hart.pokeMemory(addr, uint32_t(buff.st_gid), true))
-    return addr - rvBuff;
-  addr += 4;
+private:
 
-  if (not hart.pokeMemory(addr, uint64_t(buff.st_rdev), true))
-    return addr - rvBuff;
-  addr += 8;
+  std::vector<uint8_t> bytes_;
+};
 
-  addr += 8; // __pad1
 
-  if (not hart.pokeMemory(addr, uint64_t(buff.st_size), true))
-    return addr - rvBuff;
-  addr += 8;
+// Copy x86 stat buffer to riscv kernel_stat buffer.
+template <typename URV>
+static size_t
+copyStatBufferToRiscv(Hart<URV>& hart, const struct stat& buff,
+                      uint64_t rvBuff, bool& writeOk)
+{
+  GuestStruct rv;
+  rv.put(uint64_t(buff.st_dev));
+  rv.put(uint64_t(buff.st_ino));
+  rv.put(uint32_t(buff.st_mode));
+  rv.put(uint32_t(buff.st_nlink));
+  rv.put(uint32_t(buff.st_uid));
+  rv.put(uint32_t(buff.st_gid));
+  rv.put(uint64_t(buff.st_rdev));
+  rv.pad(8);  // __pad1
+  rv.put(uint64_t(buff.st_size));
 
 #ifdef __APPLE__
   // macOS uses st_atimespec/st_mtimespec/st_ctimespec instead of st_atim/st_mtim/st_ctim.
-  if (not hart.pokeMemory(addr, uint64_t(buff.st_atimespec.tv_sec), true))
-    return addr - rvBuff;
-  addr += 8;
-
-  if (not hart.pokeMemory(addr, uint64_t(buff.st_atimespec.tv_nsec), true))
-    return addr - rvBuff;
-  addr += 8;
-
-  if (not hart.pokeMemory(addr, uint64_t(buff.st_mtimespec.tv_sec), true))
-    return addr - rvBuff;
-  addr += 8;
-
-  if (not hart.pokeMemory(addr, uint64_t(buff.st_mtimespec.tv_nsec), true))
-    return addr - rvBuff;
-  addr += 8;
-
-  if (not hart.pokeMemory(addr, uint64_t(buff.st_ctimespec.tv_sec), true))
-    return addr - rvBuff;
-  addr += 8;
-
-  if (not hart.pokeMemory(addr, uint64_t(buff.st_ctimespec.tv_nsec), true))
-    return addr - rvBuff;
-  addr += 8;
+  rv.put(uint64_t(buff.st_atimespec.tv_sec));
+  rv.put(uint64_t(buff.st_atimespec.tv_nsec));
+  rv.put(uint64_t(buff.st_mtimespec.tv_sec));
+  rv.put(uint64_t(buff.st_mtimespec.tv_nsec));
+  rv.put(uint64_t(buff.st_ctimespec.tv_sec));
+  rv.put(uint64_t(buff.st_ctimespec.tv_nsec));
 #else
-  if (not hart.pokeMemory(addr, uint32_t(buff.st_blksize), true))
-    return addr - rvBuff;
-  addr += 4;
-
-  addr += 4; // __pad2
-
-  if (not hart.pokeMemory(addr, uint64_t(buff.st_blocks), true))
-    return addr - rvBuff;
-  addr += 8;
-
-  if (not hart.pokeMemory(addr, uint64_t(buff.st_atim.tv_sec), true))
-    return addr - rvBuff;
-  addr += 8;
-
-  if (not hart.pokeMemory(addr, uint64_t(buff.st_atim.tv_nsec), true))
-    return addr - rvBuff;
-  addr += 8;
-
-  if (not hart.pokeMemory(addr, uint64_t(buff.st_mtim.tv_sec), true))
-    return addr - rvBuff;
-  addr += 8;
-
-  if (not hart.pokeMemory(addr, uint64_t(buff.st_mtim.tv_nsec), true))
-    return addr - rvBuff;
-  addr += 8;
-
-  if (not hart.pokeMemory(addr, uint64_t(buff.st_ctim.tv_sec), true))
-    return addr - rvBuff;
-  addr += 8;
-
-  if (not hart.pokeMemory(addr, uint64_t(buff.st_ctim.tv_nsec), true))
-    return addr - rvBuff;
-  addr += 8;
-
+  rv.put(uint32_t(buff.st_blksize));
+  rv.pad(4);  // __pad2
+  rv.put(uint64_t(buff.st_blocks));
+  rv.put(uint64_t(buff.st_atim.tv_sec));
+  rv.put(uint64_t(buff.st_atim.tv_nsec));
+  rv.put(uint64_t(buff.st_mtim.tv_sec));
+  rv.put(uint64_t(buff.st_mtim.tv_nsec));
+  rv.put(uint64_t(buff.st_ctim.tv_sec));
+  rv.put(uint64_t(buff.st_ctim.tv_nsec));
 #endif
 
-  writeOk = true;
-  return addr - rvBuff;
+  size_t written = rv.write(hart, rvBuff);
+  writeOk = written == rv.size();
+  return written;
 }
 
 
@@ -247,24 +219,12 @@ template <typename URV>
 static size_t
 copyTmsToRiscv(Hart<URV>& hart, const struct tms& buff, URV addr)
 {
-  URV addr0 = addr;
-  if (not hart.pokeMemory(addr, URV(buff.tms_utime), true))
-    return addr - addr0;
-  addr += sizeof(URV);
-
-  if (not hart.pokeMemory(addr, URV(buff.tms_stime), true))
-    return addr - addr0;
-  addr += sizeof(URV);
-
-  if (not hart.pokeMemory(addr, URV(buff.tms_cutime), true))
-    return addr - addr0;
-  addr += sizeof(URV);
-
-  if (not hart.pokeMemory(addr, URV(buff.tms_cstime), true))
-    return addr -addr0;
-  addr += sizeof(URV);
-
-  return addr -addr0;
+  GuestStruct rv;
+  rv.put(URV(buff.tms_utime));
+  rv.put(URV(buff.tms_stime));
+  rv.put(URV(buff.tms_cutime));
+  rv.put(URV(buff.tms_cstime));
+  return rv.write(hart, addr);
 }
 
 
@@ -273,36 +233,22 @@ template <typename URV>
 static size_t
 copyTimevalToRiscv32(Hart<URV>& hart, const struct timeval& tv, URV addr)
 {
-  size_t written = 0;
-  if (not hart.pokeMemory(addr, uint32_t(tv.tv_sec), true))
-    return written;
-  written += sizeof(uint32_t);
-  addr += sizeof(uint32_t);
-
-  if (not hart.pokeMemory(addr, uint64_t(tv.tv_usec), true))
-    return written;
-  written += sizeof(uint64_t);
-
-  return written;
+  GuestStruct rv;
+  rv.put(uint32_t(tv.tv_sec));
+  rv.put(uint64_t(tv.tv_usec));
+  return rv.write(hart, addr);
 }
 
 
-// Copy x86 timeval buffer to riscv timeval buffer (32-bit version).
+// Copy x86 timeval buffer to riscv timeval buffer (64-bit version).
 template <typename URV>
 static size_t
 copyTimevalToRiscv64(Hart<URV>& hart, const struct timeval& tv, URV addr)
 {
-  size_t written = 0;
-  if (not hart.pokeMemory(addr, uint64_t(tv.tv_sec), true))
-    return written;
-  written += sizeof(uint64_t);
-  addr += sizeof(uint64_t);
-
-  if (not hart.pokeMemory(addr, uint64_t(tv.tv_usec), true))
-    return written;
-  written += sizeof(uint64_t);
-
-  return written;
+  GuestStruct rv;
+  rv.put(uint64_t(tv.tv_sec));
+  rv.put(uint64_t(tv.tv_usec));
+  return rv.write(hart, addr);
 }
 
 
@@ -311,17 +257,10 @@ template<typename URV>
 static size_t
 copyTimezoneToRiscv(Hart<URV>& hart, const struct timezone& tz, URV dest)
 {
-  size_t written = 0;
-  if (not hart.pokeMemory(dest, URV(tz.tz_minuteswest), true))
-    return written;
-  written += sizeof(URV);
-  dest += sizeof(URV);
-
-  if (not hart.pokeMemory(dest, URV(tz.tz_dsttime), true))
-    return written;
-  written += sizeof(URV);
-
-  return written;
+  GuestStruct rv;
+  rv.put(URV(tz.tz_minuteswest));
+  rv.put(URV(tz.tz_dsttime));
+  return rv.write(hart, dest);
 }
 
 
@@ -1067,9 +1006,8 @@ Syscall<URV>::emulate(unsigned hartIx, unsigned syscallIx, URV a0, URV a1, URV a
         if (len > size)
           return SRV(-EINVAL);
 
-        for (size_t i = 0; i < len; ++i)
-          if (not hart.pokeMemory(rvBuff+i, uint8_t(buffer.at(i)), true))
-            return SRV(-EINVAL);
+        if (writeHartMemory(hart, buffer, rvBuff, len) != len)
+          return SRV(-EINVAL);
 
         return len;
       }
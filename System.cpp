@@ -22,6 +22,9 @@
 #include <unistd.h>
 #include <set>
 #include <cinttypes>
+#include <algorithm>
+#include <barrier>
+#include <exception>
 #include "Hart.hpp"
 #include "Core.hpp"
 #include "SparseMem.hpp"
@@ -98,6 +101,8 @@ System<URV>::System(unsigned coreCount, unsigned hartsPerCore,
   mem.defineReadMemoryCallback(readf);
   mem.defineWriteMemoryCallback(writef);
   mem.defineInitPageCallback(initf);
+  mem.defineHostAddressCallback([this](uint64_t addr) -> uint8_t* {
+                                  return sparseMem_->hostAddress(addr); });
 #endif
 }
 
@@ -593,11 +598,30 @@ System<URV>::saveSnapshot(const std::string& dir)
   auto& syscall = hart0.getSyscall();
 
   Filesystem::path usedBlocksPath = dirPath / "usedblocks";
+  Filesystem::path parentPath = dirPath / "parent";
   std::vector<std::pair<uint64_t,uint64_t>> usedBlocks;
-  if (sparseMem_)
-    sparseMem_->getUsedBlocks(usedBlocks);
+  bool incremental = incrementalSnap_ and not prevSnapDir_.empty() and
+    Filesystem::is_directory(prevSnapDir_);
+  if (incremental)
+    {
+      // Only the pages written since the previous snapshot. Name it
+      // relative to this one so that the chain can be moved.
+      memory_->getDirtyBlocks(usedBlocks);
+      auto parent = Filesystem::relative(Filesystem::absolute(prevSnapDir_),
+                                         Filesystem::absolute(dirPath));
+      std::ofstream ofs(parentPath);
+      if (not (ofs << parent.string() << '\n'))
+        {
+          std::cerr << "Error: Failed to write snapshot parent file " << parentPath << '\n';
+          return false;
+        }
+    }
   else
-    syscall.getUsedMemBlocks(minSp, usedBlocks);
+    {
+      Filesystem::remove(parentPath);
+      if (not getSparseMemUsedBlocks(usedBlocks))
+        syscall.getUsedMemBlocks(minSp, usedBlocks);
+    }
 
   if (not saveUsedMemBlocks(usedBlocksPath.string(), usedBlocks))
     return false;
@@ -629,12 +653,26 @@ System<URV>::saveSnapshot(const std::string& dir)
           return false;
         }
     }
+  else if (snapCompressionType_ == "chunked")
+    {
+      if (not memory_->saveSnapshot_chunked(memPath.string(), usedBlocks))
+        {
+          std::cerr << "Error in saving snapshot - chunked\n";
+          return false;
+        }
+    }
   else
     {
       std::cerr << "Error: Invalid compression type: " << snapCompressionType_ << "\n";
       return false;
     }
 
+  if (incrementalSnap_)
+    {
+      memory_->clearDirtyPages();
+      prevSnapDir_ = dir;
+    }
+
   Filesystem::path mtimecmpPath = dirPath / "mtimecmp";
   {
     std::ofstream ofs(mtimecmpPath.string());
@@ -1131,8 +1169,18 @@ System<URV>::configPci(uint64_t configBase, uint64_t mmioBase, uint64_t mmioSize
     return this->imsicMgr_.write(addr, size, data);
   };
 
+  auto readBlockf = [this](uint64_t addr, std::span<uint8_t> data) -> bool {
+    return this->memory_->peekBlock(addr, data);
+  };
+
+  auto writeBlockf = [this](uint64_t addr, std::span<const uint8_t> data) -> bool {
+    return this->memory_->pokeBlock(addr, data);
+  };
+
   pci_->define_read_mem(readf);
   pci_->define_write_mem(writef);
+  pci_->define_read_mem_block(readBlockf);
+  pci_->define_write_mem_block(writeBlockf);
   pci_->define_msi(msif);
 
   for (auto& hart : sysHarts_)
@@ -1640,9 +1688,31 @@ System<URV>::getSparseMemUsedBlocks(std::vector<std::pair<uint64_t, uint64_t>>&
   if (sparseMem_)
     {
       sparseMem_->getUsedBlocks(usedBlocks);
+      if (lazySnaps_.empty())
+        return true;
+
+      // Memory of a lazily loaded snapshot is in use even if never
+      // accessed: merge its chunks.
+      for (const auto& snap : lazySnaps_)
+        for (const auto& chunk : snap->chunks())
+          usedBlocks.emplace_back(chunk.addr, chunk.size);
+      std::sort(usedBlocks.begin(), usedBlocks.end());
+
+      size_t count = 0;
+      for (const auto& [addr, size] : usedBlocks)
+        {
+          if (count and usedBlocks.at(count-1).first + usedBlocks.at(count-1).second >= addr)
+            {
+              auto& prev = usedBlocks.at(count-1);
+              prev.second = std::max(prev.second, addr + size - prev.first);
+            }
+          else
+            usedBlocks.at(count++) = {addr, size};
+        }
+      usedBlocks.resize(count);
       return true;
     }
-  return false;
+  return memory_->getTouchedBlocks(usedBlocks);
 }
 
 
@@ -1718,9 +1788,129 @@ System<URV>::batchRun(std::vector<util::file::SharedFile>& traceFiles, bool wait
               cond = ExitCondition(ce.type());
             }
         }
+      else if (quantum_)
+        {
+          // Run each hart in its own thread for quantum_ instructions then wait for
+          // the other harts at a barrier. During a quantum, the stores of a hart are
+          // held in its store buffer: the other harts see memory as it was at the
+          // start of the quantum. At the barrier, the buffers are committed in hart
+          // index order, then the atomic instructions and store-load fences at which
+          // harts stopped early are executed one hart at a time in hart index order,
+          // then the interrupt effects of a hart on the other harts (ACLINT, IMSIC)
+          // queued during the quantum are applied in hart index order. The run does
+          // not depend on the timing of the threads. The LR reservations of other
+          // harts are invalidated at the time of the store: LR and SC execute at
+          // barriers, so whether a store lands between them does not depend on timing.
+          const unsigned count = hartCount();
+          std::vector<char> stopped(count, false);
+          std::vector<char> atSync(count, false);  // Stopped early at atomic/fence.
+          std::vector<char> results(count, true);
+          std::vector<ExitCondition> conds(count);
+          std::vector<std::exception_ptr> errors(count);
+          bool done = false;
+
+          for (const auto& hptr : sysHarts_)
+            stopped.at(hptr->sysHartIndex()) = hptr->hasTargetProgramFinished();
+
+          // Run given hart for up to the given number of instructions. If toSync is
+          // true, stop early at an atomic/fence instruction.
+          auto runHart = [&] (unsigned ix, uint64_t steps, bool toSync) {
+                           auto hart = ithHart(ix);
+                           FILE* traceFile = traceFiles.at(ix).get();
+                           atSync.at(ix) = false;
+                           try
+                             {
+                               bool stop{}, sync{};
+                               bool r = toSync ? hart->runStepsToSync(steps, stop, sync, traceFile)
+                                               : hart->runSteps(steps, stop, traceFile);
+                               results.at(ix) = results.at(ix) and r;
+                               stopped.at(ix) = stop;
+                               atSync.at(ix) = sync;
+                               if (stop)
+                                 conds.at(ix) |= ExitCondition(CoreException::Type::Exit);
+                             }
+                           catch (const CoreException& ce)
+                             {
+                               ExitCondition ec(ce.type());
+                               conds.at(ix) |= ec;
+                               stopped.at(ix) = ec.stop or (ec.roi and earlyRoiTerminate);
+                             }
+                           catch (...)
+                             {
+                               // Keep arriving at the barrier so that the other
+                               // threads are not left waiting: the run ends at
+                               // the next barrier and the exception is rethrown
+                               // once all threads are joined.
+                               errors.at(ix) = std::current_exception();
+                               stopped.at(ix) = true;
+                             }
+                         };
+
+          auto sync = [&] () noexcept {
+                        memory_->commitStoreBuffers();
+                        {
+                          Memory::DirectAccess direct;
+                          for (unsigned ix = 0; ix < count; ++ix)
+                            if (atSync.at(ix) and not stopped.at(ix))
+                              runHart(ix, 1, false);
+                        }
+
+                        for (const auto& hptr : sysHarts_)
+                          hptr->applyCrossHartEffects();
+
+                        unsigned finished = 0;
+                        for (unsigned ix = 0; ix < count; ++ix)
+                          {
+                            cond |= conds.at(ix);
+                            conds.at(ix) = ExitCondition();
+                            finished += stopped.at(ix);
+                          }
+                        bool error = std::ranges::any_of(errors, [] (const auto& e) { return e != nullptr; });
+                        done = ((waitAll and finished == count) or
+                                (not waitAll and finished != 0) or
+                                cond.snap or cond.roi or error);
+                      };
+
+          std::barrier barrier(count, sync);
+
+          auto threadFunc = [&] (unsigned ix) {
+                              auto hart = ithHart(ix);
+                              hart->deferCrossHartEffects(true);
+                              hart->flushMicroTlbs();  // Drop host addresses: they bypass the store buffer.
+                              memory_->selectStoreBuffer(ix);
+                              while (not done)
+                                {
+                                  if (not stopped.at(ix))
+                                    runHart(ix, quantum_, true);
+                                  barrier.arrive_and_wait();
+                                }
+                              hart->deferCrossHartEffects(false);
+                            };
+
+          memory_->setConcurrent(true);
+          memory_->bufferStores(true);
+
+          std::vector<std::thread> threadVec;
+          for (unsigned ix = 0; ix < count; ++ix)
+            threadVec.emplace_back(threadFunc, ix);
+          for (auto& t : threadVec)
+            t.join();
+
+          memory_->bufferStores(false);
+          memory_->setConcurrent(false);
+
+          for (const auto& e : errors)
+            if (e)
+              std::rethrow_exception(e);
+
+          for (auto r : results)
+            result = result and r;
+        }
       else if (not stepWinLo and not stepWinHi)
         {
-          // Run each hart in its own thread.
+          // Run each hart in its own thread. Plain stores do not lock;
+          // atomic instructions commit with a compare-exchange.
+          memory_->setConcurrent(true);
           std::vector<std::thread> threadVec;
           std::atomic<unsigned> finished = 0;  // Count of finished threads.
 
@@ -1758,6 +1948,7 @@ System<URV>::batchRun(std::vector<util::file::SharedFile>& traceFiles, bool wait
                 forceUserStop(0);
               t.join();
             }
+          memory_->setConcurrent(false);
         }
       else
         {
@@ -2000,11 +2191,6 @@ System<URV>::loadSnapshot(const std::string& snapDir, bool restoreTrace)
     }
 
 
-  Filesystem::path usedBlocksPath = dirPath / "usedblocks";
-  std::vector<std::pair<uint64_t,uint64_t>> usedBlocks;
-  if (not loadUsedMemBlocks(usedBlocksPath.string(), usedBlocks))
-    return false;
-
   auto& hart0 = *ithHart(0);
 
   Filesystem::path timePath = dirPath / "time";
@@ -2038,27 +2224,8 @@ System<URV>::loadSnapshot(const std::string& snapDir, bool restoreTrace)
         return false;
     }
 
-  Filesystem::path memPath = dirPath / "memory";
-  if (snapDecompressionType_  == "lz4")
-    {
-#if LZ4_COMPRESS
-      if (not memory_->loadSnapshot_lz4(memPath.string(), usedBlocks))
-        return false;
-#else
-      std::cerr << "Error: LZ4 compression is not enabled\n";
-      return false;
-#endif
-    }
-  else if (snapDecompressionType_ == "gzip")
-    {
-      if (not memory_->loadSnapshot_gzip(memPath.string(), usedBlocks))
-        return false;
-    }
-  else
-    {
-      std::cerr << "Error: Invalid decompression type: " << snapDecompressionType_ << '\n';
-      return false;
-    }
+  if (not loadSnapshotMemory(dirPath))
+    return false;
 
   // Rearm CLINT time compare.
   Filesystem::path mtimecmpPath = dirPath / "mtimecmp";
@@ -2119,6 +2286,136 @@ System<URV>::loadSnapshot(const std::string& snapDir, bool restoreTrace)
 }
 
 
+template <typename URV>
+bool
+System<URV>::loadSnapshotMemory(const Filesystem::path& dirPath)
+{
+  // An incremental snapshot only holds the pages written since its
+  // parent: collect the parent chain to restore it from its base.
+  std::vector<Filesystem::path> chain;
+  std::set<Filesystem::path> visited;  // Canonical paths of chain snapshots.
+  for (Filesystem::path dir = dirPath; ; )
+    {
+      std::error_code ec;
+      Filesystem::path canon = Filesystem::canonical(dir, ec);
+      if (ec)
+        {
+          std::cerr << "Error: Failed to resolve snapshot directory " << dir << ": "
+                    << ec.message() << '\n';
+          return false;
+        }
+      if (not visited.insert(canon).second)
+        {
+          std::cerr << "Error: Snapshot parent chain of " << dirPath << " loops at "
+                    << dir << '\n';
+          return false;
+        }
+      chain.push_back(dir);
+
+      Filesystem::path parentPath = dir / "parent";
+      if (not Filesystem::is_regular_file(parentPath))
+        break;
+
+      std::ifstream ifs(parentPath);
+      std::string parent;
+      if (not std::getline(ifs, parent) or parent.empty())
+        {
+          std::cerr << "Error: Failed to read snapshot parent file " << parentPath << '\n';
+          return false;
+        }
+
+      Filesystem::path parentDir = parent;
+      if (parentDir.is_relative())
+        parentDir = (dir / parentDir).lexically_normal();
+      if (not Filesystem::is_directory(parentDir))
+        {
+          std::cerr << "Error: Parent of snapshot " << dir << " is not a directory: "
+                    << parentDir << '\n';
+          return false;
+        }
+      dir = parentDir;
+    }
+
+  bool lazy = lazySnapLoad_ and sparseMem_;
+  if (lazySnapLoad_)
+    {
+      if (snapDecompressionType_ != "chunked")
+        {
+          std::cerr << "Error: Lazy snapshot load requires the chunked decompression type\n";
+          return false;
+        }
+      if (not sparseMem_)
+        std::cerr << "Info: Lazy snapshot load requires sparse memory, loading eagerly\n";
+      else
+        {
+          sparseMem_->setPageFill(nullptr);
+          lazySnaps_.clear();
+        }
+    }
+
+  for (auto iter = chain.rbegin(); iter != chain.rend(); ++iter)
+    {
+      const Filesystem::path& dir = *iter;
+      Filesystem::path usedBlocksPath = dir / "usedblocks";
+      std::vector<std::pair<uint64_t,uint64_t>> usedBlocks;
+      if (not loadUsedMemBlocks(usedBlocksPath.string(), usedBlocks))
+        return false;
+
+      Filesystem::path memPath = dir / "memory";
+      if (snapDecompressionType_  == "lz4")
+        {
+#if LZ4_COMPRESS
+          if (not memory_->loadSnapshot_lz4(memPath.string(), usedBlocks))
+            return false;
+#else
+          std::cerr << "Error: LZ4 compression is not enabled\n";
+          return false;
+#endif
+        }
+      else if (snapDecompressionType_ == "gzip")
+        {
+          if (not memory_->loadSnapshot_gzip(memPath.string(), usedBlocks))
+            return false;
+        }
+      else if (snapDecompressionType_ == "chunked")
+        {
+          if (lazy)
+            {
+              auto snap = std::make_unique<SnapshotChunks>();
+              if (not snap->open(memPath.string()))
+                return false;
+              lazySnaps_.push_back(std::move(snap));
+            }
+          else if (not memory_->loadSnapshot_chunked(memPath.string()))
+            return false;
+        }
+      else
+        {
+          std::cerr << "Error: Invalid decompression type: " << snapDecompressionType_ << '\n';
+          return false;
+        }
+    }
+
+  if (lazy)
+    {
+      // Restore each page on first access applying the chain from its
+      // base: later snapshots override earlier ones.
+      sparseMem_->setPageFill([this] (uint64_t addr, std::span<uint8_t> page) {
+        for (auto& snap : lazySnaps_)
+          if (not snap->copyRange(addr, page))
+            {
+              std::cerr << "Error: Failed to restore memory page at 0x" << std::hex << addr
+                        << std::dec << " from snapshot\n";
+              return false;
+            }
+        return true;
+      });
+    }
+
+  return true;
+}
+
+
 template <typename URV>
 bool
 System<URV>::saveAplicSnapshot(const Filesystem::path& snapDir) const
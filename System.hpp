@@ -33,6 +33,7 @@
 #include "Uart8250.hpp"
 #include "Cache.hpp"
 #include "SparseMem.hpp"      // Complete type: sparseMem_ is a std::unique_ptr<SparseMem>
+#include "SnapshotChunks.hpp" // Complete type: lazySnaps_ holds std::unique_ptr<SnapshotChunks>
 
 
 namespace TT_PERF
@@ -153,20 +154,30 @@ namespace WdRiscv
 
     /// Define read memory callback. This (along with
     /// defineWriteMemoryCallback) allows the caller to bypass the
-    /// memory model with their own.
+    /// memory model with their own. Direct host access to memory
+    /// (micro-TLBs, block copies) and the validation of cached decodes
+    /// by page write generation are then disabled.
     void defineReadMemoryCallback(
          std::function<bool(uint64_t, unsigned, uint64_t&)> callback )
     {
       memory_->defineReadMemoryCallback(std::move(callback));
+      memory_->markExternalCallbacks();
+      for (auto hart : sysHarts_)
+        hart->flushMicroTlbs();
     }
 
     /// Define write memory callback. This (along with
     /// defineReadMemoryCallback) allows the caller to bypass the
-    /// memory model with their own.
+    /// memory model with their own. Direct host access to memory
+    /// (micro-TLBs, block copies) and the validation of cached decodes
+    /// by page write generation are then disabled.
     void defineWriteMemoryCallback(
          std::function<bool(uint64_t, unsigned, uint64_t)> callback )
     {
       memory_->defineWriteMemoryCallback(std::move(callback));
+      memory_->markExternalCallbacks();
+      for (auto hart : sysHarts_)
+        hart->flushMicroTlbs();
     }
 
     /// Break a hart-index-in-system into a core-index and a
@@ -460,6 +471,11 @@ namespace WdRiscv
     // path specified in the parameter.
     bool produceTestSignatureFile(std::string_view outPath) const;
 
+    /// Fill the given vector with the address/size of the used areas of
+    /// memory in ascending address order: the allocated pages of the
+    /// sparse memory (and the memory of a lazily loaded snapshot) or the
+    /// written regions of the flat memory. Return false if used areas
+    /// are not tracked.
     bool getSparseMemUsedBlocks(std::vector<std::pair<uint64_t, uint64_t>>& usedBlocks) const;
 
     /// Run the simulated harts. Return true on sucess or false if
@@ -468,8 +484,10 @@ namespace WdRiscv
     /// round-robin with each hart executing n instructions where n is
     /// a random number in the range [stepWindowLo, stepWindowHi]. If stepWindow is
     /// 0, each hart runs in its own simulator thread independent of
-    /// the other harts. If earlyTerminate is true, returns on first
-    /// roiEntry exception.
+    /// the other harts. If a quantum was set (see setQuantum), each
+    /// hart runs in its own thread but all harts synchronize after
+    /// every quantum of instructions. If earlyTerminate is true,
+    /// returns on first roiEntry exception.
     bool batchRun(std::vector<util::file::SharedFile>& traceFiles, bool waitAll, uint64_t stepWinLo, uint64_t stepWinHi, bool earlyRoiTerminate = false);
 
     /// Run producing a snapshot after each snapPeriod instructions. Each
@@ -478,6 +496,14 @@ namespace WdRiscv
     /// 0. Return true on success and false on failure.
     bool snapshotRun(std::vector<util::file::SharedFile>& traceFiles, const std::vector<uint64_t>& periods, bool aperiodic);
 
+    /// Set the number of instructions each hart executes between two
+    /// synchronizations of a multi-hart batch run. Cross-hart effects
+    /// (ACLINT/IMSIC writes, LR reservation invalidations) are applied
+    /// at the synchronization points in hart index order. Zero turns
+    /// off quantum runs.
+    void setQuantum(uint64_t quantum)
+    { quantum_ = quantum; }
+
     /// Set snapshot directory path.
     void setSnapshotDir(const std::string& snapDir)
     { snapDir_ = snapDir; }
@@ -488,6 +514,24 @@ namespace WdRiscv
     void setDecompressionType(const std::string& decompressionType)
     { snapDecompressionType_ = decompressionType; }
 
+    /// Enable/disable incremental snapshots: a snapshot following a
+    /// previous one holds only the memory pages written since that
+    /// previous snapshot and names it in its "parent" file. Loading
+    /// restores the memory of the chain from its (full) base snapshot.
+    void enableIncrementalSnapshots(bool flag)
+    {
+      incrementalSnap_ = flag;
+      prevSnapDir_.clear();
+      memory_->enableDirtyTracking(flag);
+    }
+
+    /// Enable/disable lazy loading of snapshot memory: the memory of a
+    /// snapshot saved with the chunked compression type is not restored
+    /// at load time but page by page on first access. Requires sparse
+    /// memory (memory is loaded eagerly otherwise).
+    void enableLazySnapshotLoad(bool flag)
+    { lazySnapLoad_ = flag; }
+
   private:
 
     bool saveAplicSnapshot(const Filesystem::path& snapDir) const;
@@ -495,6 +539,11 @@ namespace WdRiscv
                                  const std::shared_ptr<TT_APLIC::Domain>& domain,
                                  unsigned nsources) const;
     bool loadAplicSnapshot(const Filesystem::path& snapDir);
+
+    /// Restore memory from the given snapshot directory after restoring
+    /// that of its parent chain (see enableIncrementalSnapshots). Fail if
+    /// a parent is missing or the chain loops.
+    bool loadSnapshotMemory(const Filesystem::path& snapDir);
     bool loadAplicDomainSnapshot(const Filesystem::path& snapDir,
                                  const std::shared_ptr<TT_APLIC::Domain>& domain,
                                  unsigned nsources);
@@ -534,9 +583,14 @@ namespace WdRiscv
     using BinaryFile = std::tuple<std::string, uint64_t, uint64_t>;
     std::vector<BinaryFile> binaryFiles_;
 
+    uint64_t quantum_ = 0;  // Instructions per hart between synchronizations.
     std::string snapDir_ = "snapshot"; // Directory to save snapshots.
     std::atomic<int> snapIx_ = -1;
     std::string snapCompressionType_ = "gzip";
     std::string snapDecompressionType_ = "gzip";
+    bool incrementalSnap_ = false;
+    std::string prevSnapDir_;   // Last saved snapshot: parent of the next incremental one.
+    bool lazySnapLoad_ = false;
+    std::vector<std::unique_ptr<SnapshotChunks>> lazySnaps_;  // Lazily loaded chain, base first.
   };
 }
@@ -210,6 +210,44 @@ namespace WdRiscv
       *ptr = value;
     }
 
+    /// Return a pointer to the first of count consecutive elements of type T (starting at
+    /// element 0) of the register group starting at the given register number. Return
+    /// nullptr if count is zero or if the elements do not fit in the group (see
+    /// isValidIndex). This allows element-wise loops to operate on contiguous spans of the
+    /// register file.
+    template<typename T>
+    const T* elemData(uint32_t regNum, uint32_t count, uint32_t groupX8) const
+    {
+      if (count == 0 or not isValidIndex(regNum, count - 1, groupX8, sizeof(T)))
+        return nullptr;
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      return reinterpret_cast<const T*>(&data_.at(size_t(regNum)*bytesPerReg_));
+    }
+
+    /// Same as elemData but for writing the elements. Keep track of the register written
+    /// and associated group multiplier as done by write.
+    template<typename T>
+    T* writableElemData(uint32_t regNum, uint32_t count, uint32_t groupX8)
+    {
+      if (count == 0 or not isValidIndex(regNum, count - 1, groupX8, sizeof(T)))
+        return nullptr;
+
+      if (not lastWrittenReg_.has_value())
+        {
+          lastWrittenReg_ = regNum;
+          lastGroupX8_ = groupX8;
+          saveRegValue(regNum, groupX8);
+        }
+
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      return reinterpret_cast<T*>(&data_.at(size_t(regNum)*bytesPerReg_));
+    }
+
+    /// Return true if the tail elements of a destination vector are left unchanged by an
+    /// instruction (tail-undisturbed or tail-agnostic without setting to all ones).
+    bool isTailKept() const
+    { return not (tailAgn_ and tailAgnOnes_); }
+
     /// Similar to th read method except that the value is always uint64_t. Used to read
     /// the value of an index register of an indexed load/store instruction.
     uint64_t readIndexReg(uint32_t vecReg, uint32_t elemIx, ElementWidth eew,
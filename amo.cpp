@@ -222,6 +222,12 @@ Hart<URV>::loadReserve(const DecodedInst* di, uint32_t rd, uint32_t rs1)
   if (not hasOooVal)
     memRead(addr1, addr1, uval);
 
+  // Remember the loaded bytes (in memory order) for the value check of
+  // a store-conditional in concurrent mode.
+  lrValue_ = bigEnd_ ? util::byteswap(uval) : uval;
+  lrValueAddr_ = addr1;
+  lrValueSize_ = sizeof(uval);
+
   if (traceCacheOn_)
     traceCache(virtAddr, addr1, addr1, true, false, false, false, false);
 
@@ -244,8 +250,6 @@ Hart<URV>::execLr_w(const DecodedInst* di)
       return;
     }
 
-  std::unique_lock lock(memory_.amoMutex_);
-
   lrCount_++;
   if (not loadReserve<int32_t>(di, di->op0(), di->op1()))
     return;
@@ -360,10 +364,24 @@ Hart<URV>::storeCondRel(const DecodedInst* di, URV virtAddr, STORE_TYPE storeVal
       return true;  // Memory updated when merge-buffer written or when sc is retired.
     }
 
+  // In concurrent mode, a store of another hart may land between the
+  // check of the reservation and the write: the SC then writes only if
+  // memory still holds the bytes it covers as loaded by the LR, failing
+  // otherwise. An SC outside the bytes of the LR (but within the
+  // reservation) has nothing to compare against and writes.
   if (isStRel)
     memory_.invalidateOtherHartLr(hartIx_, addr1, ldStSize_);
-
+  else if (addr1 >= lrValueAddr_ and addr1 + sizeof(STORE_TYPE) <= lrValueAddr_ + lrValueSize_)
+    {
+      auto expected = STORE_TYPE(lrValue_ >> 8*(addr1 - lrValueAddr_));
+      expectOnWrite(bigEnd_ ? util::byteswap(expected) : expected);
+    }
   memWrite(addr1, addr1, storeVal);
+  if (expectedWriteFailed())
+    {
+      ldStWrite_ = false;
+      return false;
+    }
 
   STORE_TYPE temp = 0;
   memPeek(addr1, addr2, temp);
@@ -387,8 +405,6 @@ Hart<URV>::execSc_w(const DecodedInst* di)
       return;
     }
 
-  std::unique_lock lock(memory_.amoMutex_);
-
   scPassed_ = false;   // For performance counters.
 
   uint32_t rd = di->op0(), rs1 = di->op1();
@@ -432,10 +448,6 @@ Hart<URV>::execAmo32Op(const DecodedInst* di, Pma::Attrib attrib, OP op)
       return;
     }
 
-  // Lock mutex to serialize AMO instructions. Unlock automatically on
-  // exit from this scope.
-  std::unique_lock lock(memory_.amoMutex_);
-
   uint64_t loadedValue = 0;
   uint32_t rd = di->op0(), rs1 = di->op1(), rs2 = di->op2();
   URV virtAddr = intRegs_.read(rs1);
@@ -449,7 +461,16 @@ Hart<URV>::execAmo32Op(const DecodedInst* di, Pma::Attrib attrib, OP op)
       URV rs2Val = intRegs_.read(rs2);
       URV result = op(rs2Val, rdVal);
 
+      expectOnWrite(loadedValue);
       bool storeOk = store<uint32_t>(di, addr, uint32_t(result), false);
+      if (expectedWriteFailed())
+        {
+          // Another hart stored to the location since our load: redo
+          // the compare-exchange with the value it stored.
+          auto newValue = [&](auto found) { return uint32_t(op(rs2Val, SRV(int32_t(found)))); };
+          rdVal = SRV(int32_t(retryExpectedWrite<uint32_t>(ldStPhysAddr1_, newValue)));
+          result = op(rs2Val, rdVal);
+        }
 
       if (storeOk and not breakpOrEnterDebugTripped())
 	{
@@ -568,8 +589,6 @@ Hart<URV>::execAmo8Op(const DecodedInst* di, Pma::Attrib attrib, OP op)
       return;
     }
 
-  std::unique_lock lock(memory_.amoMutex_);
-
   uint64_t loadedValue = 0;
   uint32_t rd = di->op0(), rs1 = di->op1(), rs2 = di->op2();
   URV virtAddr = intRegs_.read(rs1);
@@ -582,7 +601,16 @@ Hart<URV>::execAmo8Op(const DecodedInst* di, Pma::Attrib attrib, OP op)
       URV rs2Val = intRegs_.read(rs2);
       URV result = op(rs2Val & 0xff, rdVal);
 
+      expectOnWrite(loadedValue);
       bool storeOk = store<uint8_t>(di, addr, uint8_t(result), false);
+      if (expectedWriteFailed())
+        {
+          // Another hart stored to the location since our load: redo
+          // the compare-exchange with the value it stored.
+          auto newValue = [&](auto found) { return uint8_t(op(rs2Val & 0xff, SRV(int8_t(found)))); };
+          rdVal = SRV(int8_t(retryExpectedWrite<uint8_t>(ldStPhysAddr1_, newValue)));
+          result = op(rs2Val & 0xff, rdVal);
+        }
 
       if (storeOk and not breakpOrEnterDebugTripped())
         {
@@ -605,8 +633,6 @@ Hart<URV>::execAmo16Op(const DecodedInst* di, Pma::Attrib attrib, OP op)
       return;
     }
 
-  std::unique_lock lock(memory_.amoMutex_);
-
   uint64_t loadedValue = 0;
   uint32_t rd = di->op0(), rs1 = di->op1(), rs2 = di->op2();
   URV virtAddr = intRegs_.read(rs1);
@@ -619,7 +645,16 @@ Hart<URV>::execAmo16Op(const DecodedInst* di, Pma::Attrib attrib, OP op)
       URV rs2Val = intRegs_.read(rs2);
       URV result = op(rs2Val & 0xffff, rdVal);
 
+      expectOnWrite(loadedValue);
       bool storeOk = store<uint16_t>(di, addr, uint16_t(result), false);
+      if (expectedWriteFailed())
+        {
+          // Another hart stored to the location since our load: redo
+          // the compare-exchange with the value it stored.
+          auto newValue = [&](auto found) { return uint16_t(op(rs2Val & 0xffff, SRV(int16_t(found)))); };
+          rdVal = SRV(int16_t(retryExpectedWrite<uint16_t>(ldStPhysAddr1_, newValue)));
+          result = op(rs2Val & 0xffff, rdVal);
+        }
 
       if (storeOk and not breakpOrEnterDebugTripped())
         {
@@ -811,8 +846,6 @@ Hart<URV>::execAmocas_b(const DecodedInst* di)
       return;
     }
 
-  std::unique_lock lock(memory_.amoMutex_);
-
   uint64_t loadedValue = 0;
   uint32_t rd = di->op0(), rs1 = di->op1(), rs2 = di->op2();
   URV virtAddr = intRegs_.read(rs1);
@@ -826,12 +859,21 @@ Hart<URV>::execAmocas_b(const DecodedInst* di)
 
       if ((loadedValue & 0xff) == expected)
         {
+          expectOnWrite(loadedValue);
           bool storeOk = store<uint8_t>(di, addr, uint8_t(rs2Val), false);
+          if (expectedWriteFailed())
+            {
+              // Another hart stored to the location since our load: redo
+              // the compare-exchange with the value it stored. If that
+              // value no longer matches, memory keeps it.
+              auto newValue = [&](auto found) { return found == expected ? uint8_t(rs2Val) : found; };
+              loadedValue = retryExpectedWrite<uint8_t>(ldStPhysAddr1_, newValue);
+            }
           if (storeOk and not breakpOrEnterDebugTripped())
             {
               intRegs_.write(rd, SRV(int8_t(loadedValue)));
               ldStData_ = loadedValue;
-              ldStWrite_ = true;
+              ldStWrite_ = (loadedValue & 0xff) == expected;
             }
         }
       else
@@ -850,8 +892,6 @@ Hart<URV>::execAmocas_h(const DecodedInst* di)
       return;
     }
 
-  std::unique_lock lock(memory_.amoMutex_);
-
   uint64_t loadedValue = 0;
   uint32_t rd = di->op0(), rs1 = di->op1(), rs2 = di->op2();
   URV virtAddr = intRegs_.read(rs1);
@@ -865,12 +905,21 @@ Hart<URV>::execAmocas_h(const DecodedInst* di)
 
       if ((loadedValue & 0xffff) == expected)
         {
+          expectOnWrite(loadedValue);
           bool storeOk = store<uint16_t>(di, addr, uint16_t(rs2Val), false);
+          if (expectedWriteFailed())
+            {
+              // Another hart stored to the location since our load: redo
+              // the compare-exchange with the value it stored. If that
+              // value no longer matches, memory keeps it.
+              auto newValue = [&](auto found) { return found == expected ? uint16_t(rs2Val) : found; };
+              loadedValue = retryExpectedWrite<uint16_t>(ldStPhysAddr1_, newValue);
+            }
           if (storeOk and not breakpOrEnterDebugTripped())
             {
               intRegs_.write(rd, SRV(int16_t(loadedValue)));
               ldStData_ = loadedValue;
-              ldStWrite_ = true;
+              ldStWrite_ = (loadedValue & 0xffff) == expected;
             }
         }
       else
@@ -890,8 +939,6 @@ Hart<URV>::execLr_d(const DecodedInst* di)
       return;
     }
 
-  std::unique_lock lock(memory_.amoMutex_);
-
   lrCount_++;
   if (not loadReserve<int64_t>(di, di->op0(), di->op1()))
     return;
@@ -922,8 +969,6 @@ Hart<URV>::execSc_d(const DecodedInst* di)
       return;
     }
 
-  std::unique_lock lock(memory_.amoMutex_);
-
   scPassed_ = false;   // For performance counters.
 
   uint32_t rd = di->op0(), rs1 = di->op1();
@@ -968,10 +1013,6 @@ Hart<URV>::execAmo64Op(const DecodedInst* di, Pma::Attrib attrib, OP op)
       return;
     }
 
-  // Lock mutex to serialize AMO instructions. Unlock automatically on
-  // exit from this scope.
-  std::unique_lock lock(memory_.amoMutex_);
-
   uint64_t loadedValue = 0;
   URV rd = di->op0(), rs1 = di->op1(), rs2 = di->op2();
   URV virtAddr = intRegs_.read(rs1);
@@ -984,7 +1025,16 @@ Hart<URV>::execAmo64Op(const DecodedInst* di, Pma::Attrib attrib, OP op)
       URV rs2Val = intRegs_.read(rs2);
       URV result = op(rs2Val, rdVal);
 
+      expectOnWrite(loadedValue);
       bool storeOk = store<uint64_t>(di, addr, result, false);
+      if (expectedWriteFailed())
+        {
+          // Another hart stored to the location since our load: redo
+          // the compare-exchange with the value it stored.
+          auto newValue = [&](uint64_t found) { return uint64_t(op(rs2Val, URV(found))); };
+          rdVal = retryExpectedWrite<uint64_t>(ldStPhysAddr1_, newValue);
+          result = op(rs2Val, rdVal);
+        }
 
       if (storeOk and not breakpOrEnterDebugTripped())
 	{
@@ -1102,10 +1152,6 @@ Hart<URV>::execAmocas_w(const DecodedInst* di)
       return;
     }
 
-  // Lock mutex to serialize AMO instructions. Unlock automatically on
-  // exit from this scope.
-  std::unique_lock lock(memory_.amoMutex_);
-
   uint64_t loadedVal = 0;
   uint32_t rd = di->op0(), rs1 = di->op1(), rs2 = di->op2();
   URV addr = intRegs_.read(rs1);
@@ -1120,7 +1166,19 @@ Hart<URV>::execAmocas_w(const DecodedInst* di)
 
       bool storeOk = true;
       if (temp == rdVal)
-	storeOk = store<uint32_t>(di, addr, uint32_t(rs2Val), false);
+        {
+          expectOnWrite(temp);
+          storeOk = store<uint32_t>(di, addr, uint32_t(rs2Val), false);
+          if (expectedWriteFailed())
+            {
+              // Another hart stored to the location since our load: redo
+              // the compare-exchange with the value it stored. If that
+              // value no longer matches, memory keeps it.
+              auto newValue = [&](auto found) { return found == rdVal ? uint32_t(rs2Val) : found; };
+              temp = retryExpectedWrite<uint32_t>(ldStPhysAddr1_, newValue);
+              ldStWrite_ = temp == rdVal;
+            }
+        }
 
       if (storeOk and not breakpOrEnterDebugTripped())
 	{
@@ -1142,7 +1200,9 @@ Hart<uint32_t>::execAmocas_d(const DecodedInst* di)
     }
 
   // Lock mutex to serialize AMO instructions. Unlock automatically on
-  // exit from this scope.
+  // exit from this scope. The two stores of this instruction cannot be
+  // a single compare-exchange: in concurrent mode (see expectOnWrite)
+  // it is atomic with respect to the other atomic instructions only.
   std::unique_lock lock(memory_.amoMutex_);
 
   uint32_t rd = di->op0(), rs1 = di->op1(), rs2 = di->op2();
@@ -1211,10 +1271,6 @@ Hart<uint64_t>::execAmocas_d(const DecodedInst* di)
       return;
     }
 
-  // Lock mutex to serialize AMO instructions. Unlock automatically on
-  // exit from this scope.
-  std::unique_lock lock(memory_.amoMutex_);
-
   uint32_t rd = di->op0(), rs1 = di->op1(), rs2 = di->op2();
 
   Pma::Attrib attrib = Pma::Attrib::AmoArith;
@@ -1231,7 +1287,19 @@ Hart<uint64_t>::execAmocas_d(const DecodedInst* di)
 
       bool storeOk = true;
       if (temp == rdVal)
-	storeOk = store<uint64_t>(di, addr, rs2Val, false);
+        {
+          expectOnWrite(temp);
+          storeOk = store<uint64_t>(di, addr, rs2Val, false);
+          if (expectedWriteFailed())
+            {
+              // Another hart stored to the location since our load: redo
+              // the compare-exchange with the value it stored. If that
+              // value no longer matches, memory keeps it.
+              auto newValue = [&](auto found) { return found == rdVal ? rs2Val : found; };
+              temp = retryExpectedWrite<uint64_t>(ldStPhysAddr1_, newValue);
+              ldStWrite_ = temp == rdVal;
+            }
+        }
 
       if (storeOk and not breakpOrEnterDebugTripped())
 	intRegs_.write(rd, temp);
@@ -1258,7 +1326,9 @@ Hart<uint64_t>::execAmocas_q(const DecodedInst* di)
     }
 
   // Lock mutex to serialize AMO instructions. Unlock automatically on
-  // exit from this scope.
+  // exit from this scope. The two stores of this instruction cannot be
+  // a single compare-exchange: in concurrent mode (see expectOnWrite)
+  // it is atomic with respect to the other atomic instructions only.
   std::unique_lock lock(memory_.amoMutex_);
 
   uint64_t rd = di->op0(), rs1 = di->op1(), rs2 = di->op2();
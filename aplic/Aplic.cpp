@@ -159,6 +159,13 @@ bool Aplic::containsAddr(uint64_t addr) const {
         [addr](const auto& domain) { return domain->containsAddr(addr); });
 }
 
+bool Aplic::overlapsRange(uint64_t addr0, uint64_t addr1) const {
+    if (addr1 < addrLow_ or addr0 >= addrHigh_)
+        return false;
+    return std::ranges::any_of(domains_,
+        [addr0, addr1](const auto& domain) { return domain->overlaps(addr0, addr1 - addr0 + 1); });
+}
+
 bool Aplic::read(uint64_t addr, size_t size, uint32_t& data) const
 {
     if (size != 4)
@@ -44,6 +44,10 @@ public:
     /// Return true if given address is within the address range of this APLIC.
     bool containsAddr(uint64_t addr) const;
 
+    /// Return true if any address in [addr0, addr1] is within the address range
+    /// of this APLIC.
+    bool overlapsRange(uint64_t addr0, uint64_t addr1) const;
+
     /// Read the APLIC register at the given address placing the value in data and
     /// returning true if successful and false otherwise in which case data is left
     /// unmodified. Given address must be absolute and not an offset from the base address
@@ -21,6 +21,98 @@
 using namespace WdRiscv;
 
 
+/// Return the sum of the products of the corresponding bytes of a and b
+/// where the bytes of a are of type A and those of b of type B (int8_t or
+/// uint8_t). Sum is modulo 2^32.
+template <typename A, typename B>
+static inline
+uint32_t
+dot4(uint32_t a, uint32_t b)
+{
+  uint32_t sum = 0;
+  for (unsigned i = 0; i < 4; ++i)
+    sum += uint32_t(int32_t(A(a >> i*8)) * int32_t(B(b >> i*8)));
+  return sum;
+}
+
+
+template <typename URV>
+template <typename B2, typename B1>
+void
+Hart<URV>::vqdot_vv(unsigned vd, unsigned vs2, unsigned vs1, unsigned group,
+                    unsigned start, unsigned elems, bool masked)
+{
+  unsigned destGroup = std::max(VecRegs::groupMultiplierX8(GroupMultiplier::One), group);
+
+  // All of the first vl elements are active and the tail is left as is:
+  // operate on contiguous spans (vectorizable loop).
+  if (start == 0 and not masked and vecRegs_.isTailKept())
+    {
+      unsigned vl = vecRegs_.elemCount();
+      const auto* src2 = vecRegs_.elemData<uint32_t>(vs2, vl, group);
+      const auto* src1 = vecRegs_.elemData<uint32_t>(vs1, vl, group);
+      if (src2 and src1)
+        if (auto* dst = vecRegs_.writableElemData<uint32_t>(vd, vl, destGroup))
+          {
+            for (unsigned ix = 0; ix < vl; ++ix)
+              dst[ix] += dot4<B2, B1>(src2[ix], src1[ix]);
+            return;
+          }
+    }
+
+  for (unsigned ix = start; ix < elems; ++ix)
+    {
+      uint32_t dest = 0;
+      if (vecRegs_.isDestActive(vd, ix, destGroup, masked, dest))
+	{
+	  uint32_t e2 = 0, e1 = 0;
+	  vecRegs_.read(vs2, ix, group, e2);
+	  vecRegs_.read(vs1, ix, group, e1);
+	  dest += dot4<B2, B1>(e2, e1);
+	}
+
+      vecRegs_.write(vd, ix, destGroup, dest);
+    }
+}
+
+
+template <typename URV>
+template <typename B2, typename B1>
+void
+Hart<URV>::vqdot_vx(unsigned vd, unsigned vs2, uint32_t e1, unsigned group,
+                    unsigned start, unsigned elems, bool masked)
+{
+  unsigned destGroup = std::max(VecRegs::groupMultiplierX8(GroupMultiplier::One), group);
+
+  // See vqdot_vv.
+  if (start == 0 and not masked and vecRegs_.isTailKept())
+    {
+      unsigned vl = vecRegs_.elemCount();
+      const auto* src2 = vecRegs_.elemData<uint32_t>(vs2, vl, group);
+      if (src2)
+        if (auto* dst = vecRegs_.writableElemData<uint32_t>(vd, vl, destGroup))
+          {
+            for (unsigned ix = 0; ix < vl; ++ix)
+              dst[ix] += dot4<B2, B1>(src2[ix], e1);
+            return;
+          }
+    }
+
+  for (unsigned ix = start; ix < elems; ++ix)
+    {
+      uint32_t dest = 0;
+      if (vecRegs_.isDestActive(vd, ix, destGroup, masked, dest))
+	{
+	  uint32_t e2 = 0;
+	  vecRegs_.read(vs2, ix, group, e2);
+	  dest += dot4<B2, B1>(e2, e1);
+	}
+
+      vecRegs_.write(vd, ix, destGroup, dest);
+    }
+}
+
+
 template <typename URV>
 void
 Hart<URV>::execVqdot_vv(const DecodedInst* di)
@@ -51,27 +143,7 @@ Hart<URV>::execVqdot_vv(const DecodedInst* di)
       return;
     }
 
-  unsigned destGroup = std::max(VecRegs::groupMultiplierX8(GroupMultiplier::One), group);
-
-  for (unsigned ix = start; ix < elems; ++ix)
-    {
-      int32_t dest = 0;
-      if (vecRegs_.isDestActive(vd, ix, destGroup, masked, dest))
-	{
-	  int32_t e1 = 0, e2 = 0;
-	  vecRegs_.read(vs2, ix, group, e1);
-	  vecRegs_.read(vs1, ix, group, e2);
-
-	  for (unsigned i = 0; i < sizeof(e1); ++i)
-	    {
-	      int32_t b1 = int8_t(e1 >> i*8);  // Ith byte of e1.
-	      int32_t b2 = int8_t(e2 >> i*8);  // Ith byte of e2.
-	      dest += b1 * b2;
-	    }
-	}
-
-      vecRegs_.write(vd, ix, destGroup, dest);
-    }
+  vqdot_vv<int8_t, int8_t>(vd, vs2, vs1, group, start, elems, masked);
   postVecSuccess(di);
 }
 
@@ -106,28 +178,7 @@ Hart<URV>::execVqdot_vx(const DecodedInst* di)
       return;
     }
 
-  unsigned destGroup = std::max(VecRegs::groupMultiplierX8(GroupMultiplier::One), group);
-
-  int32_t e2 = intRegs_.read(rs);
-
-  for (unsigned ix = start; ix < elems; ++ix)
-    {
-      int32_t dest = 0;
-      if (vecRegs_.isDestActive(vd, ix, destGroup, masked, dest))
-	{
-	  int32_t e1 = 0;
-	  vecRegs_.read(vs2, ix, group, e1);
-
-	  for (unsigned i = 0; i < sizeof(e1); ++i)
-	    {
-	      int32_t b1 = int8_t(e1 >> i*8);  // Ith byte of e1.
-	      int32_t b2 = int8_t(e2 >> i*8);  // Ith byte of e2.
-	      dest += b1 * b2;
-	    }
-	}
-
-      vecRegs_.write(vd, ix, destGroup, dest);
-    }
+  vqdot_vx<int8_t, int8_t>(vd, vs2, intRegs_.read(rs), group, start, elems, masked);
   postVecSuccess(di);
 }
 
@@ -162,27 +213,7 @@ Hart<URV>::execVqdotu_vv(const DecodedInst* di)
       return;
     }
 
-  unsigned destGroup = std::max(VecRegs::groupMultiplierX8(GroupMultiplier::One), group);
-
-  for (unsigned ix = start; ix < elems; ++ix)
-    {
-      uint32_t dest = 0;
-      if (vecRegs_.isDestActive(vd, ix, destGroup, masked, dest))
-	{
-	  uint32_t e1 = 0, e2 = 0;
-	  vecRegs_.read(vs2, ix, group, e1);
-	  vecRegs_.read(vs1, ix, group, e2);
-
-	  for (unsigned i = 0; i < sizeof(e1); ++i)
-	    {
-	      uint32_t b1 = uint8_t(e1 >> i*8);  // Ith byte of e1.
-	      uint32_t b2 = uint8_t(e2 >> i*8);  // Ith byte of e2.
-	      dest += b1 * b2;
-	    }
-	}
-
-      vecRegs_.write(vd, ix, destGroup, dest);
-    }
+  vqdot_vv<uint8_t, uint8_t>(vd, vs2, vs1, group, start, elems, masked);
   postVecSuccess(di);
 }
 
@@ -217,28 +248,7 @@ Hart<URV>::execVqdotu_vx(const DecodedInst* di)
       return;
     }
 
-  unsigned destGroup = std::max(VecRegs::groupMultiplierX8(GroupMultiplier::One), group);
-
-  uint32_t e2 = intRegs_.read(rs);
-
-  for (unsigned ix = start; ix < elems; ++ix)
-    {
-      uint32_t dest = 0;
-      if (vecRegs_.isDestActive(vd, ix, destGroup, masked, dest))
-	{
-	  uint32_t e1 = 0;
-	  vecRegs_.read(vs2, ix, group, e1);
-
-	  for (unsigned i = 0; i < sizeof(e1); ++i)
-	    {
-	      uint32_t b1 = uint8_t(e1 >> i*8);  // Ith byte of e1.
-	      uint32_t b2 = uint8_t(e2 >> i*8);  // Ith byte of e2.
-	      dest += b1 * b2;
-	    }
-	}
-
-      vecRegs_.write(vd, ix, destGroup, dest);
-    }
+  vqdot_vx<uint8_t, uint8_t>(vd, vs2, intRegs_.read(rs), group, start, elems, masked);
   postVecSuccess(di);
 }
 
@@ -273,28 +283,7 @@ Hart<URV>::execVqdotsu_vv(const DecodedInst* di)
       return;
     }
 
-  unsigned destGroup = std::max(VecRegs::groupMultiplierX8(GroupMultiplier::One), group);
-
-  for (unsigned ix = start; ix < elems; ++ix)
-    {
-      int32_t dest = 0;
-      if (vecRegs_.isDestActive(vd, ix, destGroup, masked, dest))
-	{
-	  int32_t e1 = 0;
-	  uint32_t e2 = 0;
-	  vecRegs_.read(vs2, ix, group, e1);
-	  vecRegs_.read(vs1, ix, group, e2);
-
-	  for (unsigned i = 0; i < sizeof(e1); ++i)
-	    {
-	      int32_t b1 = int8_t(e1 >> i*8);  // Ith byte of e1.
-	      int32_t b2 = uint8_t(e2 >> i*8);  // Ith byte of e2.
-	      dest += b1 * b2;
-	    }
-	}
-
-      vecRegs_.write(vd, ix, destGroup, dest);
-    }
+  vqdot_vv<int8_t, uint8_t>(vd, vs2, vs1, group, start, elems, masked);
   postVecSuccess(di);
 }
 
@@ -329,28 +318,7 @@ Hart<URV>::execVqdotsu_vx(const DecodedInst* di)
       return;
     }
 
-  unsigned destGroup = std::max(VecRegs::groupMultiplierX8(GroupMultiplier::One), group);
-
-  uint32_t e2 = intRegs_.read(rs);
-
-  for (unsigned ix = start; ix < elems; ++ix)
-    {
-      int32_t dest = 0;
-      if (vecRegs_.isDestActive(vd, ix, destGroup, masked, dest))
-	{
-	  int32_t e1 = 0;
-	  vecRegs_.read(vs2, ix, group, e1);
-
-	  for (unsigned i = 0; i < sizeof(e1); ++i)
-	    {
-	      int32_t b1 = int8_t(e1 >> i*8);  // Ith byte of e1.
-	      int32_t b2 = uint8_t(e2 >> i*8);  // Ith byte of e2.
-	      dest += b1 * b2;
-	    }
-	}
-
-      vecRegs_.write(vd, ix, destGroup, dest);
-    }
+  vqdot_vx<int8_t, uint8_t>(vd, vs2, intRegs_.read(rs), group, start, elems, masked);
   postVecSuccess(di);
 }
 
@@ -385,28 +353,7 @@ Hart<URV>::execVqdotus_vx(const DecodedInst* di)
       return;
     }
 
-  unsigned destGroup = std::max(VecRegs::groupMultiplierX8(GroupMultiplier::One), group);
-
-  int32_t e2 = intRegs_.read(rs);
-
-  for (unsigned ix = start; ix < elems; ++ix)
-    {
-      int32_t dest = 0;
-      if (vecRegs_.isDestActive(vd, ix, destGroup, masked, dest))
-	{
-	  uint32_t e1 = 0;
-	  vecRegs_.read(vs2, ix, group, e1);
-
-	  for (unsigned i = 0; i < sizeof(e1); ++i)
-	    {
-	      int32_t b1 = uint8_t(e1 >> i*8);  // Ith byte of e1.
-	      int32_t b2 = int8_t(e2 >> i*8);  // Ith byte of e2.
-	      dest += b1 * b2;
-	    }
-	}
-
-      vecRegs_.write(vd, ix, destGroup, dest);
-    }
+  vqdot_vx<uint8_t, int8_t>(vd, vs2, intRegs_.read(rs), group, start, elems, masked);
   postVecSuccess(di);
 }
 
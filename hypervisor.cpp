@@ -79,6 +79,10 @@ Hart<URV>::execHfence_vvma(const DecodedInst* di)
       vsTlb.invalidateVirtualPageAsid(vpn, asid, wid);
       stage2Tlb.invalidateAsidVmid(asid, vmid, wid);
     }
+
+  virtMem_.flushPteCache();  // Cached PTEs and page-walk cache entries.
+  flushFetchTlb();
+  flushDataTlb();
 }
 
 
@@ -150,6 +154,10 @@ Hart<URV>::execHfence_gvma(const DecodedInst* di)
 
       vsTlb.invalidateVmid(vmid, wid);
     }
+
+  virtMem_.flushPteCache();  // Cached PTEs and page-walk cache entries.
+  flushFetchTlb();
+  flushDataTlb();
 }
 
 
@@ -454,6 +454,18 @@ namespace TT_IMSIC      // TensTorrent Incoming Message Signaled Interrupt Contr
                           });
     }
 
+    /// Return true if given address is within the machine/supervisor/guest
+    /// pages associated with this IMSIC.
+    bool coversAddress(uint64_t addr) const
+    {
+      if (mfile_.coversAddress(addr) or sfile_.coversAddress(addr))
+	return true;
+      return std::any_of(gfiles_.begin(), gfiles_.end(),
+                          [addr] (const auto& gfile) {
+                            return gfile.coversAddress(addr);
+                          });
+    }
+
     /// Write to this IMSIC. Return false doing nothing if address is
     /// not valid. Return true and perform a write if address is
     /// valid.  Write may be a no-op if written data corresponds to a
@@ -567,6 +567,21 @@ namespace TT_IOMMU
       return isPmpRegAddr(addr) or isPmaRegAddr(addr);
     }
 
+    /// Return true if the memory region of this IOMMU contains any address in
+    /// [addr0, addr1].
+    bool overlapsRange(uint64_t addr0, uint64_t addr1) const
+    {
+      auto overlaps = [addr0, addr1](uint64_t base, uint64_t size) {
+        return addr0 < base + size and base <= addr1;
+      };
+      if (overlaps(params_.baseAddress, params_.size))
+        return true;
+      if (pmpEnabled_ and (overlaps(pmpcfgAddr_, pmpcfgCount_ * 8) or
+                           overlaps(pmpaddrAddr_, pmpaddrCount_ * 8)))
+        return true;
+      return pmaEnabled_ and overlaps(pmacfgAddr_, pmacfgCount_ * 8);
+    }
+
     bool cqFull() const { return (cqt_ + 1) % cqb_.capacity() == cqh_; }
     bool fqFull() const { return (fqt_ + 1) % fqb_.capacity() == fqh_; }
     bool pqFull() const { return (pqt_ + 1) % pqb_.capacity() == pqh_; }
@@ -26,6 +26,12 @@ class Pci {
     { return (addr >= config_base_ and addr < (config_base_ + config_len_)) or
              (addr >= mmio_base_ and addr < (mmio_base_ + mmio_len_)); }
 
+    // Returns true if any address in [addr0, addr1] relies within the defined PCI
+    // memory regions.
+    bool overlaps_range(uint64_t addr0, uint64_t addr1) const
+    { return (addr0 < (config_base_ + config_len_) and config_base_ <= addr1) or
+             (addr0 < (mmio_base_ + mmio_len_) and mmio_base_ <= addr1); }
+
     template <typename T>
     void access(uint32_t addr, T& data, bool w)
     {
@@ -65,11 +71,14 @@ class Pci {
           return false;
         }
 
-      if (not read_mem_ or not write_mem_ or not msi_)
+      if (not read_mem_ or not write_mem_ or not read_mem_block_ or not write_mem_block_ or
+          not msi_)
         return false;
 
       dev->read_mem_ = read_mem_;
       dev->write_mem_ = write_mem_;
+      dev->read_mem_block_ = read_mem_block_;
+      dev->write_mem_block_ = write_mem_block_;
       dev->msi_ = msi_;
 
       buses_.at(bus).at(slot) = dev;
@@ -116,6 +125,12 @@ class Pci {
     void define_write_mem(const std::function<bool(uint64_t, size_t, uint64_t)>& f)
     { write_mem_ = f; }
 
+    void define_read_mem_block(const std::function<bool(uint64_t, std::span<uint8_t>)>& f)
+    { read_mem_block_ = f; }
+
+    void define_write_mem_block(const std::function<bool(uint64_t, std::span<const uint8_t>)>& f)
+    { write_mem_block_ = f; }
+
     void define_msi(const std::function<bool(uint64_t, unsigned, uint64_t)>& f)
     { msi_ = f; }
 
@@ -166,5 +181,7 @@ class Pci {
     // Callback functions for read/write/msi.
     std::function<bool(uint64_t, size_t, uint64_t&)> read_mem_ = nullptr;
     std::function<void(uint64_t, size_t, uint64_t)> write_mem_ = nullptr;
+    std::function<bool(uint64_t, std::span<uint8_t>)> read_mem_block_ = nullptr;
+    std::function<bool(uint64_t, std::span<const uint8_t>)> write_mem_block_ = nullptr;
     std::function<void(uint64_t, unsigned, uint64_t)> msi_ = nullptr;
 };
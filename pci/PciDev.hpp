@@ -15,6 +15,7 @@
 #include <iostream>
 #include <cstring>
 #include <optional>
+#include <span>
 
 // under PCIe, 4096 bytes of configuration space
 #define PCI_CFG_SIZE 4096
@@ -244,6 +245,14 @@ class PciDev {
       write_mem_(addr, sizeof(U), tmp);
     }
 
+    /// Reads a block of host-side memory. Returns true on success.
+    bool read_mem_block(uint64_t addr, std::span<uint8_t> data) const
+    { return read_mem_block_(addr, data); }
+
+    /// Writes a block of host-side memory. Returns true on success.
+    bool write_mem_block(uint64_t addr, std::span<const uint8_t> data) const
+    { return write_mem_block_(addr, data); }
+
     /// Trigger MSI to host.
     void msi(uint64_t addr, size_t size, uint64_t data) const
     { msi_(addr, size, data); }
@@ -256,6 +265,8 @@ class PciDev {
 
     std::function<void(uint64_t, size_t, uint64_t&)> read_mem_;
     std::function<void(uint64_t, size_t, uint64_t)> write_mem_;
+    std::function<bool(uint64_t, std::span<uint8_t>)> read_mem_block_;
+    std::function<bool(uint64_t, std::span<const uint8_t>)> write_mem_block_;
     std::function<void(uint64_t, unsigned, uint64_t)> msi_;
 
     uint8_t* header_eol_;
@@ -49,6 +49,8 @@ struct virtio_blk_outhdr {
 #define VIRTIO_BLK_F_RO             5
 #define VIRTIO_BLK_S_IOERR          1
 #define VIRTIO_BLK_S_OK             0
+#define VIRTIO_BLK_S_UNSUPP         2
+#define VIRTIO_BLK_T_FLUSH          4
 #define VIRTIO_BLK_T_GET_ID         8
 #define VIRTIO_BLK_T_IN             0
 #define VIRTIO_BLK_T_OUT            1
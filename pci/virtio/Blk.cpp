@@ -3,6 +3,8 @@
 #else
 #include <linux/virtio_ids.h>
 #endif
+#include <algorithm>
+#include <cstdint>
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <thread>
@@ -21,7 +23,7 @@ Blk::Blk(bool readonly) : Virtio(VIRTIO_ID_BLOCK, 0x018000, 1)
 bool
 Blk::open_file(const std::string& filename)
 {
-  int flags = (features_ & VIRTIO_BLK_F_RO)? O_RDONLY : O_RDWR;
+  int flags = (features_ & (uint64_t(1) << VIRTIO_BLK_F_RO))? O_RDONLY : O_RDWR;
   fd_ = open(filename.c_str(), flags);
 
   if (fd_ < 0)
@@ -37,9 +39,10 @@ Blk::open_file(const std::string& filename)
 void
 Blk::operator()(unsigned vq)
 {
-  if (not fd_)
+  if (fd_ < 0)
     return;
 
+  // Service all the available requests, then signal them in one used ring update.
   std::vector<virtqueue::used_ring::elem> elems;
   bool finished = false;
 
@@ -51,70 +54,115 @@ Blk::operator()(unsigned vq)
       if (not get_descriptors(vq, reads, writes, head, finished))
         break;
 
-      // order of descriptors is header, buffer, status
-      if ((reads.size() + writes.size()) != 3)
+      // order of descriptors is header, data buffers, status
+      if (reads.empty() or writes.empty())
         {
-          std::cerr << "Error: Unexpected descriptors for virtio-blk (expected 3): " << reads.size() + writes.size() << '\n';
+          std::cerr << "Error: Unexpected descriptors for virtio-blk (expected header and status)\n";
           break;
         }
 
-      unsigned read_ptr = 0, write_ptr = 0;
-      auto desc = reads.at(read_ptr++);
       uint32_t header_type = 0;
       uint64_t header_sector = 0;
-      read_mem(desc.address + offsetof(virtio_blk_outhdr, type), header_type);
-      read_mem(desc.address + offsetof(virtio_blk_outhdr, sector), header_sector);
+      read_mem(reads.front().address + offsetof(virtio_blk_outhdr, type), header_type);
+      read_mem(reads.front().address + offsetof(virtio_blk_outhdr, sector), header_sector);
 
-      desc = (header_type == VIRTIO_BLK_T_OUT)? reads.at(read_ptr++) : writes.at(write_ptr++);
-      uint64_t buffer_addr = desc.address;
-      uint32_t buffer_length = desc.length;
+      uint64_t status_addr = writes.back().address;
 
-      desc = writes.at(write_ptr++);
-      uint64_t status_addr = desc.address;
+      // Data buffers are device readable for a write and device writable otherwise.
+      std::span<const virtqueue::descriptor> data;
+      if (header_type == VIRTIO_BLK_T_OUT)
+        data = std::span<const virtqueue::descriptor>(reads).subspan(1);
+      else
+        data = std::span<const virtqueue::descriptor>(writes).first(writes.size() - 1);
 
-      if (header_type != VIRTIO_BLK_T_GET_ID)
-        {
-          // TODO: use pread/pwrite instead
-          if (lseek(fd_, static_cast<uint32_t>(header_sector * 512), SEEK_SET) < 0)
-            {
-              write_mem(status_addr, VIRTIO_BLK_S_IOERR);
-              elems.push_back({head, 0});
-              continue;
-            }
-        }
+      uint32_t in_bytes = 0;
+      uint8_t status = process(header_type, header_sector, data, in_bytes);
+
+      // The used length counts all the bytes written to the request: data and
+      // status.
+      write_mem(status_addr, status);
+      elems.push_back({head, in_bytes + 1});
+    }
+
+  signal_used(vq, elems);
+}
+
+
+uint8_t
+Blk::process(uint32_t type, uint64_t sector, std::span<const virtqueue::descriptor> data,
+             uint32_t& in_bytes)
+{
+  in_bytes = 0;
+
+  auto offset = off_t(sector * 512);
 
-      int res = 0;
-      switch (header_type)
+  switch (type)
+    {
+      case VIRTIO_BLK_T_IN:
         {
-          case VIRTIO_BLK_T_IN:
-            // In reality we could optimize this by reading in chunks (rest of first page + second).
-            // Instead, we just operate on bytes.
-            for (uint32_t i = 0; i < buffer_length; ++i)
+          // Read the request a chunk at a time into the guest buffers: the buffer
+          // lengths are guest controlled. Bytes past the end of the image read as
+          // zero.
+          uint64_t pos = 0;
+          for (const auto& desc : data)
+            for (uint64_t done = 0; done < desc.length; )
               {
-                uint8_t data = 0;
-                res = res or (read(fd_, &data, 1) < 0);
-                write_mem(buffer_addr + i, data);
+                uint64_t size = std::min(desc.length - done, maxChunk_);
+                buffer_.assign(size, 0);
+                for (uint64_t got = 0; got < size; )
+                  {
+                    ssize_t n = pread(fd_, &buffer_.at(got), size - got, off_t(offset + pos + got));
+                    if (n < 0)
+                      return VIRTIO_BLK_S_IOERR;
+                    if (n == 0)
+                      break;
+                    got += n;
+                  }
+                if (not write_mem_block(desc.address + done, buffer_))
+                  return VIRTIO_BLK_S_IOERR;
+                done += size;
+                pos += size;
+                in_bytes = uint32_t(std::min(pos, uint64_t(UINT32_MAX - 1)));
               }
-            break;
-          case VIRTIO_BLK_T_OUT:
-            for (uint32_t i = 0; i < buffer_length; ++i)
+          return VIRTIO_BLK_S_OK;
+        }
+
+      case VIRTIO_BLK_T_OUT:
+        {
+          // Gather the guest buffers a chunk at a time and write them.
+          uint64_t pos = 0;
+          for (const auto& desc : data)
+            for (uint64_t done = 0; done < desc.length; )
               {
-                uint8_t data = 0;
-                read_mem(buffer_addr + i, data);
-                res = res or (write(fd_, &data, 1) < 0);
+                uint64_t size = std::min(desc.length - done, maxChunk_);
+                buffer_.resize(size);
+                if (not read_mem_block(desc.address + done, buffer_))
+                  return VIRTIO_BLK_S_IOERR;
+                for (uint64_t put = 0; put < size; )
+                  {
+                    ssize_t n = pwrite(fd_, &buffer_.at(put), size - put, off_t(offset + pos + put));
+                    if (n <= 0)
+                      return VIRTIO_BLK_S_IOERR;
+                    put += n;
+                  }
+                done += size;
+                pos += size;
               }
-            break;
-          case VIRTIO_BLK_T_GET_ID:
-            write_mem(buffer_addr, '0');
-            write_mem(buffer_addr + 1, '\0');
-            break;
-          default:
-            assert(false);
+          return VIRTIO_BLK_S_OK;
         }
 
-      write_mem(status_addr, (res < 0)? VIRTIO_BLK_S_IOERR : VIRTIO_BLK_S_OK);
-      elems.push_back({head, (header_type == VIRTIO_BLK_T_IN)? uint32_t(buffer_length) : 0});
-    }
+      case VIRTIO_BLK_T_FLUSH:
+        return fsync(fd_) == 0 ? VIRTIO_BLK_S_OK : VIRTIO_BLK_S_IOERR;
 
-  signal_used(vq, elems);
+      case VIRTIO_BLK_T_GET_ID:
+        if (data.empty())
+          return VIRTIO_BLK_S_IOERR;
+        write_mem(data.front().address, '0');
+        write_mem(data.front().address + 1, '\0');
+        in_bytes = 2;
+        return VIRTIO_BLK_S_OK;
+
+      default:
+        return VIRTIO_BLK_S_UNSUPP;
+    }
 }
@@ -2,6 +2,8 @@
 
 #include <unistd.h>
 #include <iostream>
+#include <span>
+#include <vector>
 #ifndef __APPLE__
 #include <linux/virtio_blk.h>
 #endif
@@ -17,7 +19,7 @@ class Blk : public Virtio {
 
     ~Blk() override
     {
-      if (fd_)
+      if (fd_ >= 0)
         close(fd_);
     }
 
@@ -30,7 +32,7 @@ class Blk : public Virtio {
       if (not Virtio::setup())
         return false;
 
-      if (not fd_)
+      if (fd_ < 0)
         return false;
 
       // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
@@ -44,6 +46,14 @@ class Blk : public Virtio {
 
     void operator()(unsigned vq) final;
 
+    // Service one request of the given type and sector with the given data
+    // buffer descriptors. Set in_bytes to the number of bytes written to the
+    // data buffers (excluding the status byte). Return the request status.
+    uint8_t process(uint32_t type, uint64_t sector,
+                    std::span<const virtqueue::descriptor> data, uint32_t& in_bytes);
+
     int fd_ = -1;
     virtio_blk_config* config_ = nullptr;
+    static constexpr uint64_t maxChunk_ = uint64_t(1) << 20;  // Max staging size.
+    std::vector<uint8_t> buffer_;   // Staging buffer of a request chunk.
 };
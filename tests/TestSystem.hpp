@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "System.hpp"
+#include "Hart.hpp"
+
+
+/// Report a failed check and exit.
+#define CHECK(cond)                                                     \
+  do {                                                                  \
+    if (not (cond))                                                     \
+      {                                                                 \
+        std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: "  \
+                  << #cond << '\n';                                     \
+        std::exit(1);                                                   \
+      }                                                                 \
+  } while (0)
+
+
+namespace TestSystem
+{
+  using System64 = WdRiscv::System<uint64_t>;
+  using Hart64 = WdRiscv::Hart<uint64_t>;
+
+  constexpr uint64_t memSize  = uint64_t(64) << 20;
+  constexpr uint64_t pageSize = 4096;
+  constexpr uint64_t codeAddr = 0x1000;   // Program start.
+  constexpr uint64_t rootPt   = 0x100000; // Sv39 root page table.
+  constexpr uint64_t level1Pt = 0x101000;
+  constexpr uint64_t level0Pt = 0x102000;
+  constexpr uint64_t mappedSize = uint64_t(2) << 20;  // Identity mapped by level0Pt.
+
+  /// Return a single-hart RV64 system with supervisor mode.
+  inline std::unique_ptr<System64> makeSystem()
+  {
+    auto system = std::make_unique<System64>(1, 1, 1, memSize, pageSize);
+    auto& hart = *system->ithHart(0);
+    CHECK(hart.configIsa("rv64imasu", true));
+    hart.reset();
+    return system;
+  }
+
+  /// Write the given instructions at codeAddr and point the PC at them.
+  inline void loadProgram(Hart64& hart, const std::vector<uint32_t>& code)
+  {
+    uint64_t addr = codeAddr;
+    for (auto inst : code)
+      {
+        CHECK(hart.pokeMemory(addr, inst, true));
+        addr += 4;
+      }
+    hart.pokePc(codeAddr);
+  }
+
+  /// Identity map the first 2 MiB with 4 KiB Sv39 pages and switch the hart to
+  /// supervisor mode with translation on.
+  inline void enableSv39(Hart64& hart)
+  {
+    constexpr uint64_t valid = 1, leaf = 0xcf;  // V, V+R+W+X+A+D.
+    CHECK(hart.pokeMemory(rootPt, ((level1Pt >> 12) << 10) | valid, true));
+    CHECK(hart.pokeMemory(level1Pt, ((level0Pt >> 12) << 10) | valid, true));
+    for (uint64_t page = 0; page < mappedSize / pageSize; ++page)
+      CHECK(hart.pokeMemory(level0Pt + page*8, (page << 10) | leaf, true));
+
+    // Grant supervisor mode access to all of memory: one NAPOT PMP region.
+    CHECK(hart.pokeCsr(WdRiscv::CsrNumber::PMPADDR0, ~uint64_t(0) >> 10));
+    CHECK(hart.pokeCsr(WdRiscv::CsrNumber::PMPCFG0, 0x1f));
+
+    uint64_t satp = (uint64_t(8) << 60) | (rootPt >> 12);  // Sv39.
+    CHECK(hart.pokeCsr(WdRiscv::CsrNumber::SATP, satp));
+    hart.setPrivilegeMode(WdRiscv::PrivilegeMode::Supervisor);
+  }
+
+  // Instruction encodings.
+  constexpr uint32_t ld(unsigned rd, unsigned rs1, int imm)
+  { return (uint32_t(imm & 0xfff) << 20) | (rs1 << 15) | (3 << 12) | (rd << 7) | 0x03; }
+
+  constexpr uint32_t sd(unsigned rs2, unsigned rs1, int imm)
+  {
+    return (uint32_t((imm >> 5) & 0x7f) << 25) | (rs2 << 20) | (rs1 << 15) | (3 << 12) |
+      (uint32_t(imm & 0x1f) << 7) | 0x23;
+  }
+
+  constexpr uint32_t addi(unsigned rd, unsigned rs1, int imm)
+  { return (uint32_t(imm & 0xfff) << 20) | (rs1 << 15) | (rd << 7) | 0x13; }
+
+  constexpr uint32_t sfenceVma = 0x12000073;  // sfence.vma x0, x0
+}
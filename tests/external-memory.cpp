@@ -0,0 +1,42 @@
+// Check that a decoded instruction is not reused when memory is modeled by
+// external callbacks: a write that bypasses the simulator (and thus the page
+// write generations) must be seen by the next fetch.
+
+#include <cstring>
+#include "TestSystem.hpp"
+
+using namespace TestSystem;
+
+
+int
+main()
+{
+  auto system = makeSystem();
+  auto& hart = *system->ithHart(0);
+
+  std::vector<uint8_t> backing(memSize);
+  system->defineReadMemoryCallback([&backing](uint64_t addr, unsigned size, uint64_t& value) {
+    value = 0;
+    std::memcpy(&value, backing.data() + addr, size);
+    return true;
+  });
+  system->defineWriteMemoryCallback([&backing](uint64_t addr, unsigned size, uint64_t value) {
+    std::memcpy(backing.data() + addr, &value, size);
+    return true;
+  });
+
+  loadProgram(hart, { addi(5, 0, 1) });
+  hart.singleStep();
+  uint64_t x5 = 0;
+  CHECK(hart.peekIntReg(5, x5) and x5 == 1);
+
+  // Replace the instruction behind the back of the simulator and run it again.
+  uint32_t inst = addi(5, 0, 2);
+  std::memcpy(backing.data() + codeAddr, &inst, sizeof(inst));
+  hart.pokePc(codeAddr);
+  hart.singleStep();
+  CHECK(hart.peekIntReg(5, x5) and x5 == 2);
+
+  std::cout << "external-memory: passed\n";
+  return 0;
+}
@@ -0,0 +1,61 @@
+// Check that resizing the TLB while the fetch and data micro-TLBs hold entries
+// flushes them: they point into the TLB storage being reallocated, so the first
+// translation after the resize must miss in the new TLB.
+
+#include <functional>
+#include "TestSystem.hpp"
+
+using namespace TestSystem;
+
+
+static void
+checkResize(const char* name, const std::function<void(Hart64&)>& resize)
+{
+  auto system = makeSystem();
+  auto& hart = *system->ithHart(0);
+
+  constexpr uint64_t data = 0x8000;
+  constexpr uint64_t value = 0x123456789abcdef0;
+  CHECK(hart.pokeMemory(data, value, true));
+
+  std::vector<uint32_t> code(8, ld(5, 6, 0));
+  loadProgram(hart, code);
+  CHECK(hart.pokeIntReg(6, data));
+  enableSv39(hart);
+
+  // Populate the micro-TLBs.
+  for (unsigned i = 0; i < 4; ++i)
+    hart.singleStep();
+
+  uint64_t hits = 0, misses = 0, evictions = 0;
+  hart.tlbStats(hits, misses, evictions);
+
+  resize(hart);
+
+  for (unsigned i = 0; i < 4; ++i)
+    hart.singleStep();
+
+  uint64_t postHits = 0, postMisses = 0;
+  hart.tlbStats(postHits, postMisses, evictions);
+  if (postMisses <= misses)
+    {
+      std::cerr << "micro-tlb-resize: " << name << ": no TLB miss after resize\n";
+      std::exit(1);
+    }
+
+  uint64_t x5 = 0;
+  CHECK(hart.peekIntReg(5, x5));
+  CHECK(x5 == value);
+}
+
+
+int
+main()
+{
+  checkResize("setTlbSize", [] (Hart64& hart) { hart.setTlbSize(16); });
+  checkResize("setTlbWays", [] (Hart64& hart) { hart.setTlbWays(2); });
+  checkResize("setSuperpageTlbSize", [] (Hart64& hart) { hart.setSuperpageTlbSize(8); });
+
+  std::cout << "micro-tlb-resize: passed\n";
+  return 0;
+}
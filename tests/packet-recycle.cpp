@@ -0,0 +1,79 @@
+// Check that an instruction packet recycled by the packet pool carries no state of
+// the instruction that used it before.
+
+#include "PerfApi.hpp"
+#include "TestSystem.hpp"
+
+using namespace TestSystem;
+
+
+int
+main()
+{
+  auto system = makeSystem();
+  auto& hart = *system->ithHart(0);
+
+  constexpr uint64_t data = 0x8000;
+  loadProgram(hart, { sd(1, 2, 8), addi(3, 0, 1), addi(4, 0, 2) });
+  CHECK(hart.pokeIntReg(1, 0x55));
+  CHECK(hart.pokeIntReg(2, data));
+
+  std::vector<FILE*> traceFiles;
+  CHECK(system->enablePerfApi(traceFiles));
+  auto& perf = *system->getPerfApi();
+
+  bool trap = false;
+  WdRiscv::ExceptionCause cause{};
+  uint64_t trapPc = 0;
+  uint64_t time = 1;
+
+  // Run a store through the whole pipeline: its packet returns to the pool once drained.
+  CHECK(perf.fetch(0, time++, 1, codeAddr, trap, cause, trapPc) and not trap);
+  CHECK(perf.decode(0, time++, 1));
+  CHECK(perf.execute(0, time++, 1));
+  const auto* store = perf.getInstructionPacketRaw(0, 1);
+  CHECK(store and store->dataVa() == data + 8 and store->dataSize() == 8);
+  CHECK(perf.retire(0, time++, 1));
+  CHECK(perf.drainStore(0, time++, 1));
+  CHECK(perf.getInstructionPacketRaw(0, 1) == nullptr);
+
+  // The store packet is released once the next fetch replaces it as the previous
+  // fetch: the fetch after that reuses it.
+  CHECK(perf.fetch(0, time++, 2, codeAddr + 4, trap, cause, trapPc) and not trap);
+  CHECK(perf.fetch(0, time++, 3, codeAddr + 8, trap, cause, trapPc) and not trap);
+  const auto* packet = perf.getInstructionPacketRaw(0, 3);
+  CHECK(packet == store);
+
+  CHECK(packet->tag() == 3);
+  CHECK(packet->instrVa() == codeAddr + 8);
+  CHECK(packet->decoded() and not packet->isStore());  // Fetch decodes.
+  CHECK(not packet->executed());
+  CHECK(not packet->retired() and not packet->drained());
+  CHECK(not packet->trapped() and not packet->predicted());
+  CHECK(packet->dataVa() == 0 and packet->dataPa() == 0 and packet->dataPa2() == 0);
+  CHECK(packet->dataSize() == 0 and packet->stData() == 0);
+  CHECK(packet->vecDataAddrs().empty());
+  CHECK(packet->getFetchPageTableWalks().empty());
+  CHECK(packet->getDataPageTableWalks().empty());
+
+  std::array<TT_PERF::Operand, 3> ops;
+  CHECK(packet->getSourceOperands(ops) == 2);
+  CHECK(ops.at(0).value.scalar == 0 and ops.at(0).value.vec.empty());  // x0
+
+  for (uint64_t tag = 2; tag <= 3; ++tag)
+    {
+      CHECK(perf.decode(0, time++, tag));
+      CHECK(perf.execute(0, time++, tag));
+    }
+  CHECK(packet->getSourceOperands(ops) == 2);
+  CHECK(ops.at(1).value.scalar == 2);  // Immediate.
+  CHECK(packet->dataVa() == 0 and packet->dataSize() == 0);
+  CHECK(perf.retire(0, time++, 2));
+  CHECK(perf.retire(0, time++, 3));
+
+  uint64_t x4 = 0;
+  CHECK(hart.peekIntReg(4, x4) and x4 == 2);
+
+  std::cout << "packet-recycle: passed\n";
+  return 0;
+}
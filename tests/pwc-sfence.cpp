@@ -0,0 +1,43 @@
+// Check that sfence.vma drops the page-walk cache: the first walk after the fence
+// must read every level of the page table again.
+
+#include "TestSystem.hpp"
+
+using namespace TestSystem;
+
+
+int
+main()
+{
+  auto system = makeSystem();
+  auto& hart = *system->ithHart(0);
+
+  loadProgram(hart, { ld(5, 6, 0),     // Load from a new page: walk.
+                      ld(5, 7, 0),     // Load from another page: walk.
+                      sfenceVma,
+                      ld(5, 8, 0) });  // Fetched from a flushed TLB: walk.
+  CHECK(hart.pokeIntReg(6, 0x8000));
+  CHECK(hart.pokeIntReg(7, 0x9000));
+  CHECK(hart.pokeIntReg(8, 0xa000));
+  enableSv39(hart);
+
+  uint64_t hits = 0, misses = 0;
+  hart.singleStep();
+  hart.singleStep();
+  hart.pageWalkCacheStats(hits, misses);
+  CHECK(hits > 0);   // Walks after the first one resume at the cached level 0 table.
+
+  hart.singleStep();  // sfence.vma
+  uint64_t fenceHits = 0, fenceMisses = 0;
+  hart.pageWalkCacheStats(fenceHits, fenceMisses);
+
+  hart.singleStep();
+  uint64_t postHits = 0, postMisses = 0;
+  hart.pageWalkCacheStats(postHits, postMisses);
+  CHECK(postMisses > fenceMisses);  // Fetch walk after the fence misses.
+
+  CHECK(hart.peekPc() == codeAddr + 16);
+
+  std::cout << "pwc-sfence: passed\n";
+  return 0;
+}
@@ -0,0 +1,81 @@
+// Check the loading of incremental snapshots: a chain restores the memory written
+// before its parent snapshot, and a chain with a missing or looping parent is
+// rejected.
+
+#include <fstream>
+#include <unistd.h>
+#include "Filesystem.hpp"
+#include "TestSystem.hpp"
+
+using namespace TestSystem;
+
+
+static void
+writeParent(const Filesystem::path& dir, const std::string& parent)
+{
+  std::ofstream ofs(dir / "parent");
+  ofs << parent << '\n';
+  CHECK(ofs.good());
+}
+
+
+static bool
+loadSnapshot(const Filesystem::path& dir, uint64_t addr, uint64_t& value)
+{
+  auto system = makeSystem();
+  if (not system->loadSnapshot(dir.string(), false))
+    return false;
+  return system->ithHart(0)->peekMemory(addr, value, true);
+}
+
+
+int
+main()
+{
+  auto root = Filesystem::temp_directory_path() /
+    ("whisper-snapshot-chain-" + std::to_string(getpid()));
+  Filesystem::remove_all(root);
+  CHECK(Filesystem::create_directories(root));
+
+  constexpr uint64_t addr1 = 0x10000, addr2 = 0x20000;
+  constexpr uint64_t value1 = 0x1111, value2 = 0x2222;
+
+  {
+    auto system = makeSystem();
+    auto& hart = *system->ithHart(0);
+    system->enableIncrementalSnapshots(true);
+
+    CHECK(hart.pokeMemory(addr1, value1, true));
+    CHECK(system->saveSnapshot((root / "s0").string()));
+    CHECK(hart.pokeMemory(addr2, value2, true));
+    CHECK(system->saveSnapshot((root / "s1").string()));
+  }
+  CHECK(Filesystem::is_regular_file(root / "s1" / "parent"));
+
+  // A valid chain restores the pages of both snapshots.
+  uint64_t value = 0;
+  CHECK(loadSnapshot(root / "s1", addr1, value) and value == value1);
+  CHECK(loadSnapshot(root / "s1", addr2, value) and value == value2);
+
+  // Missing parent.
+  Filesystem::copy(root / "s1", root / "orphan", Filesystem::copy_options::recursive);
+  writeParent(root / "orphan", "../missing");
+  CHECK(not loadSnapshot(root / "orphan", addr1, value));
+
+  // Snapshot that is its own parent.
+  Filesystem::copy(root / "s1", root / "self", Filesystem::copy_options::recursive);
+  writeParent(root / "self", ".");
+  CHECK(not loadSnapshot(root / "self", addr1, value));
+
+  // Two snapshots that are the parent of each other.
+  Filesystem::copy(root / "s1", root / "a", Filesystem::copy_options::recursive);
+  Filesystem::copy(root / "s1", root / "b", Filesystem::copy_options::recursive);
+  writeParent(root / "a", "../b");
+  writeParent(root / "b", "../a");
+  CHECK(not loadSnapshot(root / "a", addr1, value));
+
+  Filesystem::remove_all(root);
+
+  std::cout << "snapshot-chain: passed\n";
+  return 0;
+}
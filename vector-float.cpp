@@ -662,11 +662,10 @@ Hart<URV>::execVfmv_s_f(const DecodedInst* di)
 
 
 template <typename URV>
-template <typename ELEM_TYPE>
+template <typename ELEM_TYPE, typename OP>
 void
 Hart<URV>::vfop_vv(unsigned vd, unsigned vs1, unsigned vs2, unsigned group,
-		   unsigned start, unsigned elems, bool masked,
-		   std::function<ELEM_TYPE(ELEM_TYPE, ELEM_TYPE)> fop)
+		   unsigned start, unsigned elems, bool masked, OP fop)
 {
   ELEM_TYPE e1{}, e2{}, dest{};
 
@@ -675,6 +674,29 @@ Hart<URV>::vfop_vv(unsigned vd, unsigned vs1, unsigned vs2, unsigned group,
   if (start >= vecRegs_.elemCount())
     return;
 
+  // All of the first vl elements are active and the tail is left as is:
+  // operate on contiguous spans. The incremental flags are still
+  // collected per element.
+  if (start == 0 and not masked and vecRegs_.isTailKept())
+    {
+      unsigned vl = vecRegs_.elemCount();
+      const auto* src1 = vecRegs_.elemData<ELEM_TYPE>(vs1, vl, group);
+      const auto* src2 = vecRegs_.elemData<ELEM_TYPE>(vs2, vl, group);
+      if (src1 and src2)
+	if (auto* dst = vecRegs_.writableElemData<ELEM_TYPE>(vd, vl, destGroup))
+	  {
+	    auto& flags = vecRegs_.fpFlags_;
+	    for (unsigned ix = 0; ix < vl; ++ix)
+	      {
+		dst[ix] = fop(src1[ix], src2[ix]);
+		flags.push_back(activeSimulatorFpFlags());
+	      }
+	    if (elems > vl)
+	      flags.resize(flags.size() + (elems - vl), 0);
+	    return;
+	  }
+    }
+
   for (unsigned ix = start; ix < elems; ++ix)
     {
       if (vecRegs_.isDestActive(vd, ix, destGroup, masked, dest))
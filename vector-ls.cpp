@@ -15,6 +15,7 @@
 #include <iostream>
 #include <cfenv>
 #include <cmath>
+#include <cstring>
 #include <climits>
 #include <limits>
 #include <cassert>
@@ -109,6 +110,75 @@ Hart<URV>::checkVecLdStIndexedInst(const DecodedInst* di, unsigned vd, unsigned
 }
 
 
+template <typename URV>
+template <typename ELEM_TYPE>
+unsigned
+Hart<URV>::vecLdStPageBulk(unsigned vd, unsigned groupX8, uint64_t addr,
+                          unsigned ix, unsigned end, bool isLoad)
+{
+  const unsigned elemSize = sizeof(ELEM_TYPE);
+  uint64_t va = URV(applyPointerMask(URV(addr), isLoad));
+
+  auto* entry = dataTlbLookup(va);
+  if (not entry or not (isLoad ? entry->read_ : entry->write_))
+    return 0;
+
+  uint64_t offset = va & dataTlbPageMask_;
+  uint64_t pa = entry->ppa_ | offset;
+  uint64_t inPage = (dataTlbPageMask_ + 1 - offset) / elemSize;
+  unsigned count = unsigned(std::min(inPage, uint64_t(end - ix)));
+
+  // Stop short of a console-io/to-host location: it has side effects.
+  if (entry->special_)
+    for (unsigned i = 0; i < count; ++i)
+      if (isSpecialAddr(pa + i*elemSize))
+        {
+          count = i;
+          break;
+        }
+  if (count == 0)
+    return 0;
+
+  size_t bytes = size_t(count) * elemSize;
+  uint8_t* host = entry->host_ + offset;
+  const ELEM_TYPE* elems = nullptr;
+  if (isLoad)
+    {
+      ELEM_TYPE* dest = vecRegs_.writableElemData<ELEM_TYPE>(vd, ix + count, groupX8);
+      if (not dest or not touchMainTlb(*entry, count))
+        return 0;
+      memcpy(dest + ix, host, bytes);
+      elems = dest;
+    }
+  else
+    {
+      elems = vecRegs_.elemData<ELEM_TYPE>(vd, ix + count, groupX8);
+      if (not elems or not touchMainTlb(*entry, count))
+        return 0;
+      invalidateDecodeCache(pa, bytes);
+      memory_.invalidateOtherHartLr(hartIx_, pa, bytes);
+      memcpy(host, elems + ix, bytes);
+      memory_.notifyWrite(pa, bytes);
+      ldStWrite_ = true;
+      ldStData_ = elems[ix + count - 1];
+    }
+
+  auto& ldStInfo = vecRegs_.ldStInfo_;
+  for (unsigned i = 0; i < count; ++i, addr += elemSize, pa += elemSize)
+    ldStInfo.addElem(VecLdStElem{addr, pa, pa, elems[ix + i], ix + i, false});
+
+  // Reproduce the side effects of determineLoadException/determineStoreException
+  // for the last element.
+  ldStFaultAddr_ = va + bytes - elemSize;
+  misalignedLdSt_ = false;
+  setMemProtAccIsFetch(false);
+  ldStPma1_ = entry->pma_;
+  ldStPma2_ = Pma{};
+
+  return count;
+}
+
+
 template <typename URV>
 template <typename ELEM_TYPE>
 bool
@@ -153,8 +223,21 @@ Hart<URV>::vectorLoad(const DecodedInst* di, ElementWidth eew, bool faultFirst)
   TriggerTiming timing = TriggerTiming::Before;
   bool isLd = true;
 
+  // Unmasked active elements may be copied a page at a time through the
+  // data micro-TLB.
+  bool bulk = not masked and dataTlbUsable(di, addr, elemSize);
+
   for (unsigned ix = start; ix < elemMax; ++ix, addr += elemSize)
     {
+      if (bulk and ix < elemCount)
+        if (unsigned n = vecLdStPageBulk<ELEM_TYPE>(vd, groupX8, addr, ix, elemCount, true))
+          {
+            // Loop increment accounts for the last copied element.
+            ix += n - 1;
+            addr += uint64_t(n - 1) * elemSize;
+            continue;
+          }
+
       ELEM_TYPE elem = 0;
       bool skip = not vecRegs_.isDestActive(vd, ix, groupX8, masked, elem);
 
@@ -173,6 +256,8 @@ Hart<URV>::vectorLoad(const DecodedInst* di, ElementWidth eew, bool faultFirst)
 #ifndef FAST_SLOPPY
       bool hyper = false, amo = false;
       cause = determineLoadException(pa1, pa2, gpa1, gpa2, elemSize, hyper, amo, ix);
+      if (bulk and cause == ExceptionCause::NONE)
+        fillDataTlb(ldStFaultAddr_, gpa1, pa1, ldStPma1_, false /*write*/);
 
       if (hasTrig)
         {
@@ -362,8 +447,21 @@ Hart<URV>::vectorStore(const DecodedInst* di, ElementWidth eew)
   TriggerTiming timing = TriggerTiming::Before;
   bool isLd = false;  // Not a load.
 
+  // Unmasked elements may be copied a page at a time through the data
+  // micro-TLB.
+  bool bulk = not masked and dataTlbUsable(di, addr, elemSize);
+
   for (unsigned ix = start; ix < elemCount; ++ix, addr += elemSize)
     {
+      if (bulk)
+        if (unsigned n = vecLdStPageBulk<ELEM_TYPE>(vd, groupX8, addr, ix, elemCount, false))
+          {
+            // Loop increment accounts for the last copied element.
+            ix += n - 1;
+            addr += uint64_t(n - 1) * elemSize;
+            continue;
+          }
+
       bool skip = masked and not vecRegs_.isActive(0, ix);
 
       ldStInfo.addElem(VecLdStElem{addr, addr, addr, 0, ix, skip});
@@ -378,6 +476,8 @@ Hart<URV>::vectorStore(const DecodedInst* di, ElementWidth eew)
       uint64_t gpa1 = addr, gpa2 = addr;
 
       auto cause = determineStoreException(pa1, pa2, gpa1, gpa2, elemSize, false /*hyper*/);
+      if (bulk and cause == ExceptionCause::NONE)
+        fillDataTlb(ldStFaultAddr_, gpa1, pa1, ldStPma1_, true /*write*/);
 
       if (hasTrig)
         {
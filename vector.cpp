@@ -802,59 +802,6 @@ Hart<URV>::execVsetvl(const DecodedInst* di)
 }
 
 
-template <typename URV>
-template <typename ELEM_TYPE>
-void
-Hart<URV>::vop_vv(unsigned vd, unsigned vs1, unsigned vs2, unsigned group,
-		  unsigned start, unsigned elems, bool masked,
-		  std::function<ELEM_TYPE(ELEM_TYPE, ELEM_TYPE)> op)
-{
-  ELEM_TYPE e1{}, e2{}, dest{};
-
-  unsigned destGroup = std::max(VecRegs::groupMultiplierX8(GroupMultiplier::One), group);
-
-  if (start >= vecRegs_.elemCount())
-    return;
-
-  for (unsigned ix = start; ix < elems; ++ix)
-    {
-      if (vecRegs_.isDestActive(vd, ix, destGroup, masked, dest))
-	{
-	  vecRegs_.read(vs1, ix, group, e1);
-	  vecRegs_.read(vs2, ix, group, e2);
-	  dest = op(e1, e2);
-	}
-      vecRegs_.write(vd, ix, destGroup, dest);
-    }
-}
-
-
-template <typename URV>
-template <typename ELEM_TYPE>
-void
-Hart<URV>::vop_vx(unsigned vd, unsigned vs1, ELEM_TYPE e2, unsigned group,
-		  unsigned start, unsigned elems, bool masked,
-		  std::function<ELEM_TYPE(ELEM_TYPE, ELEM_TYPE)> op)
-{
-  ELEM_TYPE e1 = 0, dest = 0;
-
-  unsigned destGroup = std::max(VecRegs::groupMultiplierX8(GroupMultiplier::One), group);
-
-  if (start >= vecRegs_.elemCount())
-    return;
-
-  for (unsigned ix = start; ix < elems; ++ix)
-    {
-      if (vecRegs_.isDestActive(vd, ix, destGroup, masked, dest))
-	{
-	  vecRegs_.read(vs1, ix, group, e1);
-	  dest = op(e1, e2);
-	}
-      vecRegs_.write(vd, ix, destGroup, dest);
-    }
-}
-
-
 template <typename URV>
 template <typename OP>
 void
@@ -1982,11 +1929,10 @@ Hart<URV>::execVwsub_wv(const DecodedInst* di)
 
 
 template <typename URV>
-template <typename ELEM_TYPE>
+template <typename ELEM_TYPE, typename OP>
 void
 Hart<URV>::vmop_vv(unsigned vd, unsigned vs1, unsigned vs2, unsigned group,
-		   unsigned start, unsigned elems, bool masked,
-		   std::function<bool(ELEM_TYPE, ELEM_TYPE)> op)
+		   unsigned start, unsigned elems, bool masked, OP op)
 {
   ELEM_TYPE e1{}, e2{};
 
@@ -2010,11 +1956,10 @@ Hart<URV>::vmop_vv(unsigned vd, unsigned vs1, unsigned vs2, unsigned group,
 
 
 template <typename URV>
-template <typename ELEM_TYPE>
+template <typename ELEM_TYPE, typename OP>
 void
 Hart<URV>::vmop_vx(unsigned vd, unsigned vs1, ELEM_TYPE e2, unsigned group,
-		   unsigned start, unsigned elems, bool masked,
-		   std::function<bool(ELEM_TYPE, ELEM_TYPE)> op)
+		   unsigned start, unsigned elems, bool masked, OP op)
 {
   ELEM_TYPE e1 = 0;
 
@@ -3683,25 +3628,31 @@ Hart<URV>::execVcompress_vm(const DecodedInst* di)
 
 
 template <typename URV>
-template<typename ELEM_TYPE>
+template<typename ELEM_TYPE, typename OP>
 void
 Hart<URV>::vredop_vs(unsigned vd, unsigned vs1, unsigned vs2, unsigned group,
-		     unsigned start, unsigned elems, bool masked,
-		     std::function<ELEM_TYPE(ELEM_TYPE, ELEM_TYPE)> op)
+		     unsigned start, unsigned elems, bool masked, OP op)
 {
   ELEM_TYPE e1 = 0, result = 0;
   unsigned scalarElemIx = 0, scalarElemGroupX8 = 8;
 
   vecRegs_.read(vs2, scalarElemIx, scalarElemGroupX8, result);
 
-  for (unsigned ix = start; ix < elems; ++ix)
+  const auto* src1 = masked ? nullptr : vecRegs_.elemData<ELEM_TYPE>(vs1, elems, group);
+  if (src1)
     {
-      if (masked and not vecRegs_.isActive(0, ix))
-	continue;
-
-      vecRegs_.read(vs1, ix, group, e1);
-      result = op(result, e1);
+      for (unsigned ix = start; ix < elems; ++ix)
+	result = static_cast<ELEM_TYPE>(op(result, src1[ix]));
     }
+  else
+    for (unsigned ix = start; ix < elems; ++ix)
+      {
+	if (masked and not vecRegs_.isActive(0, ix))
+	  continue;
+
+	vecRegs_.read(vs1, ix, group, e1);
+	result = static_cast<ELEM_TYPE>(op(result, e1));
+      }
 
   vecRegs_.write(vd, scalarElemIx, scalarElemGroupX8, result);
   unsigned destElems = vecRegs_.singleMax(vecRegs_.elemWidth());
@@ -11,7 +11,7 @@ Tlb::Tlb(unsigned size)
   if ((size & (size - 1)) != 0)
     std::cerr << "Error: TLB size must be a power of 2\n";
   else
-    entries_.resize(size);
+    arrays_.at(0).resize(size, ways_);
 }
 
 
@@ -19,38 +19,27 @@ bool
 Tlb::insertEntry(uint64_t virtPageNum, uint64_t physPageNum, uint32_t asid, uint32_t wid,
                  bool global, bool isUser, bool read, bool write, bool exec)
 {
-  auto* entry = getEntry(virtPageNum);
-
-  if (not entry)
-    return false;
-
-  if (entry->valid_ and entry->counter_ & 2)
-    {
-      --entry->counter_;
-      return false;
-    }
-  
-          entry->valid_ = true;
-      entry->virtPageNum_ = virtPageNum;
-      entry->physPageNum_ = physPageNum;
-      entry->counter_ = 0;
-      entry->asid_ = asid;
-      entry->wid_ = wid;
-      entry->global_ = global;
-      entry->user_ = isUser;
-      entry->read_ = read;
-      entry->write_ = write;
-      entry->exec_ = exec;
-      return true;
-   
+  TlbEntry te;
+  te.valid_ = true;
+  te.virtPageNum_ = virtPageNum;
+  te.physPageNum_ = physPageNum;
+  te.asid_ = asid;
+  te.wid_ = wid;
+  te.global_ = global;
+  te.user_ = isUser;
+  te.read_ = read;
+  te.write_ = write;
+  te.exec_ = exec;
+  return insertEntry(te);
 }
 
 
 void
 Tlb::printTlb(std::ostream& ost) const
 {
-  for (const auto&te: entries_)
-    printEntry(ost, te);
+  for (const auto& array : arrays_)
+    for (const auto& te : array.entries)
+      printEntry(ost, te);
 }
 
 
@@ -74,19 +63,51 @@ Tlb::printEntry(std::ostream& ost, const TlbEntry& te) const
 bool
 Tlb::insertEntry(const TlbEntry& te)
 {
-  auto* entry = getEntry(te.virtPageNum_);
+  // A superpage goes, whole, in the array of its level if there is one.
+  // Otherwise, the entry covers the single page of te.virtPageNum_.
+  TlbEntry copy = te;
+  copy.pageCount_ = 1;
+  Array* array = &arrays_.at(0);
+  if (superpages_ and te.level_ >= 2 and te.level_ <= maxLevel(mode_))
+    {
+      array = &arrays_.at(te.level_ - 1);
+      uint64_t base = alignPageNumBySize(mode_, te.virtPageNum_, te.level_);
+      copy.physPageNum_ = te.physPageNum_ - (te.virtPageNum_ - base);
+      copy.virtPageNum_ = base;
+      copy.pageCount_ = sizeIn4kBytes(mode_, te.level_);
+    }
 
+  auto* entry = selectVictim(*array, copy.virtPageNum_);
   if (not entry)
     return false;
 
-  if (entry->valid_ and entry->counter_ & 2)
+  if (entry->valid_)
+    ++evictions_;
+  *entry = copy;
+  entry->counter_ = 0;
+  return true;
+}
+
+
+TlbEntry*
+Tlb::selectVictim(Array& array, uint64_t pageNum)
+{
+  if (array.entries.empty())
+    return nullptr;
+
+  size_t base = array.setIndex(pageNum);
+  TlbEntry* victim = nullptr;
+  for (unsigned i = 0; i < array.ways; ++i)
     {
-      --entry->counter_;
-      return false;
+      auto& entry = array.entries[base + i];
+      if (not entry.valid_)
+        return &entry;
+      if ((entry.counter_ & 2) == 0 and (not victim or entry.counter_ < victim->counter_))
+        victim = &entry;
     }
-  
-          *entry = te;
-      entry->counter_ = 0;
-      return true;
-   
+
+  if (not victim)
+    for (unsigned i = 0; i < array.ways; ++i)
+      --array.entries[base + i].counter_;
+  return victim;
 }
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <ostream>
 #include <vector>
@@ -43,6 +44,17 @@ namespace WdRiscv
     bool dirty_ = false;
     uint8_t level_ = 0;      // Level of corresponding PTE in address translation walk.
     uint8_t pbmt_ = 0;
+    uint64_t pageCount_ = 1; // Number of 4k pages covered starting at virtPageNum_.
+
+    /// Return the physical page number of the given virtual page number
+    /// which must be covered by this entry.
+    uint64_t physPageNum(uint64_t vpn) const
+    { return physPageNum_ + (vpn - virtPageNum_); }
+
+    /// Return true if this entry is valid and maps the given virtual page
+    /// number to the given physical page number.
+    bool maps(uint64_t vpn, uint64_t ppn) const
+    { return valid_ and vpn - virtPageNum_ < pageCount_ and physPageNum(vpn) == ppn; }
   };
 
 
@@ -62,12 +74,9 @@ namespace WdRiscv
     /// Return nullptr if no such entry.
     TlbEntry* findEntry(uint64_t pageNum, uint32_t asid, uint32_t wid)
     {
-      auto* entry = getEntry(pageNum);
-
-      if (entry and entry->valid_ and entry->virtPageNum_ == pageNum and entry->wid_ == wid)
-        if (entry->global_ or entry->asid_ == asid)
-            return entry;
-      return nullptr;
+      return find(pageNum, [asid, wid](const TlbEntry& entry) {
+        return entry.wid_ == wid and (entry.global_ or entry.asid_ == asid);
+      });
     }
 
     /// Return pointer to TLB entry associated with given virtual page
@@ -75,13 +84,10 @@ namespace WdRiscv
     /// Return nullptr if no such entry.
     TlbEntry* findEntry(uint64_t pageNum, uint32_t asid, uint32_t vmid, uint32_t wid)
     {
-      auto* entry = getEntry(pageNum);
-
-      if (entry and entry->valid_ and entry->virtPageNum_ == pageNum and
-          entry->vmid_ == vmid and entry->wid_ == wid and
-          (entry->global_ or entry->asid_ == asid))
-        return entry;
-      return nullptr;
+      return find(pageNum, [asid, vmid, wid](const TlbEntry& entry) {
+        return entry.vmid_ == vmid and entry.wid_ == wid and
+          (entry.global_ or entry.asid_ == asid);
+      });
     }
 
     /// Return pointer to TLB entry associated with given virtual page
@@ -91,11 +97,7 @@ namespace WdRiscv
     TlbEntry* findEntryUpdateTime(uint64_t pageNum, uint32_t asid, uint32_t wid)
     {
       auto* entry = findEntry(pageNum, asid, wid);
-      if (entry)
-        {
-          ++entry->counter_;
-          entry->counter_ &= 3;
-        }
+      countAccess(entry);
       return entry;
     }
 
@@ -106,14 +108,20 @@ namespace WdRiscv
     TlbEntry* findEntryUpdateTime(uint64_t pageNum, uint32_t asid, uint32_t vmid, uint32_t wid)
     {
       auto* entry = findEntry(pageNum, asid, vmid, wid);
-      if (entry)
-        {
-          ++entry->counter_;
-          entry->counter_ &= 3;
-        }
+      countAccess(entry);
       return entry;
     }
 
+    /// Set hits/misses to the number of lookups (with update of entry
+    /// time) that found/did not find an entry and evictions to the
+    /// number of valid entries replaced by an insertion.
+    void getStats(uint64_t& hits, uint64_t& misses, uint64_t& evictions) const
+    {
+      hits = hits_;
+      misses = misses_;
+      evictions = evictions_;
+    }
+
     /// Print TLB content
     void printTlb(std::ostream& ost) const;
 
@@ -157,13 +165,36 @@ namespace WdRiscv
     }
 
 
-    /// Set number of TLB entries.
+    /// Set number of TLB entries. Clear the TLB.
     void setTlbSize(unsigned size)
-    { entries_.resize(size); }
+    { arrays_.at(0).resize(size, ways_); }
+
+    /// Set the associativity (number of entries per set) of the TLB
+    /// and its superpage arrays. An array with fewer entries is fully
+    /// associative. Clear the TLB.
+    void setTlbWays(unsigned ways)
+    {
+      ways_ = std::max(ways, 1u);
+      for (auto& array : arrays_)
+        array.resize(array.entries.size(), ways_);
+    }
+
+    /// Set the number of entries of each of the superpage (2M/4M, 1G,
+    /// 512G, and 256T) arrays. If zero, superpage translations share
+    /// the main array with one entry per 4k page. Otherwise, an entry of
+    /// a superpage array covers the whole superpage. Clear the TLB.
+    void setSuperpageTlbSize(unsigned size)
+    {
+      for (size_t i = 1; i < arrays_.size(); ++i)
+        arrays_.at(i).resize(size, ways_);
+      arrays_.at(0).resize(arrays_.at(0).entries.size(), ways_);
+      superpages_ = size != 0;
+    }
 
-    /// Insert a TLB entry for the given translation parameters. If TLB is full the
-    /// contents of the least recently accessed slot are replaced by the given
-    /// parameters. Return true on success and false otherwise.
+    /// Insert a TLB entry for the given translation parameters. If the set of
+    /// the entry is full the contents of a slot that was not recently
+    /// accessed are replaced by the given parameters. Return true on success
+    /// and false otherwise.
     bool insertEntry(uint64_t virtPageNum, uint64_t physPageNum, uint32_t asid,
                      uint32_t wid, bool global, bool isUser, bool read, bool write,
                      bool exec);
@@ -175,35 +206,38 @@ namespace WdRiscv
     /// global.
     void invalidateAsid(uint32_t asid, uint32_t wid)
     {
-      for (auto& entry : entries_)
-	if ((not entry.global_) and entry.asid_ == asid and entry.wid_ == wid)
-          {
-            entry.valid_ = false;
-            entry.counter_ = 0;
-          }
+      for (auto& array : arrays_)
+        for (auto& entry : array.entries)
+          if ((not entry.global_) and entry.asid_ == asid and entry.wid_ == wid)
+            {
+              entry.valid_ = false;
+              entry.counter_ = 0;
+            }
     }
 
     /// Invalidate every entry matching given virtual-machine identifier.
     void invalidateVmid(uint32_t vmid, uint32_t wid)
     {
-      for (auto& entry : entries_)
-	if (entry.vmid_ == vmid and entry.wid_ == wid)
-          {
-            entry.valid_ = false;
-            entry.counter_ = 0;
-          }
+      for (auto& array : arrays_)
+        for (auto& entry : array.entries)
+          if (entry.vmid_ == vmid and entry.wid_ == wid)
+            {
+              entry.valid_ = false;
+              entry.counter_ = 0;
+            }
     }
 
     /// Invalidate every entry matching given vmid and address space identifier.
     void invalidateAsidVmid(uint32_t asid, uint32_t vmid, uint32_t wid)
     {
-      for (auto& entry : entries_)
-	if ((not entry.global_) and entry.vmid_ == vmid and entry.asid_ == asid and
-            entry.wid_ == wid)
-          {
-            entry.valid_ = false;
-            entry.counter_ = 0;
-          }
+      for (auto& array : arrays_)
+        for (auto& entry : array.entries)
+          if ((not entry.global_) and entry.vmid_ == vmid and entry.asid_ == asid and
+              entry.wid_ == wid)
+            {
+              entry.valid_ = false;
+              entry.counter_ = 0;
+            }
     }
 
     /// Invalidate every entry matching given virtual page number.
@@ -212,35 +246,37 @@ namespace WdRiscv
       unsigned maxSize = 0;   // Size in 4k-bytes of largest entry covering vpn.
       uint64_t vpnOfMax = 0;
 
-      for (auto& entry : entries_)
-        {
-          auto size = sizeIn4kBytes(mode_, entry.level_);
-          auto pageNum = alignPageNumBySize(mode_, entry.virtPageNum_, entry.level_);
-
-          if (entry.wid_ == wid and pageNum <= vpn and
-              vpn < pageNum + size)
-            {
-              if (size > maxSize)
-                {
-                  maxSize = size;
-                  vpnOfMax = entry.virtPageNum_;
-                }
-              entry.valid_ = false;
-              entry.counter_ = 0;
-            }
-        }
+      for (auto& array : arrays_)
+        for (auto& entry : array.entries)
+          {
+            auto size = sizeIn4kBytes(mode_, entry.level_);
+            auto pageNum = alignPageNumBySize(mode_, entry.virtPageNum_, entry.level_);
+
+            if (entry.wid_ == wid and pageNum <= vpn and
+                vpn < pageNum + size)
+              {
+                if (size > maxSize)
+                  {
+                    maxSize = size;
+                    vpnOfMax = entry.virtPageNum_;
+                  }
+                entry.valid_ = false;
+                entry.counter_ = 0;
+              }
+          }
 
       // Invalidate subpages covered by super-page.  FIX make configurable.
       if (maxSize > 1)
         {
-          for (auto& entry : entries_)
-            {
-              if (entry.wid_ == wid and vpnOfMax <= vpn and vpn < vpnOfMax + maxSize)
-                {
-                  entry.valid_ = false;
-                  entry.counter_ = 0;
-                }
-            }
+          for (auto& array : arrays_)
+            for (auto& entry : array.entries)
+              {
+                if (entry.wid_ == wid and vpnOfMax <= vpn and vpn < vpnOfMax + maxSize)
+                  {
+                    entry.valid_ = false;
+                    entry.counter_ = 0;
+                  }
+              }
         }
     }
 
@@ -250,36 +286,38 @@ namespace WdRiscv
     {
       unsigned maxSize = 0;   // Size in 4k-bytes of largest entry covering vpn.
       uint64_t vpnOfMax = 0;
-      for (auto& entry : entries_)
-        {
-          auto size = sizeIn4kBytes(mode_, entry.level_);
-          auto pageNum = alignPageNumBySize(mode_, entry.virtPageNum_, entry.level_);
-
-          if (pageNum <= vpn and vpn < pageNum + size and
-              entry.asid_ == asid and entry.wid_ == wid and not entry.global_)
-            {
-              if (size > maxSize)
-                {
-                  maxSize = size;
-                  vpnOfMax = entry.virtPageNum_;
-                }
-              entry.valid_ = false;
-              entry.counter_ = 0;
-            }
-        }
+      for (auto& array : arrays_)
+        for (auto& entry : array.entries)
+          {
+            auto size = sizeIn4kBytes(mode_, entry.level_);
+            auto pageNum = alignPageNumBySize(mode_, entry.virtPageNum_, entry.level_);
+
+            if (pageNum <= vpn and vpn < pageNum + size and
+                entry.asid_ == asid and entry.wid_ == wid and not entry.global_)
+              {
+                if (size > maxSize)
+                  {
+                    maxSize = size;
+                    vpnOfMax = entry.virtPageNum_;
+                  }
+                entry.valid_ = false;
+                entry.counter_ = 0;
+              }
+          }
 
       // Invalidate subpages covered by super-page.  FIX make configurable.
       if (maxSize > 1)
         {
-          for (auto& entry : entries_)
-            {
-              if (vpnOfMax <= vpn and vpn < vpnOfMax + maxSize and
-                  entry.asid_ == asid and entry.wid_ == wid and not entry.global_)
-                {
-                  entry.valid_ = false;
-                  entry.counter_ = 0;
-                }
-            }
+          for (auto& array : arrays_)
+            for (auto& entry : array.entries)
+              {
+                if (vpnOfMax <= vpn and vpn < vpnOfMax + maxSize and
+                    entry.asid_ == asid and entry.wid_ == wid and not entry.global_)
+                  {
+                    entry.valid_ = false;
+                    entry.counter_ = 0;
+                  }
+              }
         }
     }
 
@@ -289,36 +327,38 @@ namespace WdRiscv
     {
       unsigned maxSize = 0;   // Size in 4k-bytes of largest entry covering vpn.
       uint64_t vpnOfMax = 0;
-      for (auto& entry : entries_)
-        {
-          auto size = sizeIn4kBytes(mode_, entry.level_);
-          auto pageNum = alignPageNumBySize(mode_, entry.virtPageNum_, entry.level_);
-
-          if (pageNum <= vpn and vpn < pageNum + size and
-              entry.vmid_ == vmid and entry.wid_ == wid)
-            {
-              if (size > maxSize)
-                {
-                  maxSize = size;
-                  vpnOfMax = entry.virtPageNum_;
-                }
-              entry.valid_ = false;
-              entry.counter_ = 0;
-            }
-        }
+      for (auto& array : arrays_)
+        for (auto& entry : array.entries)
+          {
+            auto size = sizeIn4kBytes(mode_, entry.level_);
+            auto pageNum = alignPageNumBySize(mode_, entry.virtPageNum_, entry.level_);
+
+            if (pageNum <= vpn and vpn < pageNum + size and
+                entry.vmid_ == vmid and entry.wid_ == wid)
+              {
+                if (size > maxSize)
+                  {
+                    maxSize = size;
+                    vpnOfMax = entry.virtPageNum_;
+                  }
+                entry.valid_ = false;
+                entry.counter_ = 0;
+              }
+          }
 
       // Invalidate subpages covered by super-page.  FIX make configurable.
       if (maxSize > 1)
         {
-          for (auto& entry : entries_)
-            {
-              if (vpnOfMax <= vpn and vpn < vpnOfMax + maxSize and
-                  entry.vmid_ == vmid and entry.wid_ == wid)
-                {
-                  entry.valid_ = false;
-                  entry.counter_ = 0;
-                }
-            }
+          for (auto& array : arrays_)
+            for (auto& entry : array.entries)
+              {
+                if (vpnOfMax <= vpn and vpn < vpnOfMax + maxSize and
+                    entry.vmid_ == vmid and entry.wid_ == wid)
+                  {
+                    entry.valid_ = false;
+                    entry.counter_ = 0;
+                  }
+              }
         }
     }
 
@@ -329,49 +369,52 @@ namespace WdRiscv
     {
       unsigned maxSize = 0;   // Size in 4k-bytes of largest entry covering vpn.
       uint64_t vpnOfMax = 0;
-      for (auto& entry : entries_)
-        {
-          auto size = sizeIn4kBytes(mode_, entry.level_);
-          auto pageNum = alignPageNumBySize(mode_, entry.virtPageNum_, entry.level_);
-
-          if (pageNum <= vpn and vpn < pageNum + size and
-              entry.vmid_ == vmid and entry.asid_ == asid and entry.wid_ == wid and
-              not entry.global_)
-            {
-              if (size > maxSize)
-                {
-                  maxSize = size;
-                  vpnOfMax = entry.virtPageNum_;
-                }
-              entry.valid_ = false;
-              entry.counter_ = 0;
-            }
-        }
+      for (auto& array : arrays_)
+        for (auto& entry : array.entries)
+          {
+            auto size = sizeIn4kBytes(mode_, entry.level_);
+            auto pageNum = alignPageNumBySize(mode_, entry.virtPageNum_, entry.level_);
+
+            if (pageNum <= vpn and vpn < pageNum + size and
+                entry.vmid_ == vmid and entry.asid_ == asid and entry.wid_ == wid and
+                not entry.global_)
+              {
+                if (size > maxSize)
+                  {
+                    maxSize = size;
+                    vpnOfMax = entry.virtPageNum_;
+                  }
+                entry.valid_ = false;
+                entry.counter_ = 0;
+              }
+          }
 
       // Invalidate subpages covered by super-page.  FIX make configurable.
       if (maxSize > 1)
         {
-          for (auto& entry : entries_)
-            {
-              if (vpnOfMax <= vpn and vpn < vpnOfMax + maxSize and
-                  entry.vmid_ == vmid and entry.asid_ == asid and entry.wid_ == wid and
-                  not entry.global_)
-                {
-                  entry.valid_ = false;
-                  entry.counter_ = 0;
-                }
-            }
+          for (auto& array : arrays_)
+            for (auto& entry : array.entries)
+              {
+                if (vpnOfMax <= vpn and vpn < vpnOfMax + maxSize and
+                    entry.vmid_ == vmid and entry.asid_ == asid and entry.wid_ == wid and
+                    not entry.global_)
+                  {
+                    entry.valid_ = false;
+                    entry.counter_ = 0;
+                  }
+              }
         }
     }
 
     /// Invalidate all entries.
     void invalidate()
     {
-      for (auto& entry : entries_)
-        {
-          entry.valid_ = false;
-          entry.counter_ = 0;
-        }
+      for (auto& array : arrays_)
+        for (auto& entry : array.entries)
+          {
+            entry.valid_ = false;
+            entry.counter_ = 0;
+          }
     }
 
     /// Set the address translation mode.
@@ -460,15 +503,104 @@ namespace WdRiscv
 
   private:
 
-    /// Return reference to TLB entry associated with given virtual page
-    /// number.
-    inline TlbEntry* getEntry(uint64_t pageNum)
+    /// Array of TLB entries organized in sets of consecutive entries.
+    struct Array
     {
-      unsigned ix = pageNum & (entries_.size() - 1);
-      return (!entries_.empty())? &entries_.at(ix) : nullptr;
+      std::vector<TlbEntry> entries;
+      unsigned ways = 1;       // Entries per set.
+      uint64_t setMask = 0;    // Number of sets minus 1.
+
+      /// Resize to the given number of entries (a power of 2) with the
+      /// given number of entries per set. Clear all entries.
+      void resize(unsigned size, unsigned w)
+      {
+        entries.assign(size, TlbEntry{});
+        ways = std::max(std::min(w, size), 1u);
+        setMask = size ? size / ways - 1 : 0;
+      }
+
+      /// Return the index of the first entry of the set of the given
+      /// page number.
+      size_t setIndex(uint64_t pageNum) const
+      { return (pageNum & setMask) * ways; }
+    };
+
+    /// Return the largest leaf level (as in TlbEntry::level_) of the given mode.
+    static constexpr unsigned maxLevel(Mode m)
+    {
+      switch (m)
+        {
+        case Mode::Sv32: return 2;
+        case Mode::Sv39: return 3;
+        case Mode::Sv48: return 4;
+        case Mode::Sv57: return 5;
+        default:         return 1;
+        }
+    }
+
+    /// Return the valid entry of the given array tagged with the given
+    /// page number for which match returns true. Return nullptr if none.
+    template <typename MATCH>
+    static TlbEntry* findInArray(Array& array, uint64_t pageNum, MATCH match)
+    {
+      if (array.entries.empty())
+        return nullptr;
+      size_t base = array.setIndex(pageNum);
+      for (unsigned i = 0; i < array.ways; ++i)
+        {
+          auto& entry = array.entries[base + i];
+          if (entry.valid_ and entry.virtPageNum_ == pageNum and match(entry))
+            return &entry;
+        }
+      return nullptr;
     }
 
-    std::vector<TlbEntry> entries_;
+    /// Return the entry covering the given virtual page number for which
+    /// match returns true. Return nullptr if none. Superpage arrays are
+    /// tagged with the page number of the first page of the superpage.
+    template <typename MATCH>
+    TlbEntry* find(uint64_t pageNum, MATCH match)
+    {
+      if (auto* entry = findInArray(arrays_[0], pageNum, match))
+        return entry;
+      if (superpages_)
+        for (unsigned level = 2; level <= maxLevel(mode_); ++level)
+          {
+            uint64_t base = alignPageNumBySize(mode_, pageNum, level);
+            if (auto* entry = findInArray(arrays_.at(level - 1), base, match))
+              return entry;
+          }
+      return nullptr;
+    }
+
+    /// Update the hit/miss counts and the replacement counter of the
+    /// given entry (nullptr on a miss).
+    void countAccess(TlbEntry* entry)
+    {
+      if (not entry)
+        {
+          ++misses_;
+          return;
+        }
+      ++hits_;
+      ++entry->counter_;
+      entry->counter_ &= 3;
+    }
+
+    /// Return the slot of the given array in which to insert an entry
+    /// for the given page number: an invalid entry of its set or else
+    /// the least accessed entry not recently accessed (bit 1 of counter
+    /// clear). Return nullptr, aging the entries of the set, if all of
+    /// them were recently accessed.
+    static TlbEntry* selectVictim(Array& array, uint64_t pageNum);
+
+    std::array<Array, 5> arrays_;  // Main array followed by superpage arrays (by level).
+    unsigned ways_ = 1;            // Entries per set.
+    bool superpages_ = false;      // True if superpage arrays are used.
+
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t evictions_ = 0;
 
     Mode mode_ = Mode::Bare;
   };
@@ -194,7 +194,7 @@ VirtMem::transNoUpdate(uint64_t va, PrivilegeMode priv, bool twoStage,
 	      return stage1PageFaultType(read, write, exec);
             }
 	  // We do not check/update access/dirty bits.
-	  pa = (entry->physPageNum_ << pageBits_) | (va & pageMask_);
+	  pa = (entry->physPageNum(virPageNum) << pageBits_) | (va & pageMask_);
           pbmt_ = Pbmt(entry->pbmt_);
 	  return ExceptionCause::NONE;
 	}
@@ -312,7 +312,7 @@ VirtMem::translate(uint64_t va, PrivilegeMode priv, bool twoStage,
 	entry->valid_ = false;
       if (entry->valid_)
 	{
-	  pa = (entry->physPageNum_ << pageBits_) | (va & pageMask_);
+	  pa = (entry->physPageNum(virPageNum) << pageBits_) | (va & pageMask_);
 	  pbmt_ = Pbmt(entry->pbmt_);
 	  return ExceptionCause::NONE;
 	}
@@ -487,7 +487,7 @@ VirtMem::stage2Translate(uint64_t va, PrivilegeMode priv, bool read, bool write,
 	entry->valid_ = false;
       if (entry->valid_)
 	{
-	  pa = (entry->physPageNum_ << pageBits_) | (va & pageMask_);
+	  pa = (entry->physPageNum(virPageNum) << pageBits_) | (va & pageMask_);
 	  pbmt_ = Pbmt(entry->pbmt_);
 	  if (leafEntry)
 	    *leafEntry = *entry;
@@ -579,7 +579,7 @@ VirtMem::stage1Translate(uint64_t va, PrivilegeMode priv, bool read, bool write,
         {
           // Use TLB entry.
           vsPbmt_ = Pbmt(entry->pbmt_);
-          gpa = (entry->physPageNum_ << pageBits_) | (va & pageMask_);
+          gpa = (entry->physPageNum(virPageNum) << pageBits_) | (va & pageMask_);
           if (leafEntry)
             *leafEntry = *entry;
         }
@@ -714,6 +714,15 @@ VirtMem::pageTableWalk(uint64_t address, PrivilegeMode privMode, bool read, bool
   bool aUpdated = false, dUpdated = false;  // For tracing: A/D written by traversal.
   pbmt_ = Pbmt::None;
 
+  // Resume the walk at the deepest page table cached for this address.
+  const uint64_t walkRoot = root;
+  const unsigned vpnBits = pteSize == 4 ? 10 : 9;
+  PwcPath path;
+  if (pwcLookup(PwcStage::Single, pte.mode(), walkRoot, address, asid_, 0, bigEndStage1_,
+                vpnBits, levels, ii, root, global, path))
+    if (trace_)
+      pwcTrace(walkVec.back(), path);
+
   while (true)
     {
       // 2.
@@ -728,7 +737,8 @@ VirtMem::pageTableWalk(uint64_t address, PrivilegeMode privMode, bool read, bool
       // Read the PTE through the coherent PTE cache (skips the memory read and
       // the PMP/PMA access check on a hit). isAddrReadable+memRead would both
       // fault as accessFault, so the combined check is trace-equivalent.
-      if (not readPteCached(pteAddr, pte.data_))
+      uint64_t gen = pageGeneration(pteAddr);
+      if (not readPteCached(pteAddr, bigEndStage1_, pte.data_))
 	return traceException(accessFaultType(read, write, exec), exec, walkIx);
 
       if (trace_)
@@ -752,6 +762,8 @@ VirtMem::pageTableWalk(uint64_t address, PrivilegeMode privMode, bool read, bool
           if (ii < 0)
             return traceException(stage1PageFaultType(read, write, exec), exec, walkIx);
           root = pte.ppn() * pageSize_;
+          pwcInsert(PwcStage::Single, pte.mode(), walkRoot, address, asid_, 0, bigEndStage1_,
+                    vpnBits, ii, root, global, path, pteAddr, pte.data_, gen);
           continue;  // goto 2.
         }
 
@@ -827,7 +839,7 @@ VirtMem::pageTableWalk(uint64_t address, PrivilegeMode privMode, bool read, bool
 	    // walk committed to and make the comparison below fail forever (the
 	    // "continue" loops back to step 2 re-reading the same cached value).
 	    PTE pte2(0);
-	    if (! readPteCached(pteAddr, pte2.data_))
+	    if (! readPteCached(pteAddr, bigEndStage1_, pte2.data_))
               assert(0 && "Error: Assertion failed");
 
             // Preserve the original pte.ppn (no NAPOT fixup).
@@ -917,6 +929,15 @@ VirtMem::stage2PageTableWalk(uint64_t address, bool read, bool write, bool exec,
   bool aUpdated = false, dUpdated = false;  // For tracing: A/D written by traversal.
   pbmt_ = Pbmt::None;
 
+  // Resume the walk at the deepest page table cached for this address.
+  const uint64_t walkRoot = root;
+  const unsigned vpnBits = pteSize == 4 ? 10 : 9;
+  PwcPath path;
+  if (pwcLookup(PwcStage::G, pte.mode(), walkRoot, address, 0, vmid_, bigEndStage2_,
+                vpnBits, levels, ii, root, global, path))
+    if (trace_)
+      pwcTrace(walkVec.back(), path);
+
   while (true)
     {
       // 2.
@@ -928,13 +949,12 @@ VirtMem::stage2PageTableWalk(uint64_t address, bool read, bool write, bool exec,
           walkVec.back().ptes_.push_back(0);         // PTE value place holder.
         }
 
-      // Check PMP. The privMode here is the effective one that already accounts for MPRV.
-      if (not isAddrReadable(pteAddr))
+      // Check PMP and read the PTE through the coherent PTE cache (see
+      // pageTableWalk).
+      uint64_t gen = pageGeneration(pteAddr);
+      if (not readPteCached(pteAddr, bigEndStage2_, pte.data_))
 	return traceException(accessFaultType(read, write, exec), forFetch_, walkIx);
 
-      if (not memRead(pteAddr, bigEndStage2_, pte.data_))
-        return traceException(accessFaultType(read, write, exec), forFetch_, walkIx);
-
       if (trace_)
         walkVec.back().ptes_.back() = pte.data_;  // Save PTE value.
       if (not napotCheck(pte, va))
@@ -954,6 +974,8 @@ VirtMem::stage2PageTableWalk(uint64_t address, bool read, bool write, bool exec,
           if (ii < 0)
             return traceException(stage2PageFaultType(read, write, exec), forFetch_, walkIx);
           root = pte.ppn() * pageSize_;
+          pwcInsert(PwcStage::G, pte.mode(), walkRoot, address, 0, vmid_, bigEndStage2_,
+                    vpnBits, ii, root, global, path, pteAddr, pte.data_, gen);
           continue;  // goto 2.
         }
 
@@ -1010,9 +1032,9 @@ VirtMem::stage2PageTableWalk(uint64_t address, bool read, bool write, bool exec,
 	    return traceException(accessFaultType(read, write, exec), forFetch_, walkIx);
 
 	  {
-	    // B2. Compare pte to memory.
+	    // B2. Compare pte to the same coherent view used for the walk's PTE read.
 	    PTE pte2(0);
-	    if (!memRead(pteAddr, bigEndStage2_, pte2.data_))
+	    if (! readPteCached(pteAddr, bigEndStage2_, pte2.data_))
               assert(0 && "Error: Assertion failed");
 
             // Preserve the original pte.ppn (no NAPOT fixup).
@@ -1036,6 +1058,7 @@ VirtMem::stage2PageTableWalk(uint64_t address, bool read, bool write, bool exec,
                 std::cerr << "PTE write failed even though PMP/PMA checks passed\n";
                 assert(0);
               }
+            invalidatePteCache(pteAddr, sizeof(orig.data_));  // A/D update changed this PTE.
 
             // We do this for backward compatibility. This should not be done.
             if (trace_)
@@ -1127,13 +1150,11 @@ VirtMem::stage1PageTableWalk(uint64_t address, PrivilegeMode privMode, bool read
       if (trace_)
         walkVec.at(walkIx).s1Spas_.back() = pteAddr;  // Save PTE SPA.
 
-      // Check PMP. The privMode here is the effective one that already accounts for MPRV.
-      if (not isAddrReadable(pteAddr))
+      // Check PMP and read the PTE through the coherent PTE cache (see
+      // pageTableWalk).
+      if (not readPteCached(pteAddr, bigEndStage1_, pte.data_))
 	return traceException(accessFaultType(read, write, exec), forFetch_, walkIx);
 
-      if (not memRead(pteAddr, bigEndStage1_, pte.data_))
-        return traceException(accessFaultType(read, write, exec), forFetch_, walkIx);
-
       if (trace_)
         {
           walkVec.at(walkIx).s1Tail_ = true;    // Stage 1 tail PTE valid.
@@ -1230,9 +1251,9 @@ VirtMem::stage1PageTableWalk(uint64_t address, PrivilegeMode privMode, bool read
 	    return traceException(accessFaultType(read, write, exec), forFetch_, walkIx);
 
 	  {
-	    // B2. Compare pte to memory.
+	    // B2. Compare pte to the same coherent view used for the walk's PTE read.
 	    PTE pte2(0);
-	    if (!memRead(pteAddr, bigEndStage1_, pte2.data_))
+	    if (! readPteCached(pteAddr, bigEndStage1_, pte2.data_))
               assert(0 && "Error: Assertion failed");
 
             // Preserve the original pte.ppn (no NAPOT fixup).
@@ -1265,6 +1286,7 @@ VirtMem::stage1PageTableWalk(uint64_t address, PrivilegeMode privMode, bool read
                 std::cerr << "PTE write failed even though PMP/PMA checks passed\n";
                 assert(0);
               }
+            invalidatePteCache(pteAddr2, sizeof(orig.data_));  // A/D update changed this PTE.
 
             // We do this for backward compatibility. This should not be done.
             if (trace_)
@@ -1320,6 +1342,7 @@ VirtMem::setPageSize(uint64_t size)
   
   pageBits_ = bits;
   pageSize_ = size;
+  flushPteCache();
   return true;
 }
 
@@ -1362,6 +1385,12 @@ VirtMem::printPageTable(std::ostream& os) const
     os << "Unsupported virtual memory mode\n";
   os << "TLB:\n";
   tlb_.printTlb(os);
+  uint64_t hits = 0, misses = 0, evictions = 0;
+  tlbStats(hits, misses, evictions);
+  os << "TLB: " << std::dec << hits << " hits, " << misses << " misses, "
+     << evictions << " evictions\n";
+  pageWalkCacheStats(hits, misses);
+  os << "Page walk cache: " << std::dec << hits << " hits, " << misses << " misses\n";
   os.flags(flags);
 }
 
@@ -17,6 +17,8 @@
 #include <iosfwd>
 #include <functional>
 #include <array>
+#include <atomic>
+#include <span>
 #include "trapEnums.hpp"
 #include "Tlb.hpp"
 #include "Pte.hpp"
@@ -158,6 +160,45 @@ namespace WdRiscv
       stage2Tlb_.setTlbSize(size);
     }
 
+    /// Set the number of entries per set of the TLBs.
+    void setTlbWays(unsigned ways)
+    {
+      tlb_.setTlbWays(ways);
+      vsTlb_.setTlbWays(ways);
+      stage2Tlb_.setTlbWays(ways);
+    }
+
+    /// Set the number of entries of each superpage array of the
+    /// TLBs. Zero keeps superpages in the main array.
+    void setSuperpageTlbSize(unsigned size)
+    {
+      tlb_.setSuperpageTlbSize(size);
+      vsTlb_.setSuperpageTlbSize(size);
+      stage2Tlb_.setSuperpageTlbSize(size);
+    }
+
+    /// Return the number of hits, misses and evictions of the TLBs
+    /// (single-stage, VS-stage, and G-stage combined). Hits include
+    /// those served by the micro-TLBs of the hart (see countTlbHits).
+    void tlbStats(uint64_t& hits, uint64_t& misses, uint64_t& evictions) const
+    {
+      hits = microTlbHits_;
+      misses = evictions = 0;
+      for (const auto* tlb : { &tlb_, &vsTlb_, &stage2Tlb_ })
+        {
+          uint64_t h = 0, m = 0, e = 0;
+          tlb->getStats(h, m, e);
+          hits += h;
+          misses += m;
+          evictions += e;
+        }
+    }
+
+    /// Account for count TLB hits served by a micro-TLB of the hart
+    /// without a lookup in the TLBs.
+    void countTlbHits(uint64_t count)
+    { microTlbHits_ += count; }
+
     /// Return page size.
     unsigned pageSize() const
     { return pageSize_; }
@@ -689,11 +730,11 @@ namespace WdRiscv
 
     /// Enable/disable NAPOT page size (naturally aligned power of 2).
     void enableNapot(bool flag)
-    { napotEnabled_ = flag; }
+    { napotEnabled_ = flag; flushPteCache(); }
 
     /// Enable/disable Svrsw60t59b.
     void enableRsw60t59b(bool flag)
-    { rsw60t59bEnabled_ = flag; }
+    { rsw60t59bEnabled_ = flag; flushPteCache(); }
 
   protected:
 
@@ -770,37 +811,174 @@ namespace WdRiscv
     // A coherent cache of (physical PTE address) -> (value, access-ok). The page
     // table walk reads each PTE through this cache; a hit skips the memory read
     // and the PMP/PMA access checks. The walk logic is otherwise unchanged, and
-    // the cache is kept coherent (invalidated on any write to a cached address;
-    // flushed on sfence/satp/PMP changes), so the emitted iptw trace is
-    // byte-identical to an uncached walk.
-    struct PteCacheEntry { uint64_t addr = ~uint64_t(0); uint64_t value = 0; bool ok = false; };
+    // the cache is kept coherent (an entry is valid only while the write
+    // generation of its page is unchanged, see setPageGenerations; flushed on
+    // sfence/satp/PMP changes), so the emitted iptw trace is byte-identical to an
+    // uncached walk. Page generations are shared by all harts, so a PTE written by
+    // any hart is observed.
+    struct PteCacheEntry { uint64_t addr = ~uint64_t(0); uint64_t value = 0; uint64_t gen = 0; bool bigEnd = false; bool ok = false; };
     static constexpr unsigned pteCacheSize_ = 8192;
     static constexpr unsigned pteCacheMask_ = pteCacheSize_ - 1;
 
     template<typename T>
-    bool readPteCached(uint64_t pteAddr, T& data)
+    bool readPteCached(uint64_t pteAddr, bool bigEnd, T& data)
     {
-      if (not pteCacheActive_)   // Multi-hart: fall back to an uncached read.
-        return isAddrReadable(pteAddr) and memRead(pteAddr, bigEndStage1_, data);
+      if (not pteCacheActive_)
+        return isAddrReadable(pteAddr) and memRead(pteAddr, bigEnd, data);
       // The key is the PTE's physical address as seen by the walk. This is
-      // coherent with the write side (Memory::write observer + the A/D-update
+      // coherent with the write side (page write generations + the A/D-update
       // invalidate) as long as a store to a PTE reports the same address -- true
       // unless page tables reside in STEE address-transformed memory (validated:
       // byte-identical with STEE enabled across gcc 20M + 10 simpoints).
       unsigned idx = unsigned(pteAddr >> 3) & pteCacheMask_;
       PteCacheEntry& e = pteCache_.at(idx);
-      if (e.addr == pteAddr)
+      uint64_t gen = pageGeneration(pteAddr);
+      if (e.addr == pteAddr and e.gen == gen and e.bigEnd == bigEnd)
         {
           data = static_cast<T>(e.value);
           return e.ok;
         }
-      bool ok = isAddrReadable(pteAddr) and memRead(pteAddr, bigEndStage1_, data);
+      bool ok = isAddrReadable(pteAddr) and memRead(pteAddr, bigEnd, data);
       e.addr = pteAddr;
       e.value = data;
+      e.gen = gen;
+      e.bigEnd = bigEnd;
       e.ok = ok;
       return ok;
     }
 
+    /// Return the write generation of the page containing the given
+    /// physical address or 0 if no generation table was defined.
+    uint64_t pageGeneration(uint64_t addr) const
+    {
+      if (pageGens_.empty())
+        return 0;
+      return pageGens_[(addr >> pageGenShift_) & (pageGens_.size() - 1)].load(std::memory_order_acquire);
+    }
+
+    // --- Page-walk cache (trace-preserving) ------------------------------------
+    // Maps the upper bits of a translated address to the page table reached after
+    // traversing the non-leaf PTEs of a walk so that a later walk of a nearby
+    // address resumes at that table. An entry records the addresses and values of
+    // the PTEs it skips: they are replayed into the walk trace on a hit, and the
+    // entry is used only while the write generations of their pages are unchanged
+    // (like the PTE cache, it is also flushed on sfence/hfence/satp/PMP changes).
+    // VS-stage walks (stage1PageTableWalk) do not use this cache: each of their PTE
+    // addresses goes through a G-stage translation whose TLB updates and walk trace
+    // would have to be replayed as well.
+    enum class PwcStage : uint8_t { Single, G };
+
+    static constexpr unsigned pwcMaxSkip_ = 4;   // Non-leaf levels of Sv57.
+    static constexpr unsigned pwcSize_ = 256;
+    static constexpr unsigned pwcMask_ = pwcSize_ - 1;
+
+    /// Non-leaf PTEs traversed by a walk.
+    struct PwcPath
+    {
+      std::array<uint64_t, pwcMaxSkip_> addrs{};  // Physical addresses of PTEs.
+      std::array<uint64_t, pwcMaxSkip_> ptes{};   // Values of PTEs.
+      std::array<uint64_t, pwcMaxSkip_> gens{};   // Page generations before PTE reads.
+      unsigned count = 0;
+    };
+
+    struct PwcEntry
+    {
+      PwcPath path;
+      uint64_t tag = ~uint64_t(0);  // Address bits selecting the table (above its VPN).
+      uint64_t root = 0;            // Address of the root page table of the walk.
+      uint64_t table = 0;           // Address of the page table reached.
+      uint32_t asid = 0;
+      uint32_t vmid = 0;
+      uint32_t wid = 0;
+      int level = -1;               // Level of the page table reached.
+      PwcStage stage = PwcStage::Single;
+      Mode mode = Mode::Bare;
+      bool bigEnd = false;
+      bool global = false;
+    };
+
+    /// Return true if the page-walk cache can be used: it is validated by page
+    /// write generations.
+    bool pwcActive() const
+    { return pteCacheActive_ and not pageGens_.empty(); }
+
+    /// Return the page-walk cache slot of the given tag and level.
+    static unsigned pwcIndex(uint64_t tag, int level)
+    { return unsigned(tag ^ (tag >> 8) ^ (uint64_t(level) << 6)) & pwcMask_; }
+
+    /// Look for the deepest page table cached for the given walk of the given
+    /// address. On a hit, set level, table, and global to resume the walk at
+    /// that table, set path to the skipped PTEs, and return true.
+    bool pwcLookup(PwcStage stage, Mode mode, uint64_t root, uint64_t address,
+                   uint32_t asid, uint32_t vmid, bool bigEnd, unsigned vpnBits,
+                   int levels, int& level, uint64_t& table, bool& global, PwcPath& path)
+    {
+      if (not pwcActive())
+        return false;
+      for (int lev = 0; lev < levels - 1; ++lev)
+        {
+          uint64_t tag = address >> (pageBits_ + (lev + 1)*vpnBits);
+          const PwcEntry& e = pwc_.at(pwcIndex(tag, lev));
+          if (e.tag != tag or e.level != lev or e.stage != stage or e.root != root or
+              e.mode != mode or e.asid != asid or e.vmid != vmid or e.wid != wid_ or
+              e.bigEnd != bigEnd)
+            continue;
+          bool valid = true;
+          for (unsigned i = 0; i < e.path.count and valid; ++i)
+            valid = pageGeneration(e.path.addrs.at(i)) == e.path.gens.at(i);
+          if (not valid)
+            continue;
+          level = lev;
+          table = e.table;
+          global = e.global;
+          path = e.path;
+          ++pwcHits_;
+          return true;
+        }
+      ++pwcMisses_;
+      return false;
+    }
+
+    /// Append the given non-leaf PTE to the path of a walk and remember the
+    /// page table it points to (at the given level) in the page-walk cache.
+    void pwcInsert(PwcStage stage, Mode mode, uint64_t root, uint64_t address,
+                   uint32_t asid, uint32_t vmid, bool bigEnd, unsigned vpnBits,
+                   int level, uint64_t table, bool global, PwcPath& path,
+                   uint64_t pteAddr, uint64_t pte, uint64_t gen)
+    {
+      if (not pwcActive() or path.count >= pwcMaxSkip_)
+        return;
+      path.addrs.at(path.count) = pteAddr;
+      path.ptes.at(path.count) = pte;
+      path.gens.at(path.count) = gen;
+      path.count++;
+
+      uint64_t tag = address >> (pageBits_ + (level + 1)*vpnBits);
+      PwcEntry& e = pwc_.at(pwcIndex(tag, level));
+      e.path = path;
+      e.tag = tag;
+      e.root = root;
+      e.table = table;
+      e.asid = asid;
+      e.vmid = vmid;
+      e.wid = wid_;
+      e.level = level;
+      e.stage = stage;
+      e.mode = mode;
+      e.bigEnd = bigEnd;
+      e.global = global;
+    }
+
+    /// Record the PTEs skipped by a page-walk cache hit in the given walk trace.
+    static void pwcTrace(Walk& walk, const PwcPath& path)
+    {
+      for (unsigned i = 0; i < path.count; ++i)
+        {
+          walk.addrs_.push_back(path.addrs.at(i));
+          walk.ptes_.push_back(path.ptes.at(i));
+        }
+    }
+
   public:
     /// Invalidate any cached PTE overlapped by [addr, addr+size).
     void invalidatePteCache(uint64_t addr, unsigned size)
@@ -814,23 +992,41 @@ namespace WdRiscv
         }
     }
 
-    /// Drop all cached PTEs (sfence/satp/PMP/PMA changes).
+    /// Drop all cached PTEs and page-walk cache entries (sfence/hfence/satp/PMP/PMA
+    /// changes).
     void flushPteCache()
     {
       for (auto& e : pteCache_)
         e.addr = ~uint64_t(0);
+      for (auto& e : pwc_)
+        e.tag = ~uint64_t(0);
     }
 
-    /// Enable/disable the PTE cache (and flush it). Disabled for multi-hart
-    /// configurations: the write observer that invalidates the cache is bound to
-    /// a single hart, so a PTE write by another hart would not be observed. When
-    /// disabled the walk falls back to uncached reads.
+    /// Return the number of page-walk cache hits and misses.
+    void pageWalkCacheStats(uint64_t& hits, uint64_t& misses) const
+    { hits = pwcHits_; misses = pwcMisses_; }
+
+    /// Enable/disable the PTE cache (and flush it). When disabled the walk
+    /// falls back to uncached reads.
     void setPteCacheActive(bool active)
     {
       pteCacheActive_ = active;
       flushPteCache();
     }
 
+    /// Define the table of per-page write generations used to validate cached
+    /// PTEs: the generation of the page at physical address a is at index
+    /// ((a >> pageShift) & (gens.size() - 1)); gens.size() must be a power of
+    /// 2. The generation of a page must change on every write to the page by
+    /// any hart (see Memory::pageGenerations). Without a table, cached PTEs
+    /// are invalidated only by this object (A/D updates, flushes).
+    void setPageGenerations(std::span<const std::atomic<uint64_t>> gens, unsigned pageShift)
+    {
+      pageGens_ = gens;
+      pageGenShift_ = pageShift;
+      flushPteCache();
+    }
+
     /// Process table walk trace as for fetch.
     void setAccReason(bool fetch)
     { forFetch_ = fetch; }
@@ -1173,7 +1369,13 @@ namespace WdRiscv
     mutable std::vector<Walk> dataWalks_;    // Data access walks of last instruction.
 
     std::array<PteCacheEntry, pteCacheSize_> pteCache_{};  // Coherent PTE cache.
-    bool pteCacheActive_ = true;   // Off for multi-hart (see setPteCacheActive).
+    bool pteCacheActive_ = true;   // See setPteCacheActive.
+    std::span<const std::atomic<uint64_t>> pageGens_;  // See setPageGenerations.
+    unsigned pageGenShift_ = 12;
+    std::array<PwcEntry, pwcSize_> pwc_{};  // Page-walk cache.
+    uint64_t pwcHits_ = 0;
+    uint64_t pwcMisses_ = 0;
+    uint64_t microTlbHits_ = 0;  // TLB hits served by hart micro-TLBs.
     mutable std::vector<Walk> walkPool_;     // Recycled Walk storage (retains inner capacity).
     const Walk emptyWalk_;
 